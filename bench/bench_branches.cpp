@@ -0,0 +1,151 @@
+// Branch-miss and timing benchmark for the scalar noise kernels on random access query patterns.
+//
+// Samples are taken at scattered positions so lattice choices differ from one query to the next, which is where data
+// dependent branches in the kernels are mispredicted. Branch counts come from perf_event hardware counters on Linux,
+// they print as n/a where counters are unavailable (other systems, virtual machines, perf_event_paranoid).
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <entropy/entropy.hpp>
+
+using entropy::NoiseGen;
+
+// Counts one hardware event for the calling thread, Valid() is false when the counter could not be opened
+class PerfCounter {
+  public:
+    explicit PerfCounter(uint64_t config) {
+#if defined(__linux__)
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        mFd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+        (void)config;
+#endif
+    }
+
+    ~PerfCounter() {
+#if defined(__linux__)
+        if (mFd >= 0)
+            close(mFd);
+#endif
+    }
+
+    PerfCounter(const PerfCounter &) = delete;
+    PerfCounter &operator=(const PerfCounter &) = delete;
+
+    bool Valid() const { return mFd >= 0; }
+
+    void Start() {
+#if defined(__linux__)
+        if (mFd >= 0) {
+            ioctl(mFd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(mFd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    uint64_t Stop() {
+        uint64_t count = 0;
+#if defined(__linux__)
+        if (mFd >= 0) {
+            ioctl(mFd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(mFd, &count, sizeof(count)) != (ssize_t)sizeof(count))
+                count = 0;
+        }
+#endif
+        return count;
+    }
+
+  private:
+    int mFd = -1;
+};
+
+int main() {
+    const int samples = 1 << 20;
+
+    const struct {
+        NoiseGen::NoiseType type;
+        const char *name;
+    } kernels[] = {{NoiseGen::NoiseType_OpenSimplex2, "OpenSimplex2"},
+                   {NoiseGen::NoiseType_OpenSimplex2S, "OpenSimplex2S"},
+                   {NoiseGen::NoiseType_Cellular, "Cellular"}};
+
+    // Scattered positions from a fixed xorshift sequence
+    std::vector<float> xs(samples), ys(samples), zs(samples);
+    uint32_t state = 2463534242u;
+    for (int i = 0; i < samples; i++) {
+        float *axes[3] = {&xs[i], &ys[i], &zs[i]};
+        for (float *axis : axes) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            *axis = (float)(state >> 8) * (1000.0f / 16777216.0f);
+        }
+    }
+
+    PerfCounter misses(PERF_COUNT_HW_BRANCH_MISSES);
+    PerfCounter branches(PERF_COUNT_HW_BRANCH_INSTRUCTIONS);
+
+    std::printf("%-14s %-3s %12s %16s %16s\n", "kernel", "dim", "ns/sample", "branches/sample", "misses/sample");
+
+    for (auto &kernel : kernels) {
+        for (int dimensions = 2; dimensions <= 3; dimensions++) {
+            NoiseGen gen(1337);
+            gen.SetNoiseType(kernel.type);
+            gen.SetFrequency(1.0f);
+
+            volatile float sink = 0;
+            double ns = 1e30;
+            uint64_t branchCount = 0, missCount = 0;
+
+            // Fastest of a few runs, counters are read on the last one
+            for (int repeat = 0; repeat < 5; repeat++) {
+                misses.Start();
+                branches.Start();
+                auto start = std::chrono::steady_clock::now();
+
+                float sum = 0;
+                if (dimensions == 2) {
+                    for (int i = 0; i < samples; i++)
+                        sum += gen.GetNoise(xs[i], ys[i]);
+                } else {
+                    for (int i = 0; i < samples; i++)
+                        sum += gen.GetNoise(xs[i], ys[i], zs[i]);
+                }
+
+                auto end = std::chrono::steady_clock::now();
+                branchCount = branches.Stop();
+                missCount = misses.Stop();
+                sink = sink + sum;
+
+                double elapsed = std::chrono::duration<double, std::nano>(end - start).count() / samples;
+                ns = elapsed < ns ? elapsed : ns;
+            }
+
+            std::printf("%-14s %-3d %12.1f", kernel.name, dimensions, ns);
+            if (branches.Valid() && misses.Valid())
+                std::printf(" %16.2f %16.3f\n", (double)branchCount / samples, (double)missCount / samples);
+            else
+                std::printf(" %16s %16s\n", "n/a", "n/a");
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+// Timing benchmark for lattice reuse along grid rows.
+//
+// GetNoiseGrid2D/3D keep the lattice values of the cells around the current sample while walking a row, so at low
+// frequency most samples skip hashing entirely. Reports the time per sample of the grid call against GetNoise(...)
+// at the same positions, for a few frequencies.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include <entropy/entropy.hpp>
+
+using entropy::NoiseGen;
+
+int main() {
+    const int size = 256;
+    const int depth = 8;
+
+    const struct {
+        NoiseGen::NoiseType type;
+        const char *name;
+    } kernels[] = {{NoiseGen::NoiseType_Perlin, "Perlin"},
+                   {NoiseGen::NoiseType_Value, "Value"},
+                   {NoiseGen::NoiseType_ValueCubic, "ValueCubic"}};
+
+    const float frequencies[] = {0.5f, 0.05f, 0.005f};
+
+    std::printf("%-11s %-3s %-9s %12s %12s\n", "kernel", "dim", "frequency", "grid ns", "GetNoise ns");
+
+    for (auto &kernel : kernels) {
+        for (int dimensions = 2; dimensions <= 3; dimensions++) {
+            for (float frequency : frequencies) {
+                NoiseGen gen(1337);
+                gen.SetNoiseType(kernel.type);
+                gen.SetFrequency(frequency);
+
+                size_t samples = (size_t)size * size * (dimensions == 2 ? 1 : depth);
+                std::vector<float> out(samples);
+                volatile float sink = 0;
+                double gridNs = 1e30, singleNs = 1e30;
+
+                // Fastest of a few runs, to keep other load on the machine out of the comparison
+                for (int repeat = 0; repeat < 5; repeat++) {
+                    auto start = std::chrono::steady_clock::now();
+                    if (dimensions == 2)
+                        gen.GetNoiseGrid2D(out.data(), 0, 0, size, size);
+                    else
+                        gen.GetNoiseGrid3D(out.data(), 0, 0, 0, size, size, depth);
+                    auto mid = std::chrono::steady_clock::now();
+
+                    float sum = 0;
+                    for (int z = 0; z < (dimensions == 2 ? 1 : depth); z++)
+                        for (int y = 0; y < size; y++)
+                            for (int x = 0; x < size; x++)
+                                sum += dimensions == 2 ? gen.GetNoise((float)x, (float)y)
+                                                       : gen.GetNoise((float)x, (float)y, (float)z);
+                    auto end = std::chrono::steady_clock::now();
+                    sink = sink + sum + out[samples / 2];
+
+                    double grid = std::chrono::duration<double, std::nano>(mid - start).count();
+                    double single = std::chrono::duration<double, std::nano>(end - mid).count();
+                    gridNs = std::fmin(gridNs, grid / samples);
+                    singleNs = std::fmin(singleNs, single / samples);
+                }
+
+                std::printf("%-11s %-3d %-9g %12.1f %12.1f\n", kernel.name, dimensions, frequency, gridNs, singleNs);
+            }
+        }
+    }
+
+    return 0;
+}
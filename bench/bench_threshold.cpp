@@ -0,0 +1,68 @@
+// Octave and timing benchmark for threshold queries with early octave termination.
+//
+// IsAbove(x, y[, z], t) stops once the partial fractal sum is further from t than the remaining octave amplitudes can
+// move it. Reports the average octaves evaluated per query against the full octave count, and the time per query
+// against GetNoise(...) > t.
+
+#include <chrono>
+#include <cstdio>
+
+static long gOctaves = 0;
+#define ENTROPY_THRESHOLD_OCTAVE() (++gOctaves)
+
+#include <entropy/entropy.hpp>
+
+using entropy::NoiseGen;
+
+int main() {
+    const int size = 256;
+    const long samples = (long)size * size;
+    const int octaves = 8;
+
+    const struct {
+        NoiseGen::FractalType type;
+        const char *name;
+    } fractals[] = {{NoiseGen::FractalType_FBm, "FBm"},
+                    {NoiseGen::FractalType_Ridged, "Ridged"},
+                    {NoiseGen::FractalType_PingPong, "PingPong"}};
+
+    const float thresholds[] = {-0.5f, 0.0f, 0.3f};
+
+    std::printf("%-9s %-3s %-9s %14s %14s %12s %14s\n", "fractal", "dim", "threshold", "octaves/query",
+                "octaves saved", "ns/query", "GetNoise ns");
+
+    for (auto &fractal : fractals) {
+        for (int dimensions = 2; dimensions <= 3; dimensions++) {
+            for (float threshold : thresholds) {
+                NoiseGen gen(1337);
+                gen.SetFrequency(0.01f);
+                gen.SetFractalType(fractal.type);
+                gen.SetFractalOctaves(octaves);
+
+                volatile int sink = 0;
+                gOctaves = 0;
+
+                auto start = std::chrono::steady_clock::now();
+                for (int y = 0; y < size; y++)
+                    for (int x = 0; x < size; x++)
+                        sink = sink + (dimensions == 2 ? gen.IsAbove((float)x, (float)y, threshold)
+                                                       : gen.IsAbove((float)x, (float)y, 17.0f, threshold));
+                auto mid = std::chrono::steady_clock::now();
+
+                for (int y = 0; y < size; y++)
+                    for (int x = 0; x < size; x++)
+                        sink = sink + (dimensions == 2 ? gen.GetNoise((float)x, (float)y) > threshold
+                                                       : gen.GetNoise((float)x, (float)y, 17.0f) > threshold);
+                auto end = std::chrono::steady_clock::now();
+
+                double used = (double)gOctaves / samples;
+                std::printf("%-9s %-3d %-9.2f %14.2f %14.2f %12.1f %14.1f\n", fractal.name, dimensions, threshold,
+                            used, octaves - used,
+                            std::chrono::duration<double, std::nano>(mid - start).count() / samples,
+                            std::chrono::duration<double, std::nano>(end - mid).count() / samples);
+            }
+        }
+    }
+
+    return 0;
+}
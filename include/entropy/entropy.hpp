@@ -1,3 +1,4 @@
 #pragma once
 
 #include "generator.hpp"
+#include "shared.hpp"
@@ -7,7 +7,25 @@
 // midified version of https://github.com/Auburn/FastNoiseLite
 
 #pragma once
+#include <array>
+#include <climits>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <vector>
+
+// Invoked once for every cellular feature point the 3D search evaluates. Define before including this header to
+// instrument the search, e.g. to count visited cells (see bench/bench_cellular.cpp).
+#ifndef ENTROPY_CELLULAR_VISIT
+#define ENTROPY_CELLULAR_VISIT() ((void)0)
+#endif
+
+// Invoked once for every fractal octave a threshold query evaluates (see bench/bench_threshold.cpp)
+#ifndef ENTROPY_THRESHOLD_OCTAVE
+#define ENTROPY_THRESHOLD_OCTAVE() ((void)0)
+#endif
 
 namespace entropy {
 
@@ -56,6 +74,106 @@ namespace entropy {
             DomainWarpType_BasicGrid
         };
 
+        enum NormalPacking {
+            NormalPacking_RGB8,       // x, y, z as (n * 0.5 + 0.5) * 255 in bytes 0, 1, 2, byte 3 is 255
+            NormalPacking_Octahedral16 // Octahedral x, y as 16-bit unsigned normalized in the low and high half
+        };
+
+        /// <summary>
+        /// Everything a single cellular neighbourhood scan knows about a position, see GetCellular(...)
+        /// </summary>
+        /// <remarks>
+        /// Distances use the current cellular distance function (square rooted for Euclidean) without the -1 offset
+        /// applied by GetNoise(...). Only the first distanceCount entries of distance are filled, the rest are 0.
+        /// The feature point is given in input coordinates (before frequency and 3D rotation are applied).
+        /// </remarks>
+        struct CellularResult {
+            float distance[4]; // F1, F2, F3, F4 in ascending order
+            int closestHash;
+            float cellValue; // Same as CellularReturnType_CellValue
+            float pointX;
+            float pointY;
+            float pointZ; // 0 for 2D queries
+        };
+
+        /// <summary>
+        /// A cellular feature point, see EnumerateCellularPoints(...)
+        /// </summary>
+        struct CellularPoint {
+            float x;
+            float y;
+            float z; // 0 for 2D points
+            int hash;
+            float cellValue; // Same as CellularReturnType_CellValue for samples closest to this point
+        };
+
+        /// <summary>
+        /// Domain warp displacement of a grid region sampled on a coarser lattice, see BuildWarpField2D(...)
+        /// </summary>
+        /// <remarks>
+        /// Lattice nodes lie on every decimation-th grid position, with one extra node of padding on each side.
+        /// maxError is the largest distance between the interpolated and the exact displacement found at the centre of
+        /// every coarse cell, where interpolation error peaks. It is an estimate, not a strict bound.
+        /// </remarks>
+        struct WarpField {
+            int dimensions; // 2 or 3
+            int xStart, yStart, zStart;
+            int xSize, ySize, zSize; // Grid size in samples, zSize is 1 for 2D fields
+            float step;
+            int decimation;
+            bool cubic; // Catmull-Rom instead of linear interpolation
+            int xNodes, yNodes, zNodes;
+            std::vector<float> displacement; // dimensions values per node, x-major
+            float maxError;
+        };
+
+        /// <summary>
+        /// Cached xy-dependent work for animating a 2D slice of 3D noise over z, see BuildNoiseSlice3D(...)
+        /// </summary>
+        /// <remarks>
+        /// Value and Perlin noise without 3D rotation keep the lattice planes either side of the current z per octave,
+        /// reduced over x and y. Other settings keep each pixel's transformed position at z = 0.
+        /// </remarks>
+        struct NoiseSlice {
+            int xStart, yStart;
+            int xSize, ySize;
+            float step;
+            bool planeCache;
+            int octaves;
+            std::vector<float> positions; // Transformed (x, y, z) per pixel at z = 0, without plane cache
+            float tx, ty, tz;             // Transformed offset per unit of z
+            std::vector<int> planeCells;  // z cell held by each of the two plane slots per octave, INT_MIN if empty
+            std::vector<float> planes;    // Per octave and slot: Value 1, Perlin 2 values per pixel
+        };
+
+        /// <summary>
+        /// Border voxels shared between neighbouring padded chunks, see GetNoiseChunk3D(...)
+        /// </summary>
+        /// <remarks>
+        /// Each chunk's interior splits into 3x3x3 boxes along every axis: the first padding voxels, the middle and the
+        /// last padding voxels. The 26 boxes touching a face are the ones neighbouring chunks need for their padding,
+        /// they are kept here once computed. A chunk's entry is dropped once it and all 26 neighbours have been
+        /// generated, generating the same chunk again does not count twice. Clear the cache after changing any noise
+        /// setting.
+        /// </remarks>
+        struct ChunkBorderCache {
+            struct Borders {
+                std::vector<float> boxes;    // The 26 border boxes in box order, allocated on first use
+                uint32_t valid = 0;          // Bit per box index (z * 9 + y * 3 + x) holding computed values
+                uint32_t generated = 0;      // Bit per chunk among this one and its 26 neighbours already generated
+            };
+
+            int size = 0, padding = 0;
+            float step = 0;
+            std::map<std::array<int, 3>, Borders> chunks;
+            size_t samplesComputed = 0; // Noise samples evaluated through this cache, for diagnostics
+
+            void Clear() {
+                chunks.clear();
+                samplesComputed = 0;
+            }
+        };
+
         /// <summary>
         /// Create new FastNoise object with optional seed
         /// </summary>
@@ -65,6 +183,7 @@ namespace entropy {
             mNoiseType = NoiseType_OpenSimplex2;
             mRotationType3D = RotationType3D_None;
             mTransformType3D = TransformType3D_DefaultOpenSimplex2;
+            mApproximateMath = false;
 
             mFractalType = FractalType_None;
             mOctaves = 3;
@@ -72,12 +191,16 @@ namespace entropy {
             mGain = 0.5f;
             mWeightedStrength = 0.0f;
             mPingPongStrength = 2.0f;
+            mFractalTolerance = 0.0f;
 
             mFractalBounding = 1 / 1.75f;
+            mNoiseOctaves = 3;
+            mWarpOctaves = 3;
 
             mCellularDistanceFunction = CellularDistanceFunction_EuclideanSq;
             mCellularReturnType = CellularReturnType_Distance;
             mCellularJitterModifier = 1.0f;
+            mCellularExtendedSearch = false;
 
             mDomainWarpType = DomainWarpType_OpenSimplex2;
             mWarpTransformType3D = TransformType3D_DefaultOpenSimplex2;
@@ -124,6 +247,19 @@ namespace entropy {
             UpdateWarpTransformType3D();
         }
 
+        /// <summary>
+        /// Trades exactness for speed in the 2D and 3D Perlin and ValueCubic kernels
+        /// </summary>
+        /// <remarks>
+        /// Default: false
+        /// Perlin uses the cubic Hermite interpolant instead of the quintic one, max error per octave 0.16 in 2D and
+        /// 0.2 in 3D, and is no longer smooth in its second derivative. ValueCubic blends the 4x4(x4) lattice values
+        /// with per-axis weights instead of nested CubicLerp calls, max error 1e-6.
+        /// Meant for previews. GetNoise, the array, grid, slice and seed ensemble functions follow this setting, 1D and
+        /// 4D noise stay exact.
+        /// </remarks>
+        void SetApproximateMath(bool enabled) { mApproximateMath = enabled; }
+
         /// <summary>
         /// Sets method for combining octaves in all fractal noise types
         /// </summary>
@@ -180,6 +316,22 @@ namespace entropy {
         /// </remarks>
         void SetFractalPingPongStrength(float pingPongStrength) { mPingPongStrength = pingPongStrength; }
 
+        /// <summary>
+        /// Sets the absolute error fractal noise and fractal domain warp may trade for speed
+        /// </summary>
+        /// <remarks>
+        /// Default: 0.0 (all octaves are evaluated)
+        /// Trailing octaves whose combined amplitude is below the tolerance are skipped. Fractal noise then stays
+        /// within the tolerance of the full octave sum, and DomainWarp(...) fractals within the tolerance per axis,
+        /// in input coordinates. The output bounding still follows SetFractalOctaves(...), so the scale of the output
+        /// does not change.
+        /// Note: Keep weighted strength between 0...1 for the error bound to hold
+        /// </remarks>
+        void SetFractalTolerance(float tolerance) {
+            mFractalTolerance = tolerance;
+            CalculateFractalBounding();
+        }
+
         /// <summary>
         /// Sets distance function used in cellular noise calculations
         /// </summary>
@@ -203,10 +355,21 @@ namespace entropy {
         /// </summary>
         /// <remarks>
         /// Default: 1.0
-        /// Note: Setting this higher than 1 will cause artifacts
+        /// Note: Setting this higher than 1 will cause artifacts, unless SetCellularExtendedSearch is enabled
         /// </remarks>
         void SetCellularJitter(float cellularJitter) { mCellularJitterModifier = cellularJitter; }
 
+        /// <summary>
+        /// Searches as many neighbouring cells as the cellular jitter requires, instead of only the adjacent ones
+        /// </summary>
+        /// <remarks>
+        /// Default: false
+        /// Allows artifact free jitter above 1. Cells are visited nearest first and skipped once they cannot hold a
+        /// closer point, so the cost grows slowly with jitter rather than with the full search volume.
+        /// Applies to GetNoise and the grid functions, GetCellular always searches adjacent cells only.
+        /// </remarks>
+        void SetCellularExtendedSearch(bool enabled) { mCellularExtendedSearch = enabled; }
+
         /// <summary>
         /// Sets the warp algorithm when using DomainWarp(...)
         /// </summary>
@@ -224,7 +387,37 @@ namespace entropy {
         /// <remarks>
         /// Default: 1.0
         /// </remarks>
-        void SetDomainWarpAmp(float domainWarpAmp) { mDomainWarpAmp = domainWarpAmp; }
+        void SetDomainWarpAmp(float domainWarpAmp) {
+            mDomainWarpAmp = domainWarpAmp;
+            CalculateFractalBounding();
+        }
+
+        /// <summary>
+        /// 1D noise at given position using current settings
+        /// </summary>
+        /// <remarks>
+        /// Supports Perlin, Value and ValueCubic, OpenSimplex2 and OpenSimplex2S use the Perlin kernel. Cellular noise
+        /// has no 1D form and returns 0. See GetNoiseStream1D(...) for runs of evenly spaced samples.
+        /// </remarks>
+        /// <returns>
+        /// Noise output bounded between -1...1
+        /// </returns>
+        template <typename FNfloat> float GetNoise(FNfloat x) const {
+            Arguments_must_be_floating_point_values<FNfloat>();
+
+            TransformNoiseCoordinate(x);
+
+            switch (mFractalType) {
+            default:
+                return GenNoiseSingle(mSeed, x);
+            case FractalType_FBm:
+                return GenFractalFBm(x);
+            case FractalType_Ridged:
+                return GenFractalRidged(x);
+            case FractalType_PingPong:
+                return GenFractalPingPong(x);
+            }
+        }
 
         /// <summary>
         /// 2D noise at given position using current settings
@@ -272,6 +465,34 @@ namespace entropy {
             }
         }
 
+        /// <summary>
+        /// 4D noise at given position using current settings
+        /// </summary>
+        /// <remarks>
+        /// Supports OpenSimplex2, Perlin, Value and Cellular, OpenSimplex2S and ValueCubic use the OpenSimplex2 and
+        /// Value kernels. 3D rotation and extended cellular search do not apply.
+        /// Moving w through a 3D field animates it, sampling two axes on a circle loops it, see GetNoiseLoop2D(...)
+        /// </remarks>
+        /// <returns>
+        /// Noise output bounded between -1...1
+        /// </returns>
+        template <typename FNfloat> float GetNoise(FNfloat x, FNfloat y, FNfloat z, FNfloat w) const {
+            Arguments_must_be_floating_point_values<FNfloat>();
+
+            TransformNoiseCoordinate(x, y, z, w);
+
+            switch (mFractalType) {
+            default:
+                return GenNoiseSingle(mSeed, x, y, z, w);
+            case FractalType_FBm:
+                return GenFractalFBm(x, y, z, w);
+            case FractalType_Ridged:
+                return GenFractalRidged(x, y, z, w);
+            case FractalType_PingPong:
+                return GenFractalPingPong(x, y, z, w);
+            }
+        }
+
         /// <summary>
         /// 2D warps the input position using current domain warp settings
         /// </summary>
@@ -320,1538 +541,6733 @@ namespace entropy {
             }
         }
 
-      private:
-        template <typename T> struct Arguments_must_be_floating_point_values;
-
-        enum TransformType3D {
-            TransformType3D_None,
-            TransformType3D_ImproveXYPlanes,
-            TransformType3D_ImproveXZPlanes,
-            TransformType3D_DefaultOpenSimplex2
-        };
-
-        int mSeed;
-        float mFrequency;
-        NoiseType mNoiseType;
-        RotationType3D mRotationType3D;
-        TransformType3D mTransformType3D;
-
-        FractalType mFractalType;
-        int mOctaves;
-        float mLacunarity;
-        float mGain;
-        float mWeightedStrength;
-        float mPingPongStrength;
-
-        float mFractalBounding;
-
-        CellularDistanceFunction mCellularDistanceFunction;
-        CellularReturnType mCellularReturnType;
-        float mCellularJitterModifier;
-
-        DomainWarpType mDomainWarpType;
-        TransformType3D mWarpTransformType3D;
-        float mDomainWarpAmp;
+        /// <summary>
+        /// DomainWarp(x, y) applied in place to count positions stored as separate x and y arrays
+        /// </summary>
+        /// <remarks>
+        /// Results match DomainWarp(x, y) per position. The warp type and coordinate transform are resolved once per
+        /// span of positions instead of once per position.
+        /// </remarks>
+        /// <example>
+        /// Example usage with GetNoiseArray2D
+        /// <code>DomainWarpArray2D(xs, ys, count)
+        /// GetNoiseArray2D(xs, ys, out, count)</code>
+        /// </example>
+        template <typename FNfloat> void DomainWarpArray2D(FNfloat *xs, FNfloat *ys, size_t count) const {
+            Arguments_must_be_floating_point_values<FNfloat>();
 
-        template <typename T> struct Lookup {
-            static const T Gradients2D[];
-            static const T Gradients3D[];
-            static const T RandVecs2D[];
-            static const T RandVecs3D[];
-        };
+            for (size_t i = 0; i < count; i += BatchSize) {
+                int spanCount = count - i < (size_t)BatchSize ? (int)(count - i) : BatchSize;
+                DomainWarpSpan(xs + i, ys + i, spanCount);
+            }
+        }
 
-        static float FastMin(float a, float b) { return a < b ? a : b; }
+        /// <summary>
+        /// DomainWarp(x, y, z) applied in place to count positions stored as separate x, y and z arrays
+        /// </summary>
+        /// <remarks>
+        /// Results match DomainWarp(x, y, z) per position.
+        /// </remarks>
+        template <typename FNfloat> void DomainWarpArray3D(FNfloat *xs, FNfloat *ys, FNfloat *zs, size_t count) const {
+            Arguments_must_be_floating_point_values<FNfloat>();
 
-        static float FastMax(float a, float b) { return a > b ? a : b; }
+            for (size_t i = 0; i < count; i += BatchSize) {
+                int spanCount = count - i < (size_t)BatchSize ? (int)(count - i) : BatchSize;
+                DomainWarpSpan(xs + i, ys + i, zs + i, spanCount);
+            }
+        }
 
-        static float FastAbs(float f) { return f < 0 ? -f : f; }
+        /// <summary>
+        /// GetNoise(x, y) for count positions stored as separate x and y arrays
+        /// </summary>
+        void GetNoiseArray2D(const float *xs, const float *ys, float *out, size_t count) const {
+            float xt[BatchSize];
+            float yt[BatchSize];
 
-        static float FastSqrt(float f) { return sqrtf(f); }
+            for (size_t i0 = 0; i0 < count; i0 += BatchSize) {
+                int spanCount = count - i0 < (size_t)BatchSize ? (int)(count - i0) : BatchSize;
 
-        template <typename FNfloat> static int FastFloor(FNfloat f) { return f >= 0 ? (int)f : (int)f - 1; }
+                for (int i = 0; i < spanCount; i++) {
+                    xt[i] = xs[i0 + i];
+                    yt[i] = ys[i0 + i];
+                    TransformNoiseCoordinate(xt[i], yt[i]);
+                }
+                GenFractalSpan(xt, yt, out + i0, spanCount, false);
+            }
+        }
 
-        template <typename FNfloat> static int FastRound(FNfloat f) {
-            return f >= 0 ? (int)(f + 0.5f) : (int)(f - 0.5f);
+        /// <summary>
+        /// GetNoise(x, y, z) for count positions stored as separate x, y and z arrays
+        /// </summary>
+        void GetNoiseArray3D(const float *xs, const float *ys, const float *zs, float *out, size_t count) const {
+            float xt[BatchSize];
+            float yt[BatchSize];
+            float zt[BatchSize];
+
+            for (size_t i0 = 0; i0 < count; i0 += BatchSize) {
+                int spanCount = count - i0 < (size_t)BatchSize ? (int)(count - i0) : BatchSize;
+
+                for (int i = 0; i < spanCount; i++) {
+                    xt[i] = xs[i0 + i];
+                    yt[i] = ys[i0 + i];
+                    zt[i] = zs[i0 + i];
+                    TransformNoiseCoordinate(xt[i], yt[i], zt[i]);
+                }
+                GenFractalSpan(xt, yt, zt, out + i0, spanCount, false);
+            }
         }
 
-        static float Lerp(float a, float b, float t) { return a + t * (b - a); }
+        /// <summary>
+        /// Same as GetNoise(x, y) > threshold, stopping once the remaining octaves can no longer change the answer
+        /// </summary>
+        /// <remarks>
+        /// FBm, Ridged and PingPong octaves each move the sum by at most their amplitude (octave weighting only
+        /// lowers it), so after each octave the query ends when the partial sum is further from the threshold than
+        /// the amplitudes still to come. Thresholds near the noise surface still evaluate every octave. Cellular
+        /// noise with a distance return type has no such bound and always evaluates every octave.
+        /// </remarks>
+        template <typename FNfloat> bool IsAbove(FNfloat x, FNfloat y, float threshold) const {
+            Arguments_must_be_floating_point_values<FNfloat>();
 
-        static float InterpHermite(float t) { return t * t * (3 - 2 * t); }
+            TransformNoiseCoordinate(x, y);
+            return GenFractalIsAbove(x, y, threshold);
+        }
 
-        static float InterpQuintic(float t) { return t * t * t * (t * (t * 6 - 15) + 10); }
+        /// <summary>
+        /// Same as GetNoise(x, y, z) > threshold, stopping once the remaining octaves can no longer change the answer
+        /// </summary>
+        /// <remarks>
+        /// See the 2D overload
+        /// </remarks>
+        template <typename FNfloat> bool IsAbove(FNfloat x, FNfloat y, FNfloat z, float threshold) const {
+            Arguments_must_be_floating_point_values<FNfloat>();
 
-        static float CubicLerp(float a, float b, float c, float d, float t) {
-            float p = (d - c) - (a - b);
-            return t * t * t * p + t * t * ((a - b) - p) + t * (c - a) + b;
+            TransformNoiseCoordinate(x, y, z);
+            return GenFractalIsAbove(x, y, z, threshold);
         }
 
-        static float PingPong(float t) {
-            t -= (int)(t * 0.5f) * 2;
-            return t < 1 ? t : 2 - t;
+        /// <summary>
+        /// IsAbove(x, y, threshold) for count positions stored as separate x and y arrays
+        /// </summary>
+        void IsAboveArray2D(const float *xs, const float *ys, bool *out, size_t count, float threshold) const {
+            for (size_t i = 0; i < count; i++) {
+                out[i] = IsAbove(xs[i], ys[i], threshold);
+            }
         }
 
-        void CalculateFractalBounding() {
-            float gain = FastAbs(mGain);
-            float amp = gain;
-            float ampFractal = 1.0f;
-            for (int i = 1; i < mOctaves; i++) {
-                ampFractal += amp;
-                amp *= gain;
+        /// <summary>
+        /// IsAbove(x, y, z, threshold) for count positions stored as separate x, y and z arrays
+        /// </summary>
+        void IsAboveArray3D(const float *xs, const float *ys, const float *zs, bool *out, size_t count,
+                            float threshold) const {
+            for (size_t i = 0; i < count; i++) {
+                out[i] = IsAbove(xs[i], ys[i], zs[i], threshold);
             }
-            mFractalBounding = 1 / ampFractal;
         }
 
-        // Hashing
-        static const int PrimeX = 501125321;
-        static const int PrimeY = 1136930381;
-        static const int PrimeZ = 1720413743;
+        /// <summary>
+        /// IsAbove(...) over the grid of GetNoiseGrid2D(...), packed as one bit per sample
+        /// </summary>
+        /// <remarks>
+        /// Sample i = y * xSize + x is bit i % 64 of bits[i / 64]. bits must hold (xSize * ySize + 63) / 64 words,
+        /// unused bits of the last word are cleared.
+        /// </remarks>
+        void IsAboveGrid2D(uint64_t *bits, int xStart, int yStart, int xSize, int ySize, float threshold,
+                           float step = 1.0f) const {
+            size_t count = (size_t)xSize * ySize;
+            std::memset(bits, 0, (count + 63) / 64 * sizeof(uint64_t));
 
-        static int Hash(int seed, int xPrimed, int yPrimed) {
-            int hash = seed ^ xPrimed ^ yPrimed;
+            for (int y = 0; y < ySize; y++) {
+                float yPos = (float)(yStart + y) * step;
 
-            hash *= 0x27d4eb2d;
-            return hash;
+                for (int x = 0; x < xSize; x++) {
+                    size_t i = (size_t)y * xSize + x;
+                    bits[i / 64] |= (uint64_t)IsAbove((float)(xStart + x) * step, yPos, threshold) << (i % 64);
+                }
+            }
         }
 
-        static int Hash(int seed, int xPrimed, int yPrimed, int zPrimed) {
-            int hash = seed ^ xPrimed ^ yPrimed ^ zPrimed;
+        /// <summary>
+        /// IsAbove(...) over the grid of GetNoiseGrid3D(...), packed as one bit per sample, see IsAboveGrid2D(...)
+        /// </summary>
+        void IsAboveGrid3D(uint64_t *bits, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize,
+                           float threshold, float step = 1.0f) const {
+            size_t count = (size_t)xSize * ySize * zSize;
+            std::memset(bits, 0, (count + 63) / 64 * sizeof(uint64_t));
 
-            hash *= 0x27d4eb2d;
-            return hash;
-        }
+            for (int z = 0; z < zSize; z++) {
+                float zPos = (float)(zStart + z) * step;
 
-        static float ValCoord(int seed, int xPrimed, int yPrimed) {
-            int hash = Hash(seed, xPrimed, yPrimed);
+                for (int y = 0; y < ySize; y++) {
+                    float yPos = (float)(yStart + y) * step;
 
-            hash *= hash;
-            hash ^= hash << 19;
-            return hash * (1 / 2147483648.0f);
+                    for (int x = 0; x < xSize; x++) {
+                        size_t i = ((size_t)z * ySize + y) * xSize + x;
+                        bits[i / 64] |= (uint64_t)IsAbove((float)(xStart + x) * step, yPos, zPos, threshold)
+                                        << (i % 64);
+                    }
+                }
+            }
         }
 
-        static float ValCoord(int seed, int xPrimed, int yPrimed, int zPrimed) {
-            int hash = Hash(seed, xPrimed, yPrimed, zPrimed);
+        /// <summary>
+        /// 2D noise at one position for several seeds: out[i] is GetNoise(x, y) with the seed set to seeds[i]
+        /// </summary>
+        /// <remarks>
+        /// The coordinate transform, lattice cell and interpolation weights are shared by all seeds, only the hashing
+        /// runs per seed, in loops over seeds that vectorize for Value and Perlin noise.
+        /// </remarks>
+        template <typename FNfloat> void GetNoiseSeeds(FNfloat x, FNfloat y, const int *seeds, float *out,
+                                                       int seedCount) const {
+            Arguments_must_be_floating_point_values<FNfloat>();
 
-            hash *= hash;
-            hash ^= hash << 19;
-            return hash * (1 / 2147483648.0f);
+            TransformNoiseCoordinate(x, y);
+
+            for (int i = 0; i < seedCount; i += BatchSize) {
+                int count = seedCount - i < BatchSize ? seedCount - i : BatchSize;
+                GenFractalSeeds(seeds + i, x, y, out + i, count);
+            }
         }
 
-        float GradCoord(int seed, int xPrimed, int yPrimed, float xd, float yd) const {
-            int hash = Hash(seed, xPrimed, yPrimed);
-            hash ^= hash >> 15;
-            hash &= 127 << 1;
+        /// <summary>
+        /// 3D noise at one position for several seeds: out[i] is GetNoise(x, y, z) with the seed set to seeds[i]
+        /// </summary>
+        /// <remarks>
+        /// See the 2D overload
+        /// </remarks>
+        template <typename FNfloat> void GetNoiseSeeds(FNfloat x, FNfloat y, FNfloat z, const int *seeds, float *out,
+                                                       int seedCount) const {
+            Arguments_must_be_floating_point_values<FNfloat>();
 
-            float xg = Lookup<float>::Gradients2D[hash];
-            float yg = Lookup<float>::Gradients2D[hash | 1];
+            TransformNoiseCoordinate(x, y, z);
 
-            return xd * xg + yd * yg;
+            for (int i = 0; i < seedCount; i += BatchSize) {
+                int count = seedCount - i < BatchSize ? seedCount - i : BatchSize;
+                GenFractalSeeds(seeds + i, x, y, z, out + i, count);
+            }
         }
 
-        float GradCoord(int seed, int xPrimed, int yPrimed, int zPrimed, float xd, float yd, float zd) const {
-            int hash = Hash(seed, xPrimed, yPrimed, zPrimed);
-            hash ^= hash >> 15;
-            hash &= 63 << 2;
+        /// <summary>
+        /// GetNoiseSeeds(x, y, ...) for count positions, seeds interleaved per position: out[i * seedCount + s]
+        /// </summary>
+        void GetNoiseSeedsArray2D(const float *xs, const float *ys, float *out, size_t count, const int *seeds,
+                                  int seedCount) const {
+            for (size_t i = 0; i < count; i++) {
+                GetNoiseSeeds(xs[i], ys[i], seeds, out + i * seedCount, seedCount);
+            }
+        }
 
-            float xg = Lookup<float>::Gradients3D[hash];
-            float yg = Lookup<float>::Gradients3D[hash | 1];
-            float zg = Lookup<float>::Gradients3D[hash | 2];
-
-            return xd * xg + yd * yg + zd * zg;
+        /// <summary>
+        /// GetNoiseSeeds(x, y, z, ...) for count positions, seeds interleaved per position: out[i * seedCount + s]
+        /// </summary>
+        void GetNoiseSeedsArray3D(const float *xs, const float *ys, const float *zs, float *out, size_t count,
+                                  const int *seeds, int seedCount) const {
+            for (size_t i = 0; i < count; i++) {
+                GetNoiseSeeds(xs[i], ys[i], zs[i], seeds, out + i * seedCount, seedCount);
+            }
         }
 
-        void GradCoordOut(int seed, int xPrimed, int yPrimed, float &xo, float &yo) const {
-            int hash = Hash(seed, xPrimed, yPrimed) & (255 << 1);
+        /// <summary>
+        /// 2D cellular query returning F1...F4, the closest cell and its feature point from a single scan
+        /// </summary>
+        /// <remarks>
+        /// Uses the cellular settings regardless of noise type, fractal settings are ignored.
+        /// distanceCount: number of nearest distances to track, 1...4 (default 2)
+        /// </remarks>
+        template <typename FNfloat> CellularResult GetCellular(FNfloat x, FNfloat y, int distanceCount = 2) const {
+            Arguments_must_be_floating_point_values<FNfloat>();
 
-            xo = Lookup<float>::RandVecs2D[hash];
-            yo = Lookup<float>::RandVecs2D[hash | 1];
+            x *= mFrequency;
+            y *= mFrequency;
+
+            CellularResult result;
+            switch (distanceCount <= 1 ? 1 : distanceCount >= 4 ? 4 : distanceCount) {
+            case 1:
+                SingleCellularResult<1>(mSeed, x, y, result);
+                break;
+            default:
+            case 2:
+                SingleCellularResult<2>(mSeed, x, y, result);
+                break;
+            case 3:
+                SingleCellularResult<3>(mSeed, x, y, result);
+                break;
+            case 4:
+                SingleCellularResult<4>(mSeed, x, y, result);
+                break;
+            }
+
+            result.pointX /= mFrequency;
+            result.pointY /= mFrequency;
+            return result;
         }
 
-        void GradCoordOut(int seed, int xPrimed, int yPrimed, int zPrimed, float &xo, float &yo, float &zo) const {
-            int hash = Hash(seed, xPrimed, yPrimed, zPrimed) & (255 << 2);
+        /// <summary>
+        /// 3D cellular query returning F1...F4, the closest cell and its feature point from a single scan
+        /// </summary>
+        /// <remarks>
+        /// Uses the cellular settings and 3D rotation type regardless of noise type, fractal settings are ignored.
+        /// distanceCount: number of nearest distances to track, 1...4 (default 2)
+        /// </remarks>
+        template <typename FNfloat>
+        CellularResult GetCellular(FNfloat x, FNfloat y, FNfloat z, int distanceCount = 2) const {
+            Arguments_must_be_floating_point_values<FNfloat>();
 
-            xo = Lookup<float>::RandVecs3D[hash];
-            yo = Lookup<float>::RandVecs3D[hash | 1];
-            zo = Lookup<float>::RandVecs3D[hash | 2];
+            TransformType3D transformType = CellularTransformType3D();
+            x *= mFrequency;
+            y *= mFrequency;
+            z *= mFrequency;
+            RotateCoordinate3D(transformType, x, y, z);
+
+            CellularResult result;
+            switch (distanceCount <= 1 ? 1 : distanceCount >= 4 ? 4 : distanceCount) {
+            case 1:
+                SingleCellularResult<1>(mSeed, x, y, z, result);
+                break;
+            default:
+            case 2:
+                SingleCellularResult<2>(mSeed, x, y, z, result);
+                break;
+            case 3:
+                SingleCellularResult<3>(mSeed, x, y, z, result);
+                break;
+            case 4:
+                SingleCellularResult<4>(mSeed, x, y, z, result);
+                break;
+            }
+
+            InverseRotateCoordinate3D(transformType, result.pointX, result.pointY, result.pointZ);
+            result.pointX /= mFrequency;
+            result.pointY /= mFrequency;
+            result.pointZ /= mFrequency;
+            return result;
         }
 
-        void GradCoordDual(int seed, int xPrimed, int yPrimed, float xd, float yd, float &xo, float &yo) const {
-            int hash = Hash(seed, xPrimed, yPrimed);
-            int index1 = hash & (127 << 1);
-            int index2 = (hash >> 7) & (255 << 1);
+        /// <summary>
+        /// GetCellular(x, y) for count positions stored as separate x and y arrays
+        /// </summary>
+        void GetCellularArray2D(const float *xs, const float *ys, CellularResult *out, size_t count,
+                                int distanceCount = 2) const {
+            for (size_t i = 0; i < count; i++) {
+                out[i] = GetCellular(xs[i], ys[i], distanceCount);
+            }
+        }
 
-            float xg = Lookup<float>::Gradients2D[index1];
-            float yg = Lookup<float>::Gradients2D[index1 | 1];
-            float value = xd * xg + yd * yg;
+        /// <summary>
+        /// GetCellular(x, y, z) for count positions stored as separate x, y and z arrays
+        /// </summary>
+        void GetCellularArray3D(const float *xs, const float *ys, const float *zs, CellularResult *out, size_t count,
+                                int distanceCount = 2) const {
+            for (size_t i = 0; i < count; i++) {
+                out[i] = GetCellular(xs[i], ys[i], zs[i], distanceCount);
+            }
+        }
 
-            float xgo = Lookup<float>::RandVecs2D[index2];
-            float ygo = Lookup<float>::RandVecs2D[index2 | 1];
+        /// <summary>
+        /// Calls callback(const CellularPoint &) for every 2D cellular feature point with xMin <= x < xMax and
+        /// yMin <= y < yMax
+        /// </summary>
+        /// <remarks>
+        /// Points are the ones cellular noise measures distances to, for the current seed (the first octave of
+        /// fractal noise) and jitter, in input coordinates. Each lattice cell that can hold a point inside the box is
+        /// visited once, so the cost follows the box area in cells rather than any sampling resolution. The box is
+        /// half open, so adjacent boxes report each point exactly once.
+        /// </remarks>
+        template <typename Callback>
+        void EnumerateCellularPoints(float xMin, float yMin, float xMax, float yMax, Callback &&callback) const {
+            // Every point lies within the jitter reach of its cell's integer position
+            float jitter = 0.43701595f * mCellularJitterModifier;
+            float reach = FastAbs(jitter);
+            float lowX = FastMin(xMin * mFrequency, xMax * mFrequency) - reach;
+            float lowY = FastMin(yMin * mFrequency, yMax * mFrequency) - reach;
+            float highX = FastMax(xMin * mFrequency, xMax * mFrequency) + reach;
+            float highY = FastMax(yMin * mFrequency, yMax * mFrequency) + reach;
+
+            CellularPoint point;
+            point.z = 0;
+
+            // Primed coordinates step in unsigned arithmetic, the products wrap and signed overflow would be undefined
+            unsigned xPrimed = (unsigned)FastFloor(lowX) * (unsigned)PrimeX;
+
+            for (int xi = FastFloor(lowX); xi <= FastFloor(highX); xi++) {
+                unsigned yPrimed = (unsigned)FastFloor(lowY) * (unsigned)PrimeY;
+
+                for (int yi = FastFloor(lowY); yi <= FastFloor(highY); yi++) {
+                    int hash = Hash(mSeed, (int)xPrimed, (int)yPrimed);
+                    int idx = hash & (255 << 1);
+
+                    point.x = ((float)xi + Lookup<float>::RandVecs2D[idx] * jitter) / mFrequency;
+                    point.y = ((float)yi + Lookup<float>::RandVecs2D[idx | 1] * jitter) / mFrequency;
+                    if (point.x >= xMin && point.x < xMax && point.y >= yMin && point.y < yMax) {
+                        point.hash = hash;
+                        point.cellValue = hash * (1 / 2147483648.0f);
+                        callback(point);
+                    }
+                    yPrimed += (unsigned)PrimeY;
+                }
+                xPrimed += (unsigned)PrimeX;
+            }
+        }
 
-            xo = value * xgo;
-            yo = value * ygo;
+        /// <summary>
+        /// Calls callback(const CellularPoint &) for every 3D cellular feature point inside the half open box
+        /// [xMin, xMax) x [yMin, yMax) x [zMin, zMax)
+        /// </summary>
+        /// <remarks>
+        /// See the 2D overload. The 3D rotation type applies as for cellular noise, cells are visited over the
+        /// bounding box of the rotated box.
+        /// </remarks>
+        template <typename Callback>
+        void EnumerateCellularPoints(float xMin, float yMin, float zMin, float xMax, float yMax, float zMax,
+                                     Callback &&callback) const {
+            TransformType3D transformType = CellularTransformType3D();
+            float jitter = 0.39614353f * mCellularJitterModifier;
+            float low[3], high[3];
+            CellularBounds3D(transformType, xMin, yMin, zMin, xMax, yMax, zMax, FastAbs(jitter), low, high);
+
+            CellularPoint point;
+
+            // Stepped in unsigned arithmetic as in the 2D overload
+            unsigned xPrimed = (unsigned)FastFloor(low[0]) * (unsigned)PrimeX;
+
+            for (int xi = FastFloor(low[0]); xi <= FastFloor(high[0]); xi++) {
+                unsigned yPrimed = (unsigned)FastFloor(low[1]) * (unsigned)PrimeY;
+
+                for (int yi = FastFloor(low[1]); yi <= FastFloor(high[1]); yi++) {
+                    unsigned zPrimed = (unsigned)FastFloor(low[2]) * (unsigned)PrimeZ;
+
+                    for (int zi = FastFloor(low[2]); zi <= FastFloor(high[2]); zi++) {
+                        int hash = Hash(mSeed, (int)xPrimed, (int)yPrimed, (int)zPrimed);
+                        int idx = hash & (255 << 2);
+
+                        point.x = (float)xi + Lookup<float>::RandVecs3D[idx] * jitter;
+                        point.y = (float)yi + Lookup<float>::RandVecs3D[idx | 1] * jitter;
+                        point.z = (float)zi + Lookup<float>::RandVecs3D[idx | 2] * jitter;
+                        EmitCellularPoint(transformType, hash, xMin, yMin, zMin, xMax, yMax, zMax, point, callback);
+                        zPrimed += (unsigned)PrimeZ;
+                    }
+                    yPrimed += (unsigned)PrimeY;
+                }
+                xPrimed += (unsigned)PrimeX;
+            }
         }
 
-        void GradCoordDual(int seed, int xPrimed, int yPrimed, int zPrimed, float xd, float yd, float zd, float &xo,
-                           float &yo, float &zo) const {
-            int hash = Hash(seed, xPrimed, yPrimed, zPrimed);
-            int index1 = hash & (63 << 2);
-            int index2 = (hash >> 6) & (255 << 2);
+        /// <summary>
+        /// Appends every 2D cellular feature point inside the half open box to out, see the callback overload
+        /// </summary>
+        void EnumerateCellularPoints(float xMin, float yMin, float xMax, float yMax,
+                                     std::vector<CellularPoint> &out) const {
+            EnumerateCellularPoints(xMin, yMin, xMax, yMax, AppendCellularPoint{out});
+        }
 
-            float xg = Lookup<float>::Gradients3D[index1];
-            float yg = Lookup<float>::Gradients3D[index1 | 1];
-            float zg = Lookup<float>::Gradients3D[index1 | 2];
-            float value = xd * xg + yd * yg + zd * zg;
+        /// <summary>
+        /// Appends every 3D cellular feature point inside the half open box to out, see the callback overload
+        /// </summary>
+        void EnumerateCellularPoints(float xMin, float yMin, float zMin, float xMax, float yMax, float zMax,
+                                     std::vector<CellularPoint> &out) const {
+            EnumerateCellularPoints(xMin, yMin, zMin, xMax, yMax, zMax, AppendCellularPoint{out});
+        }
 
-            float xgo = Lookup<float>::RandVecs3D[index2];
-            float ygo = Lookup<float>::RandVecs3D[index2 | 1];
-            float zgo = Lookup<float>::RandVecs3D[index2 | 2];
+        /// <summary>
+        /// Scatters points over [xMin, xMax) x [yMin, yMax) with a local density taken from another generator, calling
+        /// callback(const CellularPoint &) for each kept point
+        /// </summary>
+        /// <remarks>
+        /// Candidates are this generator's 2D cellular feature points (see EnumerateCellularPoints(...)), one per cell
+        /// of 1 / frequency, so spacing follows the frequency and jitter settings and never clumps. density is
+        /// evaluated once per candidate, in batches, and maps linearly from low (never kept) to high (always kept).
+        /// The keep decision uses the candidate's hash, so results do not depend on the box and tiles match up.
+        /// density may be this generator.
+        /// </remarks>
+        template <typename Callback>
+        void ScatterPoints(const NoiseGen &density, float xMin, float yMin, float xMax, float yMax,
+                           Callback &&callback, float low = -1.0f, float high = 1.0f) const {
+            ScatterFilter<Callback> filter(density, callback, low, high);
+            EnumerateCellularPoints(xMin, yMin, xMax, yMax, filter);
+            filter.Flush();
+        }
 
-            xo = value * xgo;
-            yo = value * ygo;
-            zo = value * zgo;
+        /// <summary>
+        /// Appends the points ScatterPoints(density, ...) keeps to out, see the callback overload
+        /// </summary>
+        void ScatterPoints(const NoiseGen &density, float xMin, float yMin, float xMax, float yMax,
+                           std::vector<CellularPoint> &out, float low = -1.0f, float high = 1.0f) const {
+            ScatterPoints(density, xMin, yMin, xMax, yMax, AppendCellularPoint{out}, low, high);
         }
 
-        // Generic noise gen
+        /// <summary>
+        /// 2D noise for a grid of positions ((xStart + x) * step, (yStart + y) * step) using current settings
+        /// </summary>
+        /// <remarks>
+        /// Output is x-major: out[y * xSize + x], values match GetNoise(...) at the same positions.
+        /// Positions are integer multiples of step, so grids with touching start offsets tile seamlessly.
+        /// Cellular noise reuses feature points between all samples along a row that share cells, Value, ValueCubic
+        /// and Perlin noise reuse lattice values the same way.
+        /// </remarks>
+        void GetNoiseGrid2D(float *out, int xStart, int yStart, int xSize, int ySize, float step = 1.0f) const {
+            float xs[BatchSize];
+            float ys[BatchSize];
+            bool rowAligned = IsRowAligned2D();
 
-        template <typename FNfloat> float GenNoiseSingle(int seed, FNfloat x, FNfloat y) const {
-            switch (mNoiseType) {
-            case NoiseType_OpenSimplex2:
-                return SingleSimplex(seed, x, y);
-            case NoiseType_OpenSimplex2S:
-                return SingleOpenSimplex2S(seed, x, y);
-            case NoiseType_Cellular:
-                return SingleCellular(seed, x, y);
-            case NoiseType_Perlin:
-                return SinglePerlin(seed, x, y);
-            case NoiseType_ValueCubic:
-                return SingleValueCubic(seed, x, y);
-            case NoiseType_Value:
-                return SingleValue(seed, x, y);
-            default:
-                return 0;
+            for (int y = 0; y < ySize; y++) {
+                float yPos = (float)(yStart + y) * step;
+
+                for (int x0 = 0; x0 < xSize; x0 += BatchSize) {
+                    int count = xSize - x0 < BatchSize ? xSize - x0 : BatchSize;
+
+                    for (int i = 0; i < count; i++) {
+                        xs[i] = (float)(xStart + x0 + i) * step;
+                        ys[i] = yPos;
+                        TransformNoiseCoordinate(xs[i], ys[i]);
+                    }
+                    GenFractalSpan(xs, ys, out + (size_t)y * xSize + x0, count, rowAligned);
+                }
             }
         }
 
-        template <typename FNfloat> float GenNoiseSingle(int seed, FNfloat x, FNfloat y, FNfloat z) const {
-            switch (mNoiseType) {
-            case NoiseType_OpenSimplex2:
-                return SingleOpenSimplex2(seed, x, y, z);
-            case NoiseType_OpenSimplex2S:
-                return SingleOpenSimplex2S(seed, x, y, z);
-            case NoiseType_Cellular:
-                return SingleCellular(seed, x, y, z);
-            case NoiseType_Perlin:
-                return SinglePerlin(seed, x, y, z);
-            case NoiseType_ValueCubic:
-                return SingleValueCubic(seed, x, y, z);
-            case NoiseType_Value:
-                return SingleValue(seed, x, y, z);
-            default:
-                return 0;
+        /// <summary>
+        /// 3D noise for a grid of positions ((xStart + x) * step, (yStart + y) * step, (zStart + z) * step)
+        /// </summary>
+        /// <remarks>
+        /// Output is x-major: out[(z * ySize + y) * xSize + x], values match GetNoise(...) at the same positions.
+        /// Cellular, Value, ValueCubic and Perlin noise reuse feature points or lattice values between all samples
+        /// along a row that share cells, as long as no 3D rotation is applied.
+        /// </remarks>
+        void GetNoiseGrid3D(float *out, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize,
+                            float step = 1.0f) const {
+            float xs[BatchSize];
+            float ys[BatchSize];
+            float zs[BatchSize];
+            bool rowAligned = IsRowAligned3D();
+
+            for (int z = 0; z < zSize; z++) {
+                float zPos = (float)(zStart + z) * step;
+
+                for (int y = 0; y < ySize; y++) {
+                    float yPos = (float)(yStart + y) * step;
+                    float *row = out + ((size_t)z * ySize + y) * xSize;
+
+                    for (int x0 = 0; x0 < xSize; x0 += BatchSize) {
+                        int count = xSize - x0 < BatchSize ? xSize - x0 : BatchSize;
+
+                        for (int i = 0; i < count; i++) {
+                            xs[i] = (float)(xStart + x0 + i) * step;
+                            ys[i] = yPos;
+                            zs[i] = zPos;
+                            TransformNoiseCoordinate(xs[i], ys[i], zs[i]);
+                        }
+                        GenFractalSpan(xs, ys, zs, row + x0, count, rowAligned);
+                    }
+                }
             }
         }
 
-        // Noise Coordinate Transforms (frequency, and possible skew or rotation)
+        /// <summary>
+        /// GetNoiseGrid2D(...) written as 8-bit unsigned normalized values
+        /// </summary>
+        /// <remarks>
+        /// Noise from low to high maps linearly onto 0...255, rounded to nearest, values outside are clamped. The remap
+        /// runs on each span while it is in cache, so only the 8-bit output is written to memory.
+        /// </remarks>
+        void GetNoiseGrid2D(uint8_t *out, int xStart, int yStart, int xSize, int ySize, float step = 1.0f,
+                            float low = -1.0f, float high = 1.0f) const {
+            QuantizeUNorm quantize = MakeQuantizeUNorm(255, low, high);
+            GenQuantizedGrid2D(out, xStart, yStart, xSize, ySize, step, quantize);
+        }
 
-        template <typename FNfloat> void TransformNoiseCoordinate(FNfloat &x, FNfloat &y) const {
-            x *= mFrequency;
-            y *= mFrequency;
+        /// <summary>
+        /// GetNoiseGrid2D(...) written as 16-bit unsigned normalized values
+        /// </summary>
+        /// <remarks>
+        /// Noise from low to high maps linearly onto 0...65535, rounded to nearest, values outside are clamped
+        /// </remarks>
+        void GetNoiseGrid2D(uint16_t *out, int xStart, int yStart, int xSize, int ySize, float step = 1.0f,
+                            float low = -1.0f, float high = 1.0f) const {
+            QuantizeUNorm quantize = MakeQuantizeUNorm(65535, low, high);
+            GenQuantizedGrid2D(out, xStart, yStart, xSize, ySize, step, quantize);
+        }
 
-            switch (mNoiseType) {
-            case NoiseType_OpenSimplex2:
-            case NoiseType_OpenSimplex2S: {
-                const FNfloat SQRT3 = (FNfloat)1.7320508075688772935274463415059;
-                const FNfloat F2 = 0.5f * (SQRT3 - 1);
-                FNfloat t = (x + y) * F2;
-                x += t;
-                y += t;
-            } break;
-            default:
-                break;
+        /// <summary>
+        /// GetNoiseGrid2D(...) written as IEEE 754 half precision bit patterns of noise * scale + offset
+        /// </summary>
+        /// <remarks>
+        /// Rounded to nearest even. Values beyond the half range saturate to +-65504 instead of becoming infinite.
+        /// </remarks>
+        void GetNoiseGridHalf2D(uint16_t *out, int xStart, int yStart, int xSize, int ySize, float step = 1.0f,
+                                float scale = 1.0f, float offset = 0.0f) const {
+            QuantizeHalf quantize = {scale, offset};
+            GenQuantizedGrid2D(out, xStart, yStart, xSize, ySize, step, quantize);
+        }
+
+        /// <summary>
+        /// GetNoiseGrid3D(...) written as 8-bit unsigned normalized values, see the 2D overload
+        /// </summary>
+        void GetNoiseGrid3D(uint8_t *out, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize,
+                            float step = 1.0f, float low = -1.0f, float high = 1.0f) const {
+            QuantizeUNorm quantize = MakeQuantizeUNorm(255, low, high);
+            GenQuantizedGrid3D(out, xStart, yStart, zStart, xSize, ySize, zSize, step, quantize);
+        }
+
+        /// <summary>
+        /// GetNoiseGrid3D(...) written as 16-bit unsigned normalized values, see the 2D overload
+        /// </summary>
+        void GetNoiseGrid3D(uint16_t *out, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize,
+                            float step = 1.0f, float low = -1.0f, float high = 1.0f) const {
+            QuantizeUNorm quantize = MakeQuantizeUNorm(65535, low, high);
+            GenQuantizedGrid3D(out, xStart, yStart, zStart, xSize, ySize, zSize, step, quantize);
+        }
+
+        /// <summary>
+        /// GetNoiseGrid3D(...) written as IEEE 754 half precision bit patterns, see GetNoiseGridHalf2D(...)
+        /// </summary>
+        void GetNoiseGridHalf3D(uint16_t *out, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize,
+                                float step = 1.0f, float scale = 1.0f, float offset = 0.0f) const {
+            QuantizeHalf quantize = {scale, offset};
+            GenQuantizedGrid3D(out, xStart, yStart, zStart, xSize, ySize, zSize, step, quantize);
+        }
+
+        /// <summary>
+        /// Height grid as GetNoiseGrid2D(...) together with surface normals and slope, in a single pass
+        /// </summary>
+        /// <remarks>
+        /// The surface is z = height * heightScale over input coordinates, the normal is normalize(-dz/dx, -dz/dy, 1)
+        /// and slope is |(dz/dx, dz/dy)| (rise over run). Any of height, normals and slope may be null.
+        /// Derivatives are central differences over a one-sample border around the grid, computed from the same
+        /// global positions, so normals of adjacent tiles match along shared edges. With analytic set, Value and
+        /// Perlin noise (single noise, or FBm/Ridged without weighted strength) carry exact derivatives through the
+        /// noise instead. Those are independent of step but cost more per sample than the differences.
+        /// </remarks>
+        void GetNoiseNormalGrid2D(float *height, uint32_t *normals, float *slope, int xStart, int yStart, int xSize,
+                                  int ySize, float step = 1.0f, float heightScale = 1.0f,
+                                  NormalPacking packing = NormalPacking_RGB8, bool analytic = false) const {
+            float h[BatchSize];
+            float dx[BatchSize];
+            float dy[BatchSize];
+
+            if (analytic && HasAnalyticGradient2D()) {
+                float xs[BatchSize];
+                float ys[BatchSize];
+
+                for (int y = 0; y < ySize; y++) {
+                    float yPos = (float)(yStart + y) * step;
+
+                    for (int x0 = 0; x0 < xSize; x0 += BatchSize) {
+                        int count = xSize - x0 < BatchSize ? xSize - x0 : BatchSize;
+
+                        for (int i = 0; i < count; i++) {
+                            xs[i] = (float)(xStart + x0 + i) * step;
+                            ys[i] = yPos;
+                            TransformNoiseCoordinate(xs[i], ys[i]);
+                        }
+                        GenFractalGradientSpan(xs, ys, h, dx, dy, count);
+                        StoreSurface(h, dx, dy, (size_t)y * xSize + x0, count, height, normals, slope, heightScale,
+                                     packing);
+                    }
+                }
+                return;
+            }
+
+            // Rolling window of three rows, each padded by one sample on both sides
+            int padded = xSize + 2;
+            std::vector<float> window((size_t)padded * 3);
+            GetNoiseGrid2D(window.data(), xStart - 1, yStart - 1, padded, 2, step);
+            float inverseSpan = 0.5f / step;
+
+            for (int y = 0; y < ySize; y++) {
+                const float *above = window.data() + (size_t)(y % 3) * padded;
+                const float *row = window.data() + (size_t)((y + 1) % 3) * padded;
+                float *below = window.data() + (size_t)((y + 2) % 3) * padded;
+                GetNoiseGrid2D(below, xStart - 1, yStart + y + 1, padded, 1, step);
+
+                for (int x0 = 0; x0 < xSize; x0 += BatchSize) {
+                    int count = xSize - x0 < BatchSize ? xSize - x0 : BatchSize;
+
+                    for (int i = 0; i < count; i++) {
+                        int x = x0 + i + 1;
+                        h[i] = row[x];
+                        dx[i] = (row[x + 1] - row[x - 1]) * inverseSpan;
+                        dy[i] = (below[x] - above[x]) * inverseSpan;
+                    }
+                    StoreSurface(h, dx, dy, (size_t)y * xSize + x0, count, height, normals, slope, heightScale,
+                                 packing);
+                }
             }
         }
 
-        template <typename FNfloat> void TransformNoiseCoordinate(FNfloat &x, FNfloat &y, FNfloat &z) const {
-            x *= mFrequency;
-            y *= mFrequency;
-            z *= mFrequency;
+        /// <summary>
+        /// 3D noise for chunk (cx, cy, cz) of size^3 voxels with padding voxels around it on every side
+        /// </summary>
+        /// <remarks>
+        /// Output is out[(z * n + y) * n + x] with n = size + 2 * padding, the same as GetNoiseGrid3D(out,
+        /// cx * size - padding, cy * size - padding, cz * size - padding, n, n, n, step). With a cache, voxels within
+        /// padding of a chunk face are computed once and copied into every neighbouring chunk that needs them, so a
+        /// region of chunks evaluates each voxel exactly once. Sharing needs padding of at most size / 2, larger
+        /// padding is computed without the cache. A cache set up for another size, padding or step is cleared first.
+        /// </remarks>
+        void GetNoiseChunk3D(float *out, int cx, int cy, int cz, int size, int padding, float step = 1.0f,
+                             ChunkBorderCache *cache = nullptr) const {
+            int paddedSize = size + 2 * padding;
+            if (cache == nullptr || padding <= 0 || padding * 2 > size) {
+                GetNoiseGrid3D(out, cx * size - padding, cy * size - padding, cz * size - padding, paddedSize,
+                               paddedSize, paddedSize, step);
+                return;
+            }
+            if (cache->size != size || cache->padding != padding || cache->step != step) {
+                cache->Clear();
+                cache->size = size;
+                cache->padding = padding;
+                cache->step = step;
+            }
 
-            switch (mTransformType3D) {
-            case TransformType3D_ImproveXYPlanes: {
-                FNfloat xy = x + y;
-                FNfloat s2 = xy * -(FNfloat)0.211324865405187;
-                z *= (FNfloat)0.577350269189626;
-                x += s2 - z;
-                y = y + s2 - z;
-                z += xy * (FNfloat)0.577350269189626;
-            } break;
-            case TransformType3D_ImproveXZPlanes: {
-                FNfloat xz = x + z;
-                FNfloat s2 = xz * -(FNfloat)0.211324865405187;
-                y *= (FNfloat)0.577350269189626;
-                x += s2 - y;
-                z += s2 - y;
-                y += xz * (FNfloat)0.577350269189626;
-            } break;
-            case TransformType3D_DefaultOpenSimplex2: {
-                const FNfloat R3 = (FNfloat)(2.0 / 3.0);
-                FNfloat r = (x + y + z) * R3; // Rotation, not skew
-                x = r - x;
-                y = r - y;
-                z = r - z;
-            } break;
-            default:
-                break;
+            // Along each axis the padded chunk splits into 5 segments: the last border box of the previous chunk, the
+            // chunk's own three boxes and the first border box of the next chunk
+            int segmentStart[6] = {0, padding, 2 * padding, size, size + padding, paddedSize};
+            static const int segmentChunk[5] = {-1, 0, 0, 0, 1};
+            static const int segmentBox[5] = {2, 0, 1, 2, 0};
+
+            ChunkBorderCache::Borders *owners[125];
+            int boxes[125];
+            bool compute[125];
+
+            for (int sz = 0; sz < 5; sz++) {
+                for (int sy = 0; sy < 5; sy++) {
+                    for (int sx = 0; sx < 5; sx++) {
+                        int segment = (sz * 5 + sy) * 5 + sx;
+                        int box = (segmentBox[sz] * 3 + segmentBox[sy]) * 3 + segmentBox[sx];
+                        boxes[segment] = box;
+                        owners[segment] = nullptr;
+                        compute[segment] = true;
+
+                        if (box == 13) {
+                            continue; // Interior of this chunk, never shared
+                        }
+                        std::array<int, 3> key = {cx + segmentChunk[sx], cy + segmentChunk[sy], cz + segmentChunk[sz]};
+                        ChunkBorderCache::Borders &owner = cache->chunks[key];
+                        if (owner.boxes.empty()) {
+                            owner.boxes.resize((size_t)size * size * size -
+                                               (size_t)(size - 2 * padding) * (size - 2 * padding) *
+                                                   (size - 2 * padding));
+                        }
+                        owners[segment] = &owner;
+                        compute[segment] = !(owner.valid & (1u << box));
+                    }
+                }
+            }
+
+            // Runs of neighbouring segments along x that need computing are evaluated as one span per row
+            float xs[BatchSize];
+            float ys[BatchSize];
+            float zs[BatchSize];
+            bool rowAligned = IsRowAligned3D();
+            int origin = -padding;
+
+            for (int sz = 0; sz < 5; sz++) {
+                for (int sy = 0; sy < 5; sy++) {
+                    int rowSegment = (sz * 5 + sy) * 5;
+
+                    for (int sx0 = 0; sx0 < 5; sx0++) {
+                        if (!compute[rowSegment + sx0]) {
+                            continue;
+                        }
+                        int sx1 = sx0;
+                        while (sx1 < 4 && compute[rowSegment + sx1 + 1]) {
+                            sx1++;
+                        }
+                        int xBegin = segmentStart[sx0], xEnd = segmentStart[sx1 + 1];
+
+                        for (int z = segmentStart[sz]; z < segmentStart[sz + 1]; z++) {
+                            float zPos = (float)(cz * size + origin + z) * step;
+
+                            for (int y = segmentStart[sy]; y < segmentStart[sy + 1]; y++) {
+                                float yPos = (float)(cy * size + origin + y) * step;
+                                float *row = out + ((size_t)z * paddedSize + y) * paddedSize;
+
+                                for (int x0 = xBegin; x0 < xEnd; x0 += BatchSize) {
+                                    int count = xEnd - x0 < BatchSize ? xEnd - x0 : BatchSize;
+
+                                    for (int i = 0; i < count; i++) {
+                                        xs[i] = (float)(cx * size + origin + x0 + i) * step;
+                                        ys[i] = yPos;
+                                        zs[i] = zPos;
+                                        TransformNoiseCoordinate(xs[i], ys[i], zs[i]);
+                                    }
+                                    GenFractalSpan(xs, ys, zs, row + x0, count, rowAligned);
+                                }
+                            }
+                        }
+                        cache->samplesComputed += (size_t)(xEnd - xBegin) * (segmentStart[sy + 1] - segmentStart[sy]) *
+                                                  (segmentStart[sz + 1] - segmentStart[sz]);
+                        sx0 = sx1;
+                    }
+                }
+            }
+
+            for (int segment = 0; segment < 125; segment++) {
+                if (owners[segment] == nullptr) {
+                    continue;
+                }
+                int sx = segment % 5, sy = segment / 5 % 5, sz = segment / 25;
+                int xSize = segmentStart[sx + 1] - segmentStart[sx];
+                int ySize = segmentStart[sy + 1] - segmentStart[sy];
+                int zSize = segmentStart[sz + 1] - segmentStart[sz];
+                float *volume = out + ((size_t)segmentStart[sz] * paddedSize + segmentStart[sy]) * paddedSize +
+                                segmentStart[sx];
+                float *box = owners[segment]->boxes.data() + ChunkBorderOffset(boxes[segment], size, padding);
+
+                CopyChunkBorder(volume, paddedSize, box, xSize, ySize, zSize, compute[segment]);
+                owners[segment]->valid |= 1u << boxes[segment];
+            }
+
+            // A chunk's borders are no longer needed once it and all its neighbours have been generated. Each
+            // neighbour sets its own bit, so regenerating a chunk leaves the other entries in place
+            for (int z = -1; z <= 1; z++) {
+                for (int y = -1; y <= 1; y++) {
+                    for (int x = -1; x <= 1; x++) {
+                        std::array<int, 3> key = {cx + x, cy + y, cz + z};
+                        ChunkBorderCache::Borders &borders = cache->chunks[key];
+                        borders.generated |= 1u << ((1 - z) * 9 + (1 - y) * 3 + (1 - x));
+                        if (borders.generated == (1u << 27) - 1) {
+                            cache->chunks.erase(key);
+                        }
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// 2D noise for a grid of positions first warped by another generator's domain warp settings
+        /// </summary>
+        /// <remarks>
+        /// Equivalent to warp.DomainWarp(x, y) followed by GetNoise(x, y) at ((xStart + x) * step,
+        /// (yStart + y) * step), output is x-major: out[y * xSize + x]. Warped positions only live in a small per span
+        /// buffer, nothing but the output is written to memory. warp may be this generator.
+        /// </remarks>
+        void GetWarpedNoiseGrid2D(const NoiseGen &warp, float *out, int xStart, int yStart, int xSize, int ySize,
+                                  float step = 1.0f) const {
+            float xs[BatchSize];
+            float ys[BatchSize];
+
+            for (int y = 0; y < ySize; y++) {
+                float yPos = (float)(yStart + y) * step;
+
+                for (int x0 = 0; x0 < xSize; x0 += BatchSize) {
+                    int count = xSize - x0 < BatchSize ? xSize - x0 : BatchSize;
+
+                    for (int i = 0; i < count; i++) {
+                        xs[i] = (float)(xStart + x0 + i) * step;
+                        ys[i] = yPos;
+                    }
+                    warp.DomainWarpSpan(xs, ys, count);
+
+                    for (int i = 0; i < count; i++) {
+                        TransformNoiseCoordinate(xs[i], ys[i]);
+                    }
+                    GenFractalSpan(xs, ys, out + (size_t)y * xSize + x0, count, false);
+                }
+            }
+        }
+
+        /// <summary>
+        /// 3D noise for a grid of positions first warped by another generator's domain warp settings
+        /// </summary>
+        /// <remarks>
+        /// Equivalent to warp.DomainWarp(x, y, z) followed by GetNoise(x, y, z), output is x-major:
+        /// out[(z * ySize + y) * xSize + x]. warp may be this generator.
+        /// </remarks>
+        void GetWarpedNoiseGrid3D(const NoiseGen &warp, float *out, int xStart, int yStart, int zStart, int xSize,
+                                  int ySize, int zSize, float step = 1.0f) const {
+            float xs[BatchSize];
+            float ys[BatchSize];
+            float zs[BatchSize];
+
+            for (int z = 0; z < zSize; z++) {
+                float zPos = (float)(zStart + z) * step;
+
+                for (int y = 0; y < ySize; y++) {
+                    float yPos = (float)(yStart + y) * step;
+                    float *row = out + ((size_t)z * ySize + y) * xSize;
+
+                    for (int x0 = 0; x0 < xSize; x0 += BatchSize) {
+                        int count = xSize - x0 < BatchSize ? xSize - x0 : BatchSize;
+
+                        for (int i = 0; i < count; i++) {
+                            xs[i] = (float)(xStart + x0 + i) * step;
+                            ys[i] = yPos;
+                            zs[i] = zPos;
+                        }
+                        warp.DomainWarpSpan(xs, ys, zs, count);
+
+                        for (int i = 0; i < count; i++) {
+                            TransformNoiseCoordinate(xs[i], ys[i], zs[i]);
+                        }
+                        GenFractalSpan(xs, ys, zs, row + x0, count, false);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Evaluates the 2D domain warp displacement for a grid region on a lattice decimation times coarser
+        /// </summary>
+        /// <remarks>
+        /// The region matches GetNoiseGrid2D(...) with the same start, size and step. Use it with
+        /// GetWarpedNoiseGrid2D(field, out) to warp the grid at close to the cost of unwarped noise. Smooth (low
+        /// frequency) warps tolerate large decimation, check field.maxError to pick it.
+        /// cubic: Catmull-Rom instead of linear interpolation between lattice nodes
+        /// </remarks>
+        void BuildWarpField2D(WarpField &field, int xStart, int yStart, int xSize, int ySize, int decimation,
+                              float step = 1.0f, bool cubic = false) const {
+            InitWarpField(field, 2, xStart, yStart, 0, xSize, ySize, 1, decimation, step, cubic);
+            float xs[BatchSize];
+            float ys[BatchSize];
+
+            for (int yn = 0; yn < field.yNodes; yn++) {
+                float yPos = WarpFieldNodePosition(field, field.yStart, yn);
+
+                for (int x0 = 0; x0 < field.xNodes; x0 += BatchSize) {
+                    int count = field.xNodes - x0 < BatchSize ? field.xNodes - x0 : BatchSize;
+
+                    for (int i = 0; i < count; i++) {
+                        xs[i] = WarpFieldNodePosition(field, field.xStart, x0 + i);
+                        ys[i] = yPos;
+                    }
+                    DomainWarpSpan(xs, ys, count);
+
+                    float *node = field.displacement.data() + ((size_t)yn * field.xNodes + x0) * 2;
+                    for (int i = 0; i < count; i++) {
+                        node[i * 2] = xs[i] - WarpFieldNodePosition(field, field.xStart, x0 + i);
+                        node[i * 2 + 1] = ys[i] - yPos;
+                    }
+                }
+            }
+
+            if (field.decimation == 1)
+                return;
+
+            float centre = 0.5f * field.decimation;
+            for (int y = 0; y < (field.ySize - 1) / field.decimation + 1; y++) {
+                for (int x = 0; x < (field.xSize - 1) / field.decimation + 1; x++) {
+                    float px = (field.xStart + x * field.decimation + centre) * field.step;
+                    float py = (field.yStart + y * field.decimation + centre) * field.step;
+                    float wx = px, wy = py;
+                    DomainWarp(wx, wy);
+
+                    float d[3];
+                    SampleWarpField(field, x, 0.5f, y, 0.5f, 0, 0, d);
+                    float ex = d[0] - (wx - px);
+                    float ey = d[1] - (wy - py);
+                    field.maxError = FastMax(field.maxError, FastSqrt(ex * ex + ey * ey));
+                }
+            }
+        }
+
+        /// <summary>
+        /// Evaluates the 3D domain warp displacement for a grid region on a lattice decimation times coarser
+        /// </summary>
+        /// <remarks>
+        /// The region matches GetNoiseGrid3D(...) with the same start, size and step, see BuildWarpField2D(...)
+        /// </remarks>
+        void BuildWarpField3D(WarpField &field, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize,
+                              int decimation, float step = 1.0f, bool cubic = false) const {
+            InitWarpField(field, 3, xStart, yStart, zStart, xSize, ySize, zSize, decimation, step, cubic);
+            float xs[BatchSize];
+            float ys[BatchSize];
+            float zs[BatchSize];
+
+            for (int zn = 0; zn < field.zNodes; zn++) {
+                float zPos = WarpFieldNodePosition(field, field.zStart, zn);
+
+                for (int yn = 0; yn < field.yNodes; yn++) {
+                    float yPos = WarpFieldNodePosition(field, field.yStart, yn);
+
+                    for (int x0 = 0; x0 < field.xNodes; x0 += BatchSize) {
+                        int count = field.xNodes - x0 < BatchSize ? field.xNodes - x0 : BatchSize;
+
+                        for (int i = 0; i < count; i++) {
+                            xs[i] = WarpFieldNodePosition(field, field.xStart, x0 + i);
+                            ys[i] = yPos;
+                            zs[i] = zPos;
+                        }
+                        DomainWarpSpan(xs, ys, zs, count);
+
+                        float *node =
+                            field.displacement.data() + (((size_t)zn * field.yNodes + yn) * field.xNodes + x0) * 3;
+                        for (int i = 0; i < count; i++) {
+                            node[i * 3] = xs[i] - WarpFieldNodePosition(field, field.xStart, x0 + i);
+                            node[i * 3 + 1] = ys[i] - yPos;
+                            node[i * 3 + 2] = zs[i] - zPos;
+                        }
+                    }
+                }
+            }
+
+            if (field.decimation == 1)
+                return;
+
+            float centre = 0.5f * field.decimation;
+            for (int z = 0; z < (field.zSize - 1) / field.decimation + 1; z++) {
+                for (int y = 0; y < (field.ySize - 1) / field.decimation + 1; y++) {
+                    for (int x = 0; x < (field.xSize - 1) / field.decimation + 1; x++) {
+                        float px = (field.xStart + x * field.decimation + centre) * field.step;
+                        float py = (field.yStart + y * field.decimation + centre) * field.step;
+                        float pz = (field.zStart + z * field.decimation + centre) * field.step;
+                        float wx = px, wy = py, wz = pz;
+                        DomainWarp(wx, wy, wz);
+
+                        float d[3];
+                        SampleWarpField(field, x, 0.5f, y, 0.5f, z, 0.5f, d);
+                        float ex = d[0] - (wx - px);
+                        float ey = d[1] - (wy - py);
+                        float ez = d[2] - (wz - pz);
+                        field.maxError = FastMax(field.maxError, FastSqrt(ex * ex + ey * ey + ez * ez));
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// 2D noise for the grid region of a warp field, with positions displaced by the interpolated field
+        /// </summary>
+        /// <remarks>
+        /// Output is x-major: out[y * field.xSize + x]. With decimation 1 this matches
+        /// GetWarpedNoiseGrid2D(warp, ...) up to float rounding. A 3D field is rejected and out is left unchanged.
+        /// </remarks>
+        void GetWarpedNoiseGrid2D(const WarpField &field, float *out) const {
+            if (field.dimensions != 2)
+                return;
+
+            std::vector<float> row((size_t)field.xNodes * 2);
+            std::vector<int> columnNode;
+            std::vector<float> columnWeight;
+            WarpFieldColumns(field, columnNode, columnWeight);
+            float xs[BatchSize];
+            float ys[BatchSize];
+
+            for (int y = 0; y < field.ySize; y++) {
+                float yPos = (float)(field.yStart + y) * field.step;
+                CollapseWarpField(field, y, 0, row.data());
+
+                for (int x0 = 0; x0 < field.xSize; x0 += BatchSize) {
+                    int count = field.xSize - x0 < BatchSize ? field.xSize - x0 : BatchSize;
+
+                    for (int i = 0; i < count; i++) {
+                        int x = x0 + i;
+                        const float *node = row.data() + columnNode[x] * 2;
+                        const float *w = columnWeight.data() + x * 4;
+                        float dx = w[0] * node[0] + w[1] * node[2] + w[2] * node[4] + w[3] * node[6];
+                        float dy = w[0] * node[1] + w[1] * node[3] + w[2] * node[5] + w[3] * node[7];
+
+                        xs[i] = (float)(field.xStart + x) * field.step + dx;
+                        ys[i] = yPos + dy;
+                        TransformNoiseCoordinate(xs[i], ys[i]);
+                    }
+                    GenFractalSpan(xs, ys, out + (size_t)y * field.xSize + x0, count, false);
+                }
+            }
+        }
+
+        /// <summary>
+        /// 3D noise for the grid region of a warp field, with positions displaced by the interpolated field
+        /// </summary>
+        /// <remarks>
+        /// Output is x-major: out[(z * field.ySize + y) * field.xSize + x]. A 2D field is rejected and out is left
+        /// unchanged.
+        /// </remarks>
+        void GetWarpedNoiseGrid3D(const WarpField &field, float *out) const {
+            if (field.dimensions != 3)
+                return;
+
+            std::vector<float> row((size_t)field.xNodes * 3);
+            std::vector<int> columnNode;
+            std::vector<float> columnWeight;
+            WarpFieldColumns(field, columnNode, columnWeight);
+            float xs[BatchSize];
+            float ys[BatchSize];
+            float zs[BatchSize];
+
+            for (int z = 0; z < field.zSize; z++) {
+                float zPos = (float)(field.zStart + z) * field.step;
+
+                for (int y = 0; y < field.ySize; y++) {
+                    float yPos = (float)(field.yStart + y) * field.step;
+                    float *outRow = out + ((size_t)z * field.ySize + y) * field.xSize;
+                    CollapseWarpField(field, y, z, row.data());
+
+                    for (int x0 = 0; x0 < field.xSize; x0 += BatchSize) {
+                        int count = field.xSize - x0 < BatchSize ? field.xSize - x0 : BatchSize;
+
+                        for (int i = 0; i < count; i++) {
+                            int x = x0 + i;
+                            const float *node = row.data() + columnNode[x] * 3;
+                            const float *w = columnWeight.data() + x * 4;
+                            float dx = w[0] * node[0] + w[1] * node[3] + w[2] * node[6] + w[3] * node[9];
+                            float dy = w[0] * node[1] + w[1] * node[4] + w[2] * node[7] + w[3] * node[10];
+                            float dz = w[0] * node[2] + w[1] * node[5] + w[2] * node[8] + w[3] * node[11];
+
+                            xs[i] = (float)(field.xStart + x) * field.step + dx;
+                            ys[i] = yPos + dy;
+                            zs[i] = zPos + dz;
+                            TransformNoiseCoordinate(xs[i], ys[i], zs[i]);
+                        }
+                        GenFractalSpan(xs, ys, zs, outRow + x0, count, false);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// 4D noise for a grid of positions ((xStart + x) * step, ..., (wStart + w) * step)
+        /// </summary>
+        /// <remarks>
+        /// Output is x-major: out[((w * zSize + z) * ySize + y) * xSize + x], values match GetNoise(x, y, z, w)
+        /// </remarks>
+        void GetNoiseGrid4D(float *out, int xStart, int yStart, int zStart, int wStart, int xSize, int ySize, int zSize,
+                            int wSize, float step = 1.0f) const {
+            for (int w = 0; w < wSize; w++) {
+                GetNoiseSlice4D(out + (size_t)w * zSize * ySize * xSize, xStart, yStart, zStart, xSize, ySize, zSize,
+                                (float)(wStart + w) * step, step);
+            }
+        }
+
+        /// <summary>
+        /// 3D slice of 4D noise at a fixed w, for a grid of positions ((xStart + x) * step, ..., (zStart + z) * step)
+        /// </summary>
+        /// <remarks>
+        /// Output is x-major: out[(z * ySize + y) * xSize + x]. Stepping w between calls animates a volume.
+        /// Values match GetNoise(x, y, z, w) at the same positions. Value and Perlin noise reuse lattice values
+        /// between all samples along a row that share cells.
+        /// </remarks>
+        void GetNoiseSlice4D(float *out, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize, float w,
+                             float step = 1.0f) const {
+            float xs[BatchSize];
+            float ys[BatchSize];
+            float zs[BatchSize];
+            float ws[BatchSize];
+            bool rowAligned = IsRowAligned4D();
+
+            for (int z = 0; z < zSize; z++) {
+                float zPos = (float)(zStart + z) * step;
+
+                for (int y = 0; y < ySize; y++) {
+                    float yPos = (float)(yStart + y) * step;
+                    float *row = out + ((size_t)z * ySize + y) * xSize;
+
+                    for (int x0 = 0; x0 < xSize; x0 += BatchSize) {
+                        int count = xSize - x0 < BatchSize ? xSize - x0 : BatchSize;
+
+                        for (int i = 0; i < count; i++) {
+                            xs[i] = (float)(xStart + x0 + i) * step;
+                            ys[i] = yPos;
+                            zs[i] = zPos;
+                            ws[i] = w;
+                            TransformNoiseCoordinate(xs[i], ys[i], zs[i], ws[i]);
+                        }
+                        GenFractalSpan(xs, ys, zs, ws, row + x0, count, rowAligned);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// One frame of a seamlessly looping 2D animation, sampled from 4D noise with z and w on a circle
+        /// </summary>
+        /// <remarks>
+        /// Output is x-major: out[y * xSize + x]. phase 0...1 covers one loop, frames at phase 0 and 1 are identical.
+        /// radius (in input units, like x and y) sets how much the pattern changes over a loop.
+        /// </remarks>
+        void GetNoiseLoop2D(float *out, int xStart, int yStart, int xSize, int ySize, float phase, float radius,
+                            float step = 1.0f) const {
+            const float TAU = 6.283185307179586476925286766559f;
+            float angle = phase * TAU;
+            float zPos = cosf(angle) * radius;
+            float wPos = sinf(angle) * radius;
+
+            float xs[BatchSize];
+            float ys[BatchSize];
+            float zs[BatchSize];
+            float ws[BatchSize];
+            bool rowAligned = IsRowAligned4D();
+
+            for (int y = 0; y < ySize; y++) {
+                float yPos = (float)(yStart + y) * step;
+                float *row = out + (size_t)y * xSize;
+
+                for (int x0 = 0; x0 < xSize; x0 += BatchSize) {
+                    int count = xSize - x0 < BatchSize ? xSize - x0 : BatchSize;
+
+                    for (int i = 0; i < count; i++) {
+                        xs[i] = (float)(xStart + x0 + i) * step;
+                        ys[i] = yPos;
+                        zs[i] = zPos;
+                        ws[i] = wPos;
+                        TransformNoiseCoordinate(xs[i], ys[i], zs[i], ws[i]);
+                    }
+                    GenFractalSpan(xs, ys, zs, ws, row + x0, count, rowAligned);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Prepares a 2D slice of 3D noise at positions ((xStart + x) * step, (yStart + y) * step, z) for
+        /// GetNoiseSlice3D(slice, z, out), doing the work that does not depend on z once
+        /// </summary>
+        /// <remarks>
+        /// Rebuild the slice after changing any noise setting. Value and Perlin noise without 3D rotation cache two
+        /// lattice planes per octave (1 or 2 floats per pixel each), so frames that stay between the same planes only
+        /// interpolate along z, and moving to the next cell rebuilds one plane. Other settings cache the transformed
+        /// position of each pixel (3 floats) and add the z offset per frame.
+        /// </remarks>
+        void BuildNoiseSlice3D(NoiseSlice &slice, int xStart, int yStart, int xSize, int ySize,
+                               float step = 1.0f) const {
+            slice.xStart = xStart;
+            slice.yStart = yStart;
+            slice.xSize = xSize > 0 ? xSize : 0;
+            slice.ySize = ySize > 0 ? ySize : 0;
+            slice.step = step;
+            slice.planeCache = mTransformType3D == TransformType3D_None &&
+                               (mNoiseType == NoiseType_Value || (mNoiseType == NoiseType_Perlin && !mApproximateMath));
+            slice.octaves = IsFractalNoise() ? mNoiseOctaves : 1;
+
+            size_t pixels = (size_t)slice.xSize * slice.ySize;
+            slice.positions.clear();
+            slice.planeCells.clear();
+            slice.planes.clear();
+
+            if (slice.planeCache) {
+                slice.tx = slice.ty = 0;
+                slice.tz = mFrequency;
+                slice.planeCells.assign((size_t)slice.octaves * 2, INT_MIN);
+                slice.planes.assign(pixels * SlicePlaneValues() * slice.octaves * 2, 0.0f);
+                return;
+            }
+
+            slice.tx = 0;
+            slice.ty = 0;
+            slice.tz = 1;
+            TransformNoiseCoordinate(slice.tx, slice.ty, slice.tz);
+
+            slice.positions.resize(pixels * 3);
+            for (int y = 0; y < slice.ySize; y++) {
+                for (int x = 0; x < slice.xSize; x++) {
+                    float *position = slice.positions.data() + ((size_t)y * slice.xSize + x) * 3;
+                    position[0] = (float)(xStart + x) * step;
+                    position[1] = (float)(yStart + y) * step;
+                    position[2] = 0;
+                    TransformNoiseCoordinate(position[0], position[1], position[2]);
+                }
+            }
+        }
+
+        /// <summary>
+        /// 2D slice of 3D noise at depth z for a slice prepared by BuildNoiseSlice3D(...)
+        /// </summary>
+        /// <remarks>
+        /// Output is x-major: out[y * xSize + x]. Matches GetNoise(x, y, z) at the same positions, exactly for Value
+        /// noise without 3D rotation and up to float rounding otherwise. Updates the plane cache held in slice.
+        /// </remarks>
+        void GetNoiseSlice3D(NoiseSlice &slice, float z, float *out) const {
+            if (slice.planeCache) {
+                SlicePlanesFrame(slice, z, out);
+                return;
+            }
+
+            float xs[BatchSize];
+            float ys[BatchSize];
+            float zs[BatchSize];
+            bool rowAligned = IsRowAligned3D();
+            float xOffset = z * slice.tx;
+            float yOffset = z * slice.ty;
+            float zOffset = z * slice.tz;
+
+            for (int y = 0; y < slice.ySize; y++) {
+                const float *row = slice.positions.data() + (size_t)y * slice.xSize * 3;
+
+                for (int x0 = 0; x0 < slice.xSize; x0 += BatchSize) {
+                    int count = slice.xSize - x0 < BatchSize ? slice.xSize - x0 : BatchSize;
+
+                    for (int i = 0; i < count; i++) {
+                        const float *position = row + (size_t)(x0 + i) * 3;
+                        xs[i] = position[0] + xOffset;
+                        ys[i] = position[1] + yOffset;
+                        zs[i] = position[2] + zOffset;
+                    }
+                    GenFractalSpan(xs, ys, zs, out + (size_t)y * slice.xSize + x0, count, rowAligned);
+                }
+            }
+        }
+
+        /// <summary>
+        /// 1D noise for count consecutive positions position, position + step, ... then advances position past them
+        /// </summary>
+        /// <remarks>
+        /// Values match GetNoise(position + i * step) with double precision input, so calling once per audio block or
+        /// frame continues the same stream. Lattice values are only rehashed when a sample enters a new cell.
+        /// </remarks>
+        void GetNoiseStream1D(float *out, size_t count, double &position, double step) const {
+            double xs[BatchSize];
+
+            for (size_t i0 = 0; i0 < count; i0 += BatchSize) {
+                int spanCount = count - i0 < (size_t)BatchSize ? (int)(count - i0) : BatchSize;
+
+                for (int i = 0; i < spanCount; i++) {
+                    xs[i] = position + (double)(i0 + i) * step;
+                    TransformNoiseCoordinate(xs[i]);
+                }
+                GenFractalSpan(xs, out + i0, spanCount);
+            }
+            position += (double)count * step;
+        }
+
+      private:
+        template <typename T> struct Arguments_must_be_floating_point_values;
+
+        enum TransformType3D {
+            TransformType3D_None,
+            TransformType3D_ImproveXYPlanes,
+            TransformType3D_ImproveXZPlanes,
+            TransformType3D_DefaultOpenSimplex2
+        };
+
+        int mSeed;
+        float mFrequency;
+        NoiseType mNoiseType;
+        RotationType3D mRotationType3D;
+        TransformType3D mTransformType3D;
+        bool mApproximateMath;
+
+        FractalType mFractalType;
+        int mOctaves;
+        float mLacunarity;
+        float mGain;
+        float mWeightedStrength;
+        float mPingPongStrength;
+        float mFractalTolerance;
+
+        float mFractalBounding;
+        int mNoiseOctaves;
+        int mWarpOctaves;
+
+        CellularDistanceFunction mCellularDistanceFunction;
+        CellularReturnType mCellularReturnType;
+        float mCellularJitterModifier;
+        bool mCellularExtendedSearch;
+
+        DomainWarpType mDomainWarpType;
+        TransformType3D mWarpTransformType3D;
+        float mDomainWarpAmp;
+
+        template <typename T> struct Lookup {
+            static const T Gradients2D[];
+            static const T Gradients3D[];
+            static const T Gradients4D[];
+            static const T RandVecs2D[];
+            static const T RandVecs3D[];
+        };
+
+        static float FastMin(float a, float b) { return a < b ? a : b; }
+
+        static float FastMax(float a, float b) { return a > b ? a : b; }
+
+        static float FastAbs(float f) { return f < 0 ? -f : f; }
+
+        static float FastSqrt(float f) { return sqrtf(f); }
+
+        template <typename FNfloat> static int FastFloor(FNfloat f) { return f >= 0 ? (int)f : (int)f - 1; }
+
+        template <typename FNfloat> static int FastRound(FNfloat f) {
+            return f >= 0 ? (int)(f + 0.5f) : (int)(f - 0.5f);
+        }
+
+        static float Lerp(float a, float b, float t) { return a + t * (b - a); }
+
+        static float InterpHermite(float t) { return t * t * (3 - 2 * t); }
+
+        static float InterpQuintic(float t) { return t * t * t * (t * (t * 6 - 15) + 10); }
+
+        static float CubicLerp(float a, float b, float c, float d, float t) {
+            float p = (d - c) - (a - b);
+            return t * t * t * p + t * t * ((a - b) - p) + t * (c - a) + b;
+        }
+
+        // Simplex kernel falloff (a^2)^2, zero outside the kernel radius. Contributions are weighted by it instead of
+        // skipped, so the noise kernels have no data dependent branches on random access patterns.
+        static float KernelWeight(float a) {
+            a = FastMax(a, 0);
+            return (a * a) * (a * a);
+        }
+
+        static float PingPong(float t) {
+            t -= (int)(t * 0.5f) * 2;
+            return t < 1 ? t : 2 - t;
+        }
+
+        void CalculateFractalBounding() {
+            float gain = FastAbs(mGain);
+            float amp = gain;
+            float ampFractal = 1.0f;
+            for (int i = 1; i < mOctaves; i++) {
+                ampFractal += amp;
+                amp *= gain;
+            }
+            mFractalBounding = 1 / ampFractal;
+
+            mNoiseOctaves = ToleranceOctaves(1.0f);
+            mWarpOctaves = ToleranceOctaves(FastAbs(mDomainWarpAmp));
+        }
+
+        // Fewest leading octaves after which the remaining octaves, each within -amp...amp times scale, sum below
+        // the tolerance
+        int ToleranceOctaves(float scale) const {
+            if (!(mFractalTolerance > 0))
+                return mOctaves;
+
+            float gain = FastAbs(mGain);
+            float amp = mFractalBounding * scale;
+            float remaining = 0;
+            for (int i = 0; i < mOctaves; i++) {
+                remaining += amp;
+                amp *= gain;
+            }
+
+            amp = mFractalBounding * scale;
+            for (int octaves = 1; octaves < mOctaves; octaves++) {
+                remaining -= amp;
+                amp *= gain;
+                if (remaining < mFractalTolerance)
+                    return octaves;
+            }
+            return mOctaves;
+        }
+
+        // Hashing
+        static const int PrimeX = 501125321;
+        static const int PrimeY = 1136930381;
+        static const int PrimeZ = 1720413743;
+        static const int PrimeW = 1066037191;
+
+        static int Hash(int seed, int xPrimed) {
+            int hash = seed ^ xPrimed;
+
+            hash *= 0x27d4eb2d;
+            return hash;
+        }
+
+        static int Hash(int seed, int xPrimed, int yPrimed) {
+            int hash = seed ^ xPrimed ^ yPrimed;
+
+            hash *= 0x27d4eb2d;
+            return hash;
+        }
+
+        static int Hash(int seed, int xPrimed, int yPrimed, int zPrimed) {
+            int hash = seed ^ xPrimed ^ yPrimed ^ zPrimed;
+
+            hash *= 0x27d4eb2d;
+            return hash;
+        }
+
+        static int Hash(int seed, int xPrimed, int yPrimed, int zPrimed, int wPrimed) {
+            int hash = seed ^ xPrimed ^ yPrimed ^ zPrimed ^ wPrimed;
+
+            hash *= 0x27d4eb2d;
+            return hash;
+        }
+
+        static float ValCoord(int seed, int xPrimed) {
+            int hash = Hash(seed, xPrimed);
+
+            hash *= hash;
+            hash ^= hash << 19;
+            return hash * (1 / 2147483648.0f);
+        }
+
+        static float ValCoord(int seed, int xPrimed, int yPrimed) {
+            int hash = Hash(seed, xPrimed, yPrimed);
+
+            hash *= hash;
+            hash ^= hash << 19;
+            return hash * (1 / 2147483648.0f);
+        }
+
+        static float ValCoord(int seed, int xPrimed, int yPrimed, int zPrimed) {
+            int hash = Hash(seed, xPrimed, yPrimed, zPrimed);
+
+            hash *= hash;
+            hash ^= hash << 19;
+            return hash * (1 / 2147483648.0f);
+        }
+
+        static float ValCoord(int seed, int xPrimed, int yPrimed, int zPrimed, int wPrimed) {
+            int hash = Hash(seed, xPrimed, yPrimed, zPrimed, wPrimed);
+
+            hash *= hash;
+            hash ^= hash << 19;
+            return hash * (1 / 2147483648.0f);
+        }
+
+        // Gradient in [-1, 1) for a 1D lattice point. The 1D hash is a single multiply, which leaves neighbouring
+        // lattice points correlated in a seed dependent way, so it is mixed again before use
+        static float Gradient1D(int seed, int xPrimed) {
+            unsigned hash = (unsigned)Hash(seed, xPrimed);
+            hash ^= hash >> 16;
+            hash *= 0x7feb352du;
+            hash ^= hash >> 15;
+            hash *= 0x846ca68bu;
+            hash ^= hash >> 16;
+            return (int)hash * (1 / 2147483648.0f);
+        }
+
+        float GradCoord(int seed, int xPrimed, float xd) const { return xd * Gradient1D(seed, xPrimed); }
+
+        float GradCoord(int seed, int xPrimed, int yPrimed, float xd, float yd) const {
+            int hash = Hash(seed, xPrimed, yPrimed);
+            hash ^= hash >> 15;
+            hash &= 127 << 1;
+
+            float xg = Lookup<float>::Gradients2D[hash];
+            float yg = Lookup<float>::Gradients2D[hash | 1];
+
+            return xd * xg + yd * yg;
+        }
+
+        float GradCoord(int seed, int xPrimed, int yPrimed, int zPrimed, float xd, float yd, float zd) const {
+            int hash = Hash(seed, xPrimed, yPrimed, zPrimed);
+            hash ^= hash >> 15;
+            hash &= 63 << 2;
+
+            float xg = Lookup<float>::Gradients3D[hash];
+            float yg = Lookup<float>::Gradients3D[hash | 1];
+            float zg = Lookup<float>::Gradients3D[hash | 2];
+
+            return xd * xg + yd * yg + zd * zg;
+        }
+
+        float GradCoord(int seed, int xPrimed, int yPrimed, int zPrimed, int wPrimed, float xd, float yd, float zd,
+                        float wd) const {
+            int hash = Hash(seed, xPrimed, yPrimed, zPrimed, wPrimed);
+            hash ^= hash >> 15;
+            hash &= 31 << 2;
+
+            float xg = Lookup<float>::Gradients4D[hash];
+            float yg = Lookup<float>::Gradients4D[hash | 1];
+            float zg = Lookup<float>::Gradients4D[hash | 2];
+            float wg = Lookup<float>::Gradients4D[hash | 3];
+
+            return xd * xg + yd * yg + zd * zg + wd * wg;
+        }
+
+        void GradCoordOut(int seed, int xPrimed, int yPrimed, float &xo, float &yo) const {
+            int hash = Hash(seed, xPrimed, yPrimed) & (255 << 1);
+
+            xo = Lookup<float>::RandVecs2D[hash];
+            yo = Lookup<float>::RandVecs2D[hash | 1];
+        }
+
+        void GradCoordOut(int seed, int xPrimed, int yPrimed, int zPrimed, float &xo, float &yo, float &zo) const {
+            int hash = Hash(seed, xPrimed, yPrimed, zPrimed) & (255 << 2);
+
+            xo = Lookup<float>::RandVecs3D[hash];
+            yo = Lookup<float>::RandVecs3D[hash | 1];
+            zo = Lookup<float>::RandVecs3D[hash | 2];
+        }
+
+        void GradCoordDual(int seed, int xPrimed, int yPrimed, float xd, float yd, float &xo, float &yo) const {
+            int hash = Hash(seed, xPrimed, yPrimed);
+            int index1 = hash & (127 << 1);
+            int index2 = (hash >> 7) & (255 << 1);
+
+            float xg = Lookup<float>::Gradients2D[index1];
+            float yg = Lookup<float>::Gradients2D[index1 | 1];
+            float value = xd * xg + yd * yg;
+
+            float xgo = Lookup<float>::RandVecs2D[index2];
+            float ygo = Lookup<float>::RandVecs2D[index2 | 1];
+
+            xo = value * xgo;
+            yo = value * ygo;
+        }
+
+        void GradCoordDual(int seed, int xPrimed, int yPrimed, int zPrimed, float xd, float yd, float zd, float &xo,
+                           float &yo, float &zo) const {
+            int hash = Hash(seed, xPrimed, yPrimed, zPrimed);
+            int index1 = hash & (63 << 2);
+            int index2 = (hash >> 6) & (255 << 2);
+
+            float xg = Lookup<float>::Gradients3D[index1];
+            float yg = Lookup<float>::Gradients3D[index1 | 1];
+            float zg = Lookup<float>::Gradients3D[index1 | 2];
+            float value = xd * xg + yd * yg + zd * zg;
+
+            float xgo = Lookup<float>::RandVecs3D[index2];
+            float ygo = Lookup<float>::RandVecs3D[index2 | 1];
+            float zgo = Lookup<float>::RandVecs3D[index2 | 2];
+
+            xo = value * xgo;
+            yo = value * ygo;
+            zo = value * zgo;
+        }
+
+        // Generic noise gen
+
+        template <typename FNfloat> float GenNoiseSingle(int seed, FNfloat x) const {
+            switch (mNoiseType) {
+            case NoiseType_OpenSimplex2:
+            case NoiseType_OpenSimplex2S:
+            case NoiseType_Perlin:
+                return SinglePerlin(seed, x);
+            case NoiseType_ValueCubic:
+                return SingleValueCubic(seed, x);
+            case NoiseType_Value:
+                return SingleValue(seed, x);
+            default:
+                return 0;
+            }
+        }
+
+        template <typename FNfloat> float GenNoiseSingle(int seed, FNfloat x, FNfloat y) const {
+            switch (mNoiseType) {
+            case NoiseType_OpenSimplex2:
+                return SingleSimplex(seed, x, y);
+            case NoiseType_OpenSimplex2S:
+                return SingleOpenSimplex2S(seed, x, y);
+            case NoiseType_Cellular:
+                return SingleCellular(seed, x, y);
+            case NoiseType_Perlin:
+                return mApproximateMath ? SinglePerlinApprox(seed, x, y) : SinglePerlin(seed, x, y);
+            case NoiseType_ValueCubic:
+                return mApproximateMath ? SingleValueCubicApprox(seed, x, y) : SingleValueCubic(seed, x, y);
+            case NoiseType_Value:
+                return SingleValue(seed, x, y);
+            default:
+                return 0;
+            }
+        }
+
+        template <typename FNfloat> float GenNoiseSingle(int seed, FNfloat x, FNfloat y, FNfloat z) const {
+            switch (mNoiseType) {
+            case NoiseType_OpenSimplex2:
+                return SingleOpenSimplex2(seed, x, y, z);
+            case NoiseType_OpenSimplex2S:
+                return SingleOpenSimplex2S(seed, x, y, z);
+            case NoiseType_Cellular:
+                return SingleCellular(seed, x, y, z);
+            case NoiseType_Perlin:
+                return mApproximateMath ? SinglePerlinApprox(seed, x, y, z) : SinglePerlin(seed, x, y, z);
+            case NoiseType_ValueCubic:
+                return mApproximateMath ? SingleValueCubicApprox(seed, x, y, z) : SingleValueCubic(seed, x, y, z);
+            case NoiseType_Value:
+                return SingleValue(seed, x, y, z);
+            default:
+                return 0;
+            }
+        }
+
+        template <typename FNfloat> float GenNoiseSingle(int seed, FNfloat x, FNfloat y, FNfloat z, FNfloat w) const {
+            switch (mNoiseType) {
+            case NoiseType_OpenSimplex2:
+            case NoiseType_OpenSimplex2S:
+                return SingleOpenSimplex2(seed, x, y, z, w);
+            case NoiseType_Cellular:
+                return SingleCellular(seed, x, y, z, w);
+            case NoiseType_Perlin:
+                return SinglePerlin(seed, x, y, z, w);
+            case NoiseType_ValueCubic:
+            case NoiseType_Value:
+                return SingleValue(seed, x, y, z, w);
+            default:
+                return 0;
+            }
+        }
+
+        // Noise Coordinate Transforms (frequency, and possible skew or rotation)
+
+        template <typename FNfloat> void TransformNoiseCoordinate(FNfloat &x) const { x *= mFrequency; }
+
+        template <typename FNfloat> void TransformNoiseCoordinate(FNfloat &x, FNfloat &y) const {
+            x *= mFrequency;
+            y *= mFrequency;
+
+            switch (mNoiseType) {
+            case NoiseType_OpenSimplex2:
+            case NoiseType_OpenSimplex2S: {
+                const FNfloat SQRT3 = (FNfloat)1.7320508075688772935274463415059;
+                const FNfloat F2 = 0.5f * (SQRT3 - 1);
+                FNfloat t = (x + y) * F2;
+                x += t;
+                y += t;
+            } break;
+            default:
+                break;
+            }
+        }
+
+        template <typename FNfloat> void TransformNoiseCoordinate(FNfloat &x, FNfloat &y, FNfloat &z) const {
+            x *= mFrequency;
+            y *= mFrequency;
+            z *= mFrequency;
+
+            switch (mTransformType3D) {
+            case TransformType3D_ImproveXYPlanes: {
+                FNfloat xy = x + y;
+                FNfloat s2 = xy * -(FNfloat)0.211324865405187;
+                z *= (FNfloat)0.577350269189626;
+                x += s2 - z;
+                y = y + s2 - z;
+                z += xy * (FNfloat)0.577350269189626;
+            } break;
+            case TransformType3D_ImproveXZPlanes: {
+                FNfloat xz = x + z;
+                FNfloat s2 = xz * -(FNfloat)0.211324865405187;
+                y *= (FNfloat)0.577350269189626;
+                x += s2 - y;
+                z += s2 - y;
+                y += xz * (FNfloat)0.577350269189626;
+            } break;
+            case TransformType3D_DefaultOpenSimplex2: {
+                const FNfloat R3 = (FNfloat)(2.0 / 3.0);
+                FNfloat r = (x + y + z) * R3; // Rotation, not skew
+                x = r - x;
+                y = r - y;
+                z = r - z;
+            } break;
+            default:
+                break;
+            }
+        }
+
+        template <typename FNfloat>
+        void TransformNoiseCoordinate(FNfloat &x, FNfloat &y, FNfloat &z, FNfloat &w) const {
+            x *= mFrequency;
+            y *= mFrequency;
+            z *= mFrequency;
+            w *= mFrequency;
+
+            switch (mNoiseType) {
+            case NoiseType_OpenSimplex2:
+            case NoiseType_OpenSimplex2S: {
+                const FNfloat F4 = (FNfloat)-0.138196601125010515179541316563436; // (1 / sqrt(5) - 1) / 4
+                FNfloat s = (x + y + z + w) * F4;
+                x += s;
+                y += s;
+                z += s;
+                w += s;
+            } break;
+            default:
+                break;
+            }
+        }
+
+        void UpdateTransformType3D() {
+            switch (mRotationType3D) {
+            case RotationType3D_ImproveXYPlanes:
+                mTransformType3D = TransformType3D_ImproveXYPlanes;
+                break;
+            case RotationType3D_ImproveXZPlanes:
+                mTransformType3D = TransformType3D_ImproveXZPlanes;
+                break;
+            default:
+                switch (mNoiseType) {
+                case NoiseType_OpenSimplex2:
+                case NoiseType_OpenSimplex2S:
+                    mTransformType3D = TransformType3D_DefaultOpenSimplex2;
+                    break;
+                default:
+                    mTransformType3D = TransformType3D_None;
+                    break;
+                }
+                break;
+            }
+        }
+
+        // Cellular queries skip the noise type specific default rotation, only the user rotation applies
+
+        TransformType3D CellularTransformType3D() const {
+            switch (mRotationType3D) {
+            case RotationType3D_ImproveXYPlanes:
+                return TransformType3D_ImproveXYPlanes;
+            case RotationType3D_ImproveXZPlanes:
+                return TransformType3D_ImproveXZPlanes;
+            default:
+                return TransformType3D_None;
+            }
+        }
+
+        template <typename FNfloat>
+        static void RotateCoordinate3D(TransformType3D transformType, FNfloat &x, FNfloat &y, FNfloat &z) {
+            switch (transformType) {
+            case TransformType3D_ImproveXYPlanes: {
+                FNfloat xy = x + y;
+                FNfloat s2 = xy * -(FNfloat)0.211324865405187;
+                z *= (FNfloat)0.577350269189626;
+                x += s2 - z;
+                y = y + s2 - z;
+                z += xy * (FNfloat)0.577350269189626;
+            } break;
+            case TransformType3D_ImproveXZPlanes: {
+                FNfloat xz = x + z;
+                FNfloat s2 = xz * -(FNfloat)0.211324865405187;
+                y *= (FNfloat)0.577350269189626;
+                x += s2 - y;
+                z += s2 - y;
+                y += xz * (FNfloat)0.577350269189626;
+            } break;
+            case TransformType3D_DefaultOpenSimplex2: {
+                const FNfloat R3 = (FNfloat)(2.0 / 3.0);
+                FNfloat r = (x + y + z) * R3; // Rotation, not skew
+                x = r - x;
+                y = r - y;
+                z = r - z;
+            } break;
+            default:
+                break;
+            }
+        }
+
+        // All 3D transforms are orthonormal, so the inverse is the transposed matrix
+        template <typename FNfloat>
+        static void InverseRotateCoordinate3D(TransformType3D transformType, FNfloat &x, FNfloat &y, FNfloat &z) {
+            switch (transformType) {
+            case TransformType3D_ImproveXYPlanes: {
+                FNfloat xy = x + y;
+                FNfloat s2 = xy * -(FNfloat)0.211324865405187;
+                FNfloat zs = z * (FNfloat)0.577350269189626;
+                x += s2 + zs;
+                y += s2 + zs;
+                z = zs - xy * (FNfloat)0.577350269189626;
+            } break;
+            case TransformType3D_ImproveXZPlanes: {
+                FNfloat xz = x + z;
+                FNfloat s2 = xz * -(FNfloat)0.211324865405187;
+                FNfloat ys = y * (FNfloat)0.577350269189626;
+                x += s2 + ys;
+                z += s2 + ys;
+                y = ys - xz * (FNfloat)0.577350269189626;
+            } break;
+            case TransformType3D_DefaultOpenSimplex2:
+                RotateCoordinate3D(transformType, x, y, z);
+                break;
+            default:
+                break;
+            }
+        }
+
+        // Domain Warp Coordinate Transforms
+
+        template <typename FNfloat> void TransformDomainWarpCoordinate(FNfloat &x, FNfloat &y) const {
+            switch (mDomainWarpType) {
+            case DomainWarpType_OpenSimplex2:
+            case DomainWarpType_OpenSimplex2Reduced: {
+                const FNfloat SQRT3 = (FNfloat)1.7320508075688772935274463415059;
+                const FNfloat F2 = 0.5f * (SQRT3 - 1);
+                FNfloat t = (x + y) * F2;
+                x += t;
+                y += t;
+            } break;
+            default:
+                break;
+            }
+        }
+
+        template <typename FNfloat> void TransformDomainWarpCoordinate(FNfloat &x, FNfloat &y, FNfloat &z) const {
+            switch (mWarpTransformType3D) {
+            case TransformType3D_ImproveXYPlanes:
+                TransformDomainWarpCoordinate<TransformType3D_ImproveXYPlanes>(x, y, z);
+                break;
+            case TransformType3D_ImproveXZPlanes:
+                TransformDomainWarpCoordinate<TransformType3D_ImproveXZPlanes>(x, y, z);
+                break;
+            case TransformType3D_DefaultOpenSimplex2:
+                TransformDomainWarpCoordinate<TransformType3D_DefaultOpenSimplex2>(x, y, z);
+                break;
+            default:
+                break;
+            }
+        }
+
+        template <TransformType3D Transform, typename FNfloat>
+        static void TransformDomainWarpCoordinate(FNfloat &x, FNfloat &y, FNfloat &z) {
+            switch (Transform) {
+            case TransformType3D_ImproveXYPlanes: {
+                FNfloat xy = x + y;
+                FNfloat s2 = xy * -(FNfloat)0.211324865405187;
+                z *= (FNfloat)0.577350269189626;
+                x += s2 - z;
+                y = y + s2 - z;
+                z += xy * (FNfloat)0.577350269189626;
+            } break;
+            case TransformType3D_ImproveXZPlanes: {
+                FNfloat xz = x + z;
+                FNfloat s2 = xz * -(FNfloat)0.211324865405187;
+                y *= (FNfloat)0.577350269189626;
+                x += s2 - y;
+                z += s2 - y;
+                y += xz * (FNfloat)0.577350269189626;
+            } break;
+            case TransformType3D_DefaultOpenSimplex2: {
+                const FNfloat R3 = (FNfloat)(2.0 / 3.0);
+                FNfloat r = (x + y + z) * R3; // Rotation, not skew
+                x = r - x;
+                y = r - y;
+                z = r - z;
+            } break;
+            default:
+                break;
+            }
+        }
+
+        void UpdateWarpTransformType3D() {
+            switch (mRotationType3D) {
+            case RotationType3D_ImproveXYPlanes:
+                mWarpTransformType3D = TransformType3D_ImproveXYPlanes;
+                break;
+            case RotationType3D_ImproveXZPlanes:
+                mWarpTransformType3D = TransformType3D_ImproveXZPlanes;
+                break;
+            default:
+                switch (mDomainWarpType) {
+                case DomainWarpType_OpenSimplex2:
+                case DomainWarpType_OpenSimplex2Reduced:
+                    mWarpTransformType3D = TransformType3D_DefaultOpenSimplex2;
+                    break;
+                default:
+                    mWarpTransformType3D = TransformType3D_None;
+                    break;
+                }
+                break;
+            }
+        }
+
+        // Octave Lanes
+        // Without octave weighting, FBm octaves (and independent domain warp octaves) only differ by seed, frequency
+        // and amplitude. A single position is then evaluated as a short span of octave lanes with the noise type
+        // switch taken once per span, then reduced in octave order so results match the sequential loop exactly.
+
+        static const int OctaveLanes = 8;
+
+        template <typename FNfloat>
+        void GenNoiseLanes(int seed, const FNfloat *xs, const FNfloat *ys, float *out, int count) const {
+            switch (mNoiseType) {
+            case NoiseType_OpenSimplex2:
+                for (int i = 0; i < count; i++)
+                    out[i] = SingleSimplex(seed + i, xs[i], ys[i]);
+                break;
+            case NoiseType_OpenSimplex2S:
+                for (int i = 0; i < count; i++)
+                    out[i] = SingleOpenSimplex2S(seed + i, xs[i], ys[i]);
+                break;
+            case NoiseType_Cellular:
+                for (int i = 0; i < count; i++)
+                    out[i] = SingleCellular(seed + i, xs[i], ys[i]);
+                break;
+            case NoiseType_Perlin:
+                if (mApproximateMath) {
+                    for (int i = 0; i < count; i++)
+                        out[i] = SinglePerlinApprox(seed + i, xs[i], ys[i]);
+                } else {
+                    for (int i = 0; i < count; i++)
+                        out[i] = SinglePerlin(seed + i, xs[i], ys[i]);
+                }
+                break;
+            case NoiseType_ValueCubic:
+                if (mApproximateMath) {
+                    for (int i = 0; i < count; i++)
+                        out[i] = SingleValueCubicApprox(seed + i, xs[i], ys[i]);
+                } else {
+                    for (int i = 0; i < count; i++)
+                        out[i] = SingleValueCubic(seed + i, xs[i], ys[i]);
+                }
+                break;
+            case NoiseType_Value:
+                for (int i = 0; i < count; i++)
+                    out[i] = SingleValue(seed + i, xs[i], ys[i]);
+                break;
+            default:
+                for (int i = 0; i < count; i++)
+                    out[i] = 0;
+                break;
+            }
+        }
+
+        template <typename FNfloat>
+        void GenNoiseLanes(int seed, const FNfloat *xs, const FNfloat *ys, const FNfloat *zs, float *out,
+                           int count) const {
+            switch (mNoiseType) {
+            case NoiseType_OpenSimplex2:
+                for (int i = 0; i < count; i++)
+                    out[i] = SingleOpenSimplex2(seed + i, xs[i], ys[i], zs[i]);
+                break;
+            case NoiseType_OpenSimplex2S:
+                for (int i = 0; i < count; i++)
+                    out[i] = SingleOpenSimplex2S(seed + i, xs[i], ys[i], zs[i]);
+                break;
+            case NoiseType_Cellular:
+                for (int i = 0; i < count; i++)
+                    out[i] = SingleCellular(seed + i, xs[i], ys[i], zs[i]);
+                break;
+            case NoiseType_Perlin:
+                if (mApproximateMath) {
+                    for (int i = 0; i < count; i++)
+                        out[i] = SinglePerlinApprox(seed + i, xs[i], ys[i], zs[i]);
+                } else {
+                    for (int i = 0; i < count; i++)
+                        out[i] = SinglePerlin(seed + i, xs[i], ys[i], zs[i]);
+                }
+                break;
+            case NoiseType_ValueCubic:
+                if (mApproximateMath) {
+                    for (int i = 0; i < count; i++)
+                        out[i] = SingleValueCubicApprox(seed + i, xs[i], ys[i], zs[i]);
+                } else {
+                    for (int i = 0; i < count; i++)
+                        out[i] = SingleValueCubic(seed + i, xs[i], ys[i], zs[i]);
+                }
+                break;
+            case NoiseType_Value:
+                for (int i = 0; i < count; i++)
+                    out[i] = SingleValue(seed + i, xs[i], ys[i], zs[i]);
+                break;
+            default:
+                for (int i = 0; i < count; i++)
+                    out[i] = 0;
+                break;
+            }
+        }
+
+        template <typename FNfloat> float GenFractalFBmLanes(FNfloat x, FNfloat y) const {
+            FNfloat xs[OctaveLanes];
+            FNfloat ys[OctaveLanes];
+            float noise[OctaveLanes];
+
+            int seed = mSeed;
+            float sum = 0;
+            float amp = mFractalBounding;
+
+            for (int o = 0; o < mNoiseOctaves; o += OctaveLanes) {
+                int count = mNoiseOctaves - o < OctaveLanes ? mNoiseOctaves - o : OctaveLanes;
+
+                for (int i = 0; i < count; i++) {
+                    xs[i] = x;
+                    ys[i] = y;
+                    x *= mLacunarity;
+                    y *= mLacunarity;
+                }
+                GenNoiseLanes(seed, xs, ys, noise, count);
+                seed += count;
+
+                for (int i = 0; i < count; i++) {
+                    sum += noise[i] * amp;
+                    amp *= mGain;
+                }
+            }
+
+            return sum;
+        }
+
+        template <typename FNfloat> float GenFractalFBmLanes(FNfloat x, FNfloat y, FNfloat z) const {
+            FNfloat xs[OctaveLanes];
+            FNfloat ys[OctaveLanes];
+            FNfloat zs[OctaveLanes];
+            float noise[OctaveLanes];
+
+            int seed = mSeed;
+            float sum = 0;
+            float amp = mFractalBounding;
+
+            for (int o = 0; o < mNoiseOctaves; o += OctaveLanes) {
+                int count = mNoiseOctaves - o < OctaveLanes ? mNoiseOctaves - o : OctaveLanes;
+
+                for (int i = 0; i < count; i++) {
+                    xs[i] = x;
+                    ys[i] = y;
+                    zs[i] = z;
+                    x *= mLacunarity;
+                    y *= mLacunarity;
+                    z *= mLacunarity;
+                }
+                GenNoiseLanes(seed, xs, ys, zs, noise, count);
+                seed += count;
+
+                for (int i = 0; i < count; i++) {
+                    sum += noise[i] * amp;
+                    amp *= mGain;
+                }
+            }
+
+            return sum;
+        }
+
+        // Seed Ensembles
+        // Every seed sees the same transformed position, and fractal octaves only offset the seeds. Each octave is one
+        // pass over seed lanes with the noise type switch taken once. Lanes keep their own octave weighting and match
+        // the per seed fractal loops exactly.
+
+        template <typename FNfloat>
+        void GenNoiseSeeds(const int *seeds, int seedOffset, FNfloat x, FNfloat y, float *out, int count) const {
+            switch (mNoiseType) {
+            case NoiseType_OpenSimplex2:
+                for (int i = 0; i < count; i++)
+                    out[i] = SingleSimplex(seeds[i] + seedOffset, x, y);
+                break;
+            case NoiseType_OpenSimplex2S:
+                for (int i = 0; i < count; i++)
+                    out[i] = SingleOpenSimplex2S(seeds[i] + seedOffset, x, y);
+                break;
+            case NoiseType_Cellular:
+                for (int i = 0; i < count; i++)
+                    out[i] = SingleCellular(seeds[i] + seedOffset, x, y);
+                break;
+            case NoiseType_Perlin:
+                if (mApproximateMath) {
+                    for (int i = 0; i < count; i++)
+                        out[i] = SinglePerlinApprox(seeds[i] + seedOffset, x, y);
+                } else
+                    SeedsPerlin(seeds, seedOffset, x, y, out, count);
+                break;
+            case NoiseType_ValueCubic:
+                if (mApproximateMath) {
+                    for (int i = 0; i < count; i++)
+                        out[i] = SingleValueCubicApprox(seeds[i] + seedOffset, x, y);
+                } else
+                    SeedsValueCubic(seeds, seedOffset, x, y, out, count);
+                break;
+            case NoiseType_Value:
+                SeedsValue(seeds, seedOffset, x, y, out, count);
+                break;
+            default:
+                for (int i = 0; i < count; i++)
+                    out[i] = 0;
+                break;
+            }
+        }
+
+        template <typename FNfloat>
+        void GenNoiseSeeds(const int *seeds, int seedOffset, FNfloat x, FNfloat y, FNfloat z, float *out,
+                           int count) const {
+            switch (mNoiseType) {
+            case NoiseType_OpenSimplex2:
+                for (int i = 0; i < count; i++)
+                    out[i] = SingleOpenSimplex2(seeds[i] + seedOffset, x, y, z);
+                break;
+            case NoiseType_OpenSimplex2S:
+                for (int i = 0; i < count; i++)
+                    out[i] = SingleOpenSimplex2S(seeds[i] + seedOffset, x, y, z);
+                break;
+            case NoiseType_Cellular:
+                for (int i = 0; i < count; i++)
+                    out[i] = SingleCellular(seeds[i] + seedOffset, x, y, z);
+                break;
+            case NoiseType_Perlin:
+                if (mApproximateMath) {
+                    for (int i = 0; i < count; i++)
+                        out[i] = SinglePerlinApprox(seeds[i] + seedOffset, x, y, z);
+                } else
+                    SeedsPerlin(seeds, seedOffset, x, y, z, out, count);
+                break;
+            case NoiseType_ValueCubic:
+                if (mApproximateMath) {
+                    for (int i = 0; i < count; i++)
+                        out[i] = SingleValueCubicApprox(seeds[i] + seedOffset, x, y, z);
+                } else
+                    SeedsValueCubic(seeds, seedOffset, x, y, z, out, count);
+                break;
+            case NoiseType_Value:
+                SeedsValue(seeds, seedOffset, x, y, z, out, count);
+                break;
+            default:
+                for (int i = 0; i < count; i++)
+                    out[i] = 0;
+                break;
+            }
+        }
+
+        template <typename FNfloat>
+        void GenFractalSeeds(const int *seeds, FNfloat x, FNfloat y, float *out, int count) const {
+            if (mFractalType != FractalType_FBm && mFractalType != FractalType_Ridged &&
+                mFractalType != FractalType_PingPong) {
+                GenNoiseSeeds(seeds, 0, x, y, out, count);
+                return;
+            }
+
+            float amp[BatchSize];
+            float noise[BatchSize];
+
+            for (int i = 0; i < count; i++) {
+                out[i] = 0;
+                amp[i] = mFractalBounding;
+            }
+
+            for (int o = 0; o < mNoiseOctaves; o++) {
+                GenNoiseSeeds(seeds, o, x, y, noise, count);
+
+                switch (mFractalType) {
+                default:
+                case FractalType_FBm:
+                    for (int i = 0; i < count; i++) {
+                        out[i] += noise[i] * amp[i];
+                        amp[i] *= Lerp(1.0f, FastMin(noise[i] + 1, 2) * 0.5f, mWeightedStrength);
+                    }
+                    break;
+                case FractalType_Ridged:
+                    for (int i = 0; i < count; i++) {
+                        float n = FastAbs(noise[i]);
+                        out[i] += (n * -2 + 1) * amp[i];
+                        amp[i] *= Lerp(1.0f, 1 - n, mWeightedStrength);
+                    }
+                    break;
+                case FractalType_PingPong:
+                    for (int i = 0; i < count; i++) {
+                        float n = PingPong((noise[i] + 1) * mPingPongStrength);
+                        out[i] += (n - 0.5f) * 2 * amp[i];
+                        amp[i] *= Lerp(1.0f, n, mWeightedStrength);
+                    }
+                    break;
+                }
+
+                for (int i = 0; i < count; i++) {
+                    amp[i] *= mGain;
+                }
+                x *= mLacunarity;
+                y *= mLacunarity;
+            }
+        }
+
+        template <typename FNfloat>
+        void GenFractalSeeds(const int *seeds, FNfloat x, FNfloat y, FNfloat z, float *out, int count) const {
+            if (mFractalType != FractalType_FBm && mFractalType != FractalType_Ridged &&
+                mFractalType != FractalType_PingPong) {
+                GenNoiseSeeds(seeds, 0, x, y, z, out, count);
+                return;
+            }
+
+            float amp[BatchSize];
+            float noise[BatchSize];
+
+            for (int i = 0; i < count; i++) {
+                out[i] = 0;
+                amp[i] = mFractalBounding;
+            }
+
+            for (int o = 0; o < mNoiseOctaves; o++) {
+                GenNoiseSeeds(seeds, o, x, y, z, noise, count);
+
+                switch (mFractalType) {
+                default:
+                case FractalType_FBm:
+                    for (int i = 0; i < count; i++) {
+                        out[i] += noise[i] * amp[i];
+                        amp[i] *= Lerp(1.0f, (noise[i] + 1) * 0.5f, mWeightedStrength);
+                    }
+                    break;
+                case FractalType_Ridged:
+                    for (int i = 0; i < count; i++) {
+                        float n = FastAbs(noise[i]);
+                        out[i] += (n * -2 + 1) * amp[i];
+                        amp[i] *= Lerp(1.0f, 1 - n, mWeightedStrength);
+                    }
+                    break;
+                case FractalType_PingPong:
+                    for (int i = 0; i < count; i++) {
+                        float n = PingPong((noise[i] + 1) * mPingPongStrength);
+                        out[i] += (n - 0.5f) * 2 * amp[i];
+                        amp[i] *= Lerp(1.0f, n, mWeightedStrength);
+                    }
+                    break;
+                }
+
+                for (int i = 0; i < count; i++) {
+                    amp[i] *= mGain;
+                }
+                x *= mLacunarity;
+                y *= mLacunarity;
+                z *= mLacunarity;
+            }
+        }
+
+        // Value, ValueCubic and Perlin lanes compute the cell, fractions and interpolation weights once, the loop over
+        // seeds is then only hashing and interpolation. Arithmetic matches the Single kernels.
+
+        template <typename FNfloat>
+        void SeedsValue(const int *seeds, int seedOffset, FNfloat x, FNfloat y, float *out, int count) const {
+            int x0 = FastFloor(x);
+            int y0 = FastFloor(y);
+
+            float xs = InterpHermite((float)(x - x0));
+            float ys = InterpHermite((float)(y - y0));
+
+            x0 *= PrimeX;
+            y0 *= PrimeY;
+            int x1 = x0 + PrimeX;
+            int y1 = y0 + PrimeY;
+
+            for (int i = 0; i < count; i++) {
+                int seed = seeds[i] + seedOffset;
+                float xf0 = Lerp(ValCoord(seed, x0, y0), ValCoord(seed, x1, y0), xs);
+                float xf1 = Lerp(ValCoord(seed, x0, y1), ValCoord(seed, x1, y1), xs);
+
+                out[i] = Lerp(xf0, xf1, ys);
+            }
+        }
+
+        template <typename FNfloat>
+        void SeedsValue(const int *seeds, int seedOffset, FNfloat x, FNfloat y, FNfloat z, float *out,
+                        int count) const {
+            int x0 = FastFloor(x);
+            int y0 = FastFloor(y);
+            int z0 = FastFloor(z);
+
+            float xs = InterpHermite((float)(x - x0));
+            float ys = InterpHermite((float)(y - y0));
+            float zs = InterpHermite((float)(z - z0));
+
+            x0 *= PrimeX;
+            y0 *= PrimeY;
+            z0 *= PrimeZ;
+            int x1 = x0 + PrimeX;
+            int y1 = y0 + PrimeY;
+            int z1 = z0 + PrimeZ;
+
+            for (int i = 0; i < count; i++) {
+                int seed = seeds[i] + seedOffset;
+                float xf00 = Lerp(ValCoord(seed, x0, y0, z0), ValCoord(seed, x1, y0, z0), xs);
+                float xf10 = Lerp(ValCoord(seed, x0, y1, z0), ValCoord(seed, x1, y1, z0), xs);
+                float xf01 = Lerp(ValCoord(seed, x0, y0, z1), ValCoord(seed, x1, y0, z1), xs);
+                float xf11 = Lerp(ValCoord(seed, x0, y1, z1), ValCoord(seed, x1, y1, z1), xs);
+
+                float yf0 = Lerp(xf00, xf10, ys);
+                float yf1 = Lerp(xf01, xf11, ys);
+
+                out[i] = Lerp(yf0, yf1, zs);
+            }
+        }
+
+        template <typename FNfloat>
+        void SeedsPerlin(const int *seeds, int seedOffset, FNfloat x, FNfloat y, float *out, int count) const {
+            int x0 = FastFloor(x);
+            int y0 = FastFloor(y);
+
+            float xd0 = (float)(x - x0);
+            float yd0 = (float)(y - y0);
+            float xd1 = xd0 - 1;
+            float yd1 = yd0 - 1;
+
+            float xs = InterpQuintic(xd0);
+            float ys = InterpQuintic(yd0);
+
+            x0 *= PrimeX;
+            y0 *= PrimeY;
+            int x1 = x0 + PrimeX;
+            int y1 = y0 + PrimeY;
+
+            for (int i = 0; i < count; i++) {
+                int seed = seeds[i] + seedOffset;
+                float xf0 = Lerp(GradCoord(seed, x0, y0, xd0, yd0), GradCoord(seed, x1, y0, xd1, yd0), xs);
+                float xf1 = Lerp(GradCoord(seed, x0, y1, xd0, yd1), GradCoord(seed, x1, y1, xd1, yd1), xs);
+
+                out[i] = Lerp(xf0, xf1, ys) * 1.4247691104677813f;
+            }
+        }
+
+        template <typename FNfloat>
+        void SeedsPerlin(const int *seeds, int seedOffset, FNfloat x, FNfloat y, FNfloat z, float *out,
+                         int count) const {
+            int x0 = FastFloor(x);
+            int y0 = FastFloor(y);
+            int z0 = FastFloor(z);
+
+            float xd0 = (float)(x - x0);
+            float yd0 = (float)(y - y0);
+            float zd0 = (float)(z - z0);
+            float xd1 = xd0 - 1;
+            float yd1 = yd0 - 1;
+            float zd1 = zd0 - 1;
+
+            float xs = InterpQuintic(xd0);
+            float ys = InterpQuintic(yd0);
+            float zs = InterpQuintic(zd0);
+
+            x0 *= PrimeX;
+            y0 *= PrimeY;
+            z0 *= PrimeZ;
+            int x1 = x0 + PrimeX;
+            int y1 = y0 + PrimeY;
+            int z1 = z0 + PrimeZ;
+
+            for (int i = 0; i < count; i++) {
+                int seed = seeds[i] + seedOffset;
+                float xf00 =
+                    Lerp(GradCoord(seed, x0, y0, z0, xd0, yd0, zd0), GradCoord(seed, x1, y0, z0, xd1, yd0, zd0), xs);
+                float xf10 =
+                    Lerp(GradCoord(seed, x0, y1, z0, xd0, yd1, zd0), GradCoord(seed, x1, y1, z0, xd1, yd1, zd0), xs);
+                float xf01 =
+                    Lerp(GradCoord(seed, x0, y0, z1, xd0, yd0, zd1), GradCoord(seed, x1, y0, z1, xd1, yd0, zd1), xs);
+                float xf11 =
+                    Lerp(GradCoord(seed, x0, y1, z1, xd0, yd1, zd1), GradCoord(seed, x1, y1, z1, xd1, yd1, zd1), xs);
+
+                float yf0 = Lerp(xf00, xf10, ys);
+                float yf1 = Lerp(xf01, xf11, ys);
+
+                out[i] = Lerp(yf0, yf1, zs) * 0.964921414852142333984375f;
+            }
+        }
+
+        template <typename FNfloat>
+        void SeedsValueCubic(const int *seeds, int seedOffset, FNfloat x, FNfloat y, float *out, int count) const {
+            int x1 = FastFloor(x);
+            int y1 = FastFloor(y);
+
+            float xs = (float)(x - x1);
+            float ys = (float)(y - y1);
+
+            x1 *= PrimeX;
+            y1 *= PrimeY;
+            int x0 = x1 - PrimeX;
+            int y0 = y1 - PrimeY;
+            int x2 = x1 + PrimeX;
+            int y2 = y1 + PrimeY;
+            int x3 = x1 + (int)((long)PrimeX << 1);
+            int y3 = y1 + (int)((long)PrimeY << 1);
+
+            for (int i = 0; i < count; i++) {
+                int seed = seeds[i] + seedOffset;
+
+                out[i] = CubicLerp(CubicLerp(ValCoord(seed, x0, y0), ValCoord(seed, x1, y0), ValCoord(seed, x2, y0),
+                                             ValCoord(seed, x3, y0), xs),
+                                   CubicLerp(ValCoord(seed, x0, y1), ValCoord(seed, x1, y1), ValCoord(seed, x2, y1),
+                                             ValCoord(seed, x3, y1), xs),
+                                   CubicLerp(ValCoord(seed, x0, y2), ValCoord(seed, x1, y2), ValCoord(seed, x2, y2),
+                                             ValCoord(seed, x3, y2), xs),
+                                   CubicLerp(ValCoord(seed, x0, y3), ValCoord(seed, x1, y3), ValCoord(seed, x2, y3),
+                                             ValCoord(seed, x3, y3), xs),
+                                   ys) *
+                         (1 / (1.5f * 1.5f));
+            }
+        }
+
+        template <typename FNfloat>
+        void SeedsValueCubic(const int *seeds, int seedOffset, FNfloat x, FNfloat y, FNfloat z, float *out,
+                             int count) const {
+            int x1 = FastFloor(x);
+            int y1 = FastFloor(y);
+            int z1 = FastFloor(z);
+
+            float xs = (float)(x - x1);
+            float ys = (float)(y - y1);
+            float zs = (float)(z - z1);
+
+            x1 *= PrimeX;
+            y1 *= PrimeY;
+            z1 *= PrimeZ;
+
+            int x0 = x1 - PrimeX;
+            int y0 = y1 - PrimeY;
+            int z0 = z1 - PrimeZ;
+            int x2 = x1 + PrimeX;
+            int y2 = y1 + PrimeY;
+            int z2 = z1 + PrimeZ;
+            int x3 = x1 + (int)((long)PrimeX << 1);
+            int y3 = y1 + (int)((long)PrimeY << 1);
+            int z3 = z1 + (int)((long)PrimeZ << 1);
+
+            for (int i = 0; i < count; i++) {
+                int seed = seeds[i] + seedOffset;
+
+                out[i] = CubicLerp(CubicLerp(CubicLerp(ValCoord(seed, x0, y0, z0), ValCoord(seed, x1, y0, z0),
+                                                       ValCoord(seed, x2, y0, z0), ValCoord(seed, x3, y0, z0), xs),
+                                             CubicLerp(ValCoord(seed, x0, y1, z0), ValCoord(seed, x1, y1, z0),
+                                                       ValCoord(seed, x2, y1, z0), ValCoord(seed, x3, y1, z0), xs),
+                                             CubicLerp(ValCoord(seed, x0, y2, z0), ValCoord(seed, x1, y2, z0),
+                                                       ValCoord(seed, x2, y2, z0), ValCoord(seed, x3, y2, z0), xs),
+                                             CubicLerp(ValCoord(seed, x0, y3, z0), ValCoord(seed, x1, y3, z0),
+                                                       ValCoord(seed, x2, y3, z0), ValCoord(seed, x3, y3, z0), xs),
+                                             ys),
+                                   CubicLerp(CubicLerp(ValCoord(seed, x0, y0, z1), ValCoord(seed, x1, y0, z1),
+                                                       ValCoord(seed, x2, y0, z1), ValCoord(seed, x3, y0, z1), xs),
+                                             CubicLerp(ValCoord(seed, x0, y1, z1), ValCoord(seed, x1, y1, z1),
+                                                       ValCoord(seed, x2, y1, z1), ValCoord(seed, x3, y1, z1), xs),
+                                             CubicLerp(ValCoord(seed, x0, y2, z1), ValCoord(seed, x1, y2, z1),
+                                                       ValCoord(seed, x2, y2, z1), ValCoord(seed, x3, y2, z1), xs),
+                                             CubicLerp(ValCoord(seed, x0, y3, z1), ValCoord(seed, x1, y3, z1),
+                                                       ValCoord(seed, x2, y3, z1), ValCoord(seed, x3, y3, z1), xs),
+                                             ys),
+                                   CubicLerp(CubicLerp(ValCoord(seed, x0, y0, z2), ValCoord(seed, x1, y0, z2),
+                                                       ValCoord(seed, x2, y0, z2), ValCoord(seed, x3, y0, z2), xs),
+                                             CubicLerp(ValCoord(seed, x0, y1, z2), ValCoord(seed, x1, y1, z2),
+                                                       ValCoord(seed, x2, y1, z2), ValCoord(seed, x3, y1, z2), xs),
+                                             CubicLerp(ValCoord(seed, x0, y2, z2), ValCoord(seed, x1, y2, z2),
+                                                       ValCoord(seed, x2, y2, z2), ValCoord(seed, x3, y2, z2), xs),
+                                             CubicLerp(ValCoord(seed, x0, y3, z2), ValCoord(seed, x1, y3, z2),
+                                                       ValCoord(seed, x2, y3, z2), ValCoord(seed, x3, y3, z2), xs),
+                                             ys),
+                                   CubicLerp(CubicLerp(ValCoord(seed, x0, y0, z3), ValCoord(seed, x1, y0, z3),
+                                                       ValCoord(seed, x2, y0, z3), ValCoord(seed, x3, y0, z3), xs),
+                                             CubicLerp(ValCoord(seed, x0, y1, z3), ValCoord(seed, x1, y1, z3),
+                                                       ValCoord(seed, x2, y1, z3), ValCoord(seed, x3, y1, z3), xs),
+                                             CubicLerp(ValCoord(seed, x0, y2, z3), ValCoord(seed, x1, y2, z3),
+                                                       ValCoord(seed, x2, y2, z3), ValCoord(seed, x3, y2, z3), xs),
+                                             CubicLerp(ValCoord(seed, x0, y3, z3), ValCoord(seed, x1, y3, z3),
+                                                       ValCoord(seed, x2, y3, z3), ValCoord(seed, x3, y3, z3), xs),
+                                             ys),
+                                   zs) *
+                         (1 / (1.5f * 1.5f * 1.5f));
+            }
+        }
+
+        // Threshold Queries
+        // Octave terms of FBm, Ridged and PingPong lie within -amp...amp, and octave weighting only scales the next
+        // amplitude by 0...1. The amplitudes still to come therefore bound how far the sum can move, with a little
+        // slack for noise rounding slightly past 1. Octaves are accumulated in the same order as
+        // the fractal loops, so a query that runs to the end compares exactly the value GetNoise returns.
+
+        bool HasThresholdBound() const {
+            if (mWeightedStrength < 0 || mWeightedStrength > 1)
+                return false;
+            return mNoiseType != NoiseType_Cellular || mCellularReturnType == CellularReturnType_CellValue;
+        }
+
+        // Sum of the unweighted amplitudes of octaves after the first, with slack
+        float ThresholdRemaining() const {
+            if (!HasThresholdBound())
+                return 1e30f;
+
+            float remaining = 0;
+            float amp = mFractalBounding;
+            for (int i = 1; i < mNoiseOctaves; i++) {
+                amp *= mGain;
+                remaining += FastAbs(amp);
+            }
+            return remaining * 1.01f + 1e-6f;
+        }
+
+        template <typename FNfloat> bool GenFractalIsAbove(FNfloat x, FNfloat y, float threshold) const {
+            if (mFractalType != FractalType_FBm && mFractalType != FractalType_Ridged &&
+                mFractalType != FractalType_PingPong) {
+                ENTROPY_THRESHOLD_OCTAVE();
+                return GenNoiseSingle(mSeed, x, y) > threshold;
+            }
+
+            int seed = mSeed;
+            float sum = 0;
+            float amp = mFractalBounding;
+            float remaining = ThresholdRemaining();
+            float unweighted = mFractalBounding;
+
+            for (int i = 0; i < mNoiseOctaves; i++) {
+                ENTROPY_THRESHOLD_OCTAVE();
+                float noise = GenNoiseSingle(seed++, x, y);
+
+                switch (mFractalType) {
+                default:
+                case FractalType_FBm:
+                    sum += noise * amp;
+                    amp *= Lerp(1.0f, FastMin(noise + 1, 2) * 0.5f, mWeightedStrength);
+                    break;
+                case FractalType_Ridged:
+                    noise = FastAbs(noise);
+                    sum += (noise * -2 + 1) * amp;
+                    amp *= Lerp(1.0f, 1 - noise, mWeightedStrength);
+                    break;
+                case FractalType_PingPong:
+                    noise = PingPong((noise + 1) * mPingPongStrength);
+                    sum += (noise - 0.5f) * 2 * amp;
+                    amp *= Lerp(1.0f, noise, mWeightedStrength);
+                    break;
+                }
+
+                if (FastAbs(sum - threshold) > remaining)
+                    return sum > threshold;
+
+                x *= mLacunarity;
+                y *= mLacunarity;
+                amp *= mGain;
+                unweighted *= mGain;
+                remaining -= FastAbs(unweighted) * 1.01f;
+            }
+
+            return sum > threshold;
+        }
+
+        template <typename FNfloat> bool GenFractalIsAbove(FNfloat x, FNfloat y, FNfloat z, float threshold) const {
+            if (mFractalType != FractalType_FBm && mFractalType != FractalType_Ridged &&
+                mFractalType != FractalType_PingPong) {
+                ENTROPY_THRESHOLD_OCTAVE();
+                return GenNoiseSingle(mSeed, x, y, z) > threshold;
+            }
+
+            int seed = mSeed;
+            float sum = 0;
+            float amp = mFractalBounding;
+            float remaining = ThresholdRemaining();
+            float unweighted = mFractalBounding;
+
+            for (int i = 0; i < mNoiseOctaves; i++) {
+                ENTROPY_THRESHOLD_OCTAVE();
+                float noise = GenNoiseSingle(seed++, x, y, z);
+
+                switch (mFractalType) {
+                default:
+                case FractalType_FBm:
+                    sum += noise * amp;
+                    amp *= Lerp(1.0f, (noise + 1) * 0.5f, mWeightedStrength);
+                    break;
+                case FractalType_Ridged:
+                    noise = FastAbs(noise);
+                    sum += (noise * -2 + 1) * amp;
+                    amp *= Lerp(1.0f, 1 - noise, mWeightedStrength);
+                    break;
+                case FractalType_PingPong:
+                    noise = PingPong((noise + 1) * mPingPongStrength);
+                    sum += (noise - 0.5f) * 2 * amp;
+                    amp *= Lerp(1.0f, noise, mWeightedStrength);
+                    break;
+                }
+
+                if (FastAbs(sum - threshold) > remaining)
+                    return sum > threshold;
+
+                x *= mLacunarity;
+                y *= mLacunarity;
+                z *= mLacunarity;
+                amp *= mGain;
+                unweighted *= mGain;
+                remaining -= FastAbs(unweighted) * 1.01f;
+            }
+
+            return sum > threshold;
+        }
+
+        // Fractal FBm
+
+        template <typename FNfloat> float GenFractalFBm(FNfloat x) const {
+            int seed = mSeed;
+            float sum = 0;
+            float amp = mFractalBounding;
+
+            for (int i = 0; i < mNoiseOctaves; i++) {
+                float noise = GenNoiseSingle(seed++, x);
+                sum += noise * amp;
+                amp *= Lerp(1.0f, (noise + 1) * 0.5f, mWeightedStrength);
+
+                x *= mLacunarity;
+                amp *= mGain;
+            }
+
+            return sum;
+        }
+
+        template <typename FNfloat> float GenFractalFBm(FNfloat x, FNfloat y) const {
+            if (mWeightedStrength == 0)
+                return GenFractalFBmLanes(x, y);
+
+            int seed = mSeed;
+            float sum = 0;
+            float amp = mFractalBounding;
+
+            for (int i = 0; i < mNoiseOctaves; i++) {
+                float noise = GenNoiseSingle(seed++, x, y);
+                sum += noise * amp;
+                amp *= Lerp(1.0f, FastMin(noise + 1, 2) * 0.5f, mWeightedStrength);
+
+                x *= mLacunarity;
+                y *= mLacunarity;
+                amp *= mGain;
+            }
+
+            return sum;
+        }
+
+        template <typename FNfloat> float GenFractalFBm(FNfloat x, FNfloat y, FNfloat z) const {
+            if (mWeightedStrength == 0)
+                return GenFractalFBmLanes(x, y, z);
+
+            int seed = mSeed;
+            float sum = 0;
+            float amp = mFractalBounding;
+
+            for (int i = 0; i < mNoiseOctaves; i++) {
+                float noise = GenNoiseSingle(seed++, x, y, z);
+                sum += noise * amp;
+                amp *= Lerp(1.0f, (noise + 1) * 0.5f, mWeightedStrength);
+
+                x *= mLacunarity;
+                y *= mLacunarity;
+                z *= mLacunarity;
+                amp *= mGain;
+            }
+
+            return sum;
+        }
+
+        template <typename FNfloat> float GenFractalFBm(FNfloat x, FNfloat y, FNfloat z, FNfloat w) const {
+            int seed = mSeed;
+            float sum = 0;
+            float amp = mFractalBounding;
+
+            for (int i = 0; i < mNoiseOctaves; i++) {
+                float noise = GenNoiseSingle(seed++, x, y, z, w);
+                sum += noise * amp;
+                amp *= Lerp(1.0f, (noise + 1) * 0.5f, mWeightedStrength);
+
+                x *= mLacunarity;
+                y *= mLacunarity;
+                z *= mLacunarity;
+                w *= mLacunarity;
+                amp *= mGain;
+            }
+
+            return sum;
+        }
+
+        // Fractal Ridged
+
+        template <typename FNfloat> float GenFractalRidged(FNfloat x) const {
+            int seed = mSeed;
+            float sum = 0;
+            float amp = mFractalBounding;
+
+            for (int i = 0; i < mNoiseOctaves; i++) {
+                float noise = FastAbs(GenNoiseSingle(seed++, x));
+                sum += (noise * -2 + 1) * amp;
+                amp *= Lerp(1.0f, 1 - noise, mWeightedStrength);
+
+                x *= mLacunarity;
+                amp *= mGain;
+            }
+
+            return sum;
+        }
+
+        template <typename FNfloat> float GenFractalRidged(FNfloat x, FNfloat y) const {
+            int seed = mSeed;
+            float sum = 0;
+            float amp = mFractalBounding;
+
+            for (int i = 0; i < mNoiseOctaves; i++) {
+                float noise = FastAbs(GenNoiseSingle(seed++, x, y));
+                sum += (noise * -2 + 1) * amp;
+                amp *= Lerp(1.0f, 1 - noise, mWeightedStrength);
+
+                x *= mLacunarity;
+                y *= mLacunarity;
+                amp *= mGain;
+            }
+
+            return sum;
+        }
+
+        template <typename FNfloat> float GenFractalRidged(FNfloat x, FNfloat y, FNfloat z) const {
+            int seed = mSeed;
+            float sum = 0;
+            float amp = mFractalBounding;
+
+            for (int i = 0; i < mNoiseOctaves; i++) {
+                float noise = FastAbs(GenNoiseSingle(seed++, x, y, z));
+                sum += (noise * -2 + 1) * amp;
+                amp *= Lerp(1.0f, 1 - noise, mWeightedStrength);
+
+                x *= mLacunarity;
+                y *= mLacunarity;
+                z *= mLacunarity;
+                amp *= mGain;
+            }
+
+            return sum;
+        }
+
+        template <typename FNfloat> float GenFractalRidged(FNfloat x, FNfloat y, FNfloat z, FNfloat w) const {
+            int seed = mSeed;
+            float sum = 0;
+            float amp = mFractalBounding;
+
+            for (int i = 0; i < mNoiseOctaves; i++) {
+                float noise = FastAbs(GenNoiseSingle(seed++, x, y, z, w));
+                sum += (noise * -2 + 1) * amp;
+                amp *= Lerp(1.0f, 1 - noise, mWeightedStrength);
+
+                x *= mLacunarity;
+                y *= mLacunarity;
+                z *= mLacunarity;
+                w *= mLacunarity;
+                amp *= mGain;
+            }
+
+            return sum;
+        }
+
+        // Fractal PingPong
+
+        template <typename FNfloat> float GenFractalPingPong(FNfloat x) const {
+            int seed = mSeed;
+            float sum = 0;
+            float amp = mFractalBounding;
+
+            for (int i = 0; i < mNoiseOctaves; i++) {
+                float noise = PingPong((GenNoiseSingle(seed++, x) + 1) * mPingPongStrength);
+                sum += (noise - 0.5f) * 2 * amp;
+                amp *= Lerp(1.0f, noise, mWeightedStrength);
+
+                x *= mLacunarity;
+                amp *= mGain;
+            }
+
+            return sum;
+        }
+
+        template <typename FNfloat> float GenFractalPingPong(FNfloat x, FNfloat y) const {
+            int seed = mSeed;
+            float sum = 0;
+            float amp = mFractalBounding;
+
+            for (int i = 0; i < mNoiseOctaves; i++) {
+                float noise = PingPong((GenNoiseSingle(seed++, x, y) + 1) * mPingPongStrength);
+                sum += (noise - 0.5f) * 2 * amp;
+                amp *= Lerp(1.0f, noise, mWeightedStrength);
+
+                x *= mLacunarity;
+                y *= mLacunarity;
+                amp *= mGain;
+            }
+
+            return sum;
+        }
+
+        template <typename FNfloat> float GenFractalPingPong(FNfloat x, FNfloat y, FNfloat z) const {
+            int seed = mSeed;
+            float sum = 0;
+            float amp = mFractalBounding;
+
+            for (int i = 0; i < mNoiseOctaves; i++) {
+                float noise = PingPong((GenNoiseSingle(seed++, x, y, z) + 1) * mPingPongStrength);
+                sum += (noise - 0.5f) * 2 * amp;
+                amp *= Lerp(1.0f, noise, mWeightedStrength);
+
+                x *= mLacunarity;
+                y *= mLacunarity;
+                z *= mLacunarity;
+                amp *= mGain;
+            }
+
+            return sum;
+        }
+
+        template <typename FNfloat> float GenFractalPingPong(FNfloat x, FNfloat y, FNfloat z, FNfloat w) const {
+            int seed = mSeed;
+            float sum = 0;
+            float amp = mFractalBounding;
+
+            for (int i = 0; i < mNoiseOctaves; i++) {
+                float noise = PingPong((GenNoiseSingle(seed++, x, y, z, w) + 1) * mPingPongStrength);
+                sum += (noise - 0.5f) * 2 * amp;
+                amp *= Lerp(1.0f, noise, mWeightedStrength);
+
+                x *= mLacunarity;
+                y *= mLacunarity;
+                z *= mLacunarity;
+                w *= mLacunarity;
+                amp *= mGain;
+            }
+
+            return sum;
+        }
+
+        bool IsFractalNoise() const {
+            return mFractalType == FractalType_FBm || mFractalType == FractalType_Ridged ||
+                   mFractalType == FractalType_PingPong;
+        }
+
+        // Batch Evaluation
+        // Positions are processed in spans of up to BatchSize samples held in local arrays. Spans are "row aligned"
+        // when only x varies between samples after the coordinate transform, which lets lattice work be shared.
+
+        static const int BatchSize = 256;
+
+        bool IsRowAligned2D() const {
+            return mNoiseType != NoiseType_OpenSimplex2 && mNoiseType != NoiseType_OpenSimplex2S;
+        }
+
+        bool IsRowAligned3D() const { return mTransformType3D == TransformType3D_None; }
+
+        bool IsRowAligned4D() const {
+            return mNoiseType != NoiseType_OpenSimplex2 && mNoiseType != NoiseType_OpenSimplex2S;
+        }
+
+        void GenFractalSpan(double *xs, float *out, int count) const {
+            if (mFractalType != FractalType_FBm && mFractalType != FractalType_Ridged &&
+                mFractalType != FractalType_PingPong) {
+                GenNoiseSpan(mSeed, xs, out, count);
+                return;
+            }
+
+            int seed = mSeed;
+            float amp[BatchSize];
+            float noise[BatchSize];
+
+            for (int i = 0; i < count; i++) {
+                out[i] = 0;
+                amp[i] = mFractalBounding;
+            }
+
+            for (int o = 0; o < mNoiseOctaves; o++) {
+                GenNoiseSpan(seed++, xs, noise, count);
+
+                switch (mFractalType) {
+                default:
+                case FractalType_FBm:
+                    for (int i = 0; i < count; i++) {
+                        out[i] += noise[i] * amp[i];
+                        amp[i] *= Lerp(1.0f, (noise[i] + 1) * 0.5f, mWeightedStrength);
+                    }
+                    break;
+                case FractalType_Ridged:
+                    for (int i = 0; i < count; i++) {
+                        float n = FastAbs(noise[i]);
+                        out[i] += (n * -2 + 1) * amp[i];
+                        amp[i] *= Lerp(1.0f, 1 - n, mWeightedStrength);
+                    }
+                    break;
+                case FractalType_PingPong:
+                    for (int i = 0; i < count; i++) {
+                        float n = PingPong((noise[i] + 1) * mPingPongStrength);
+                        out[i] += (n - 0.5f) * 2 * amp[i];
+                        amp[i] *= Lerp(1.0f, n, mWeightedStrength);
+                    }
+                    break;
+                }
+
+                for (int i = 0; i < count; i++) {
+                    xs[i] *= mLacunarity;
+                    amp[i] *= mGain;
+                }
+            }
+        }
+
+        void GenFractalSpan(float *xs, float *ys, float *out, int count, bool rowAligned) const {
+            if (mFractalType != FractalType_FBm && mFractalType != FractalType_Ridged &&
+                mFractalType != FractalType_PingPong) {
+                GenNoiseSpan(mSeed, xs, ys, out, count, rowAligned);
+                return;
+            }
+
+            int seed = mSeed;
+            float amp[BatchSize];
+            float noise[BatchSize];
+
+            for (int i = 0; i < count; i++) {
+                out[i] = 0;
+                amp[i] = mFractalBounding;
+            }
+
+            for (int o = 0; o < mNoiseOctaves; o++) {
+                GenNoiseSpan(seed++, xs, ys, noise, count, rowAligned);
+
+                switch (mFractalType) {
+                default:
+                case FractalType_FBm:
+                    for (int i = 0; i < count; i++) {
+                        out[i] += noise[i] * amp[i];
+                        amp[i] *= Lerp(1.0f, FastMin(noise[i] + 1, 2) * 0.5f, mWeightedStrength);
+                    }
+                    break;
+                case FractalType_Ridged:
+                    for (int i = 0; i < count; i++) {
+                        float n = FastAbs(noise[i]);
+                        out[i] += (n * -2 + 1) * amp[i];
+                        amp[i] *= Lerp(1.0f, 1 - n, mWeightedStrength);
+                    }
+                    break;
+                case FractalType_PingPong:
+                    for (int i = 0; i < count; i++) {
+                        float n = PingPong((noise[i] + 1) * mPingPongStrength);
+                        out[i] += (n - 0.5f) * 2 * amp[i];
+                        amp[i] *= Lerp(1.0f, n, mWeightedStrength);
+                    }
+                    break;
+                }
+
+                for (int i = 0; i < count; i++) {
+                    xs[i] *= mLacunarity;
+                    ys[i] *= mLacunarity;
+                    amp[i] *= mGain;
+                }
+            }
+        }
+
+        void GenFractalSpan(float *xs, float *ys, float *zs, float *out, int count, bool rowAligned) const {
+            if (mFractalType != FractalType_FBm && mFractalType != FractalType_Ridged &&
+                mFractalType != FractalType_PingPong) {
+                GenNoiseSpan(mSeed, xs, ys, zs, out, count, rowAligned);
+                return;
+            }
+
+            int seed = mSeed;
+            float amp[BatchSize];
+            float noise[BatchSize];
+
+            for (int i = 0; i < count; i++) {
+                out[i] = 0;
+                amp[i] = mFractalBounding;
+            }
+
+            for (int o = 0; o < mNoiseOctaves; o++) {
+                GenNoiseSpan(seed++, xs, ys, zs, noise, count, rowAligned);
+
+                switch (mFractalType) {
+                default:
+                case FractalType_FBm:
+                    for (int i = 0; i < count; i++) {
+                        out[i] += noise[i] * amp[i];
+                        amp[i] *= Lerp(1.0f, (noise[i] + 1) * 0.5f, mWeightedStrength);
+                    }
+                    break;
+                case FractalType_Ridged:
+                    for (int i = 0; i < count; i++) {
+                        float n = FastAbs(noise[i]);
+                        out[i] += (n * -2 + 1) * amp[i];
+                        amp[i] *= Lerp(1.0f, 1 - n, mWeightedStrength);
+                    }
+                    break;
+                case FractalType_PingPong:
+                    for (int i = 0; i < count; i++) {
+                        float n = PingPong((noise[i] + 1) * mPingPongStrength);
+                        out[i] += (n - 0.5f) * 2 * amp[i];
+                        amp[i] *= Lerp(1.0f, n, mWeightedStrength);
+                    }
+                    break;
+                }
+
+                for (int i = 0; i < count; i++) {
+                    xs[i] *= mLacunarity;
+                    ys[i] *= mLacunarity;
+                    zs[i] *= mLacunarity;
+                    amp[i] *= mGain;
+                }
+            }
+        }
+
+        void GenFractalSpan(float *xs, float *ys, float *zs, float *ws, float *out, int count,
+                            bool rowAligned) const {
+            if (mFractalType != FractalType_FBm && mFractalType != FractalType_Ridged &&
+                mFractalType != FractalType_PingPong) {
+                GenNoiseSpan(mSeed, xs, ys, zs, ws, out, count, rowAligned);
+                return;
+            }
+
+            int seed = mSeed;
+            float amp[BatchSize];
+            float noise[BatchSize];
+
+            for (int i = 0; i < count; i++) {
+                out[i] = 0;
+                amp[i] = mFractalBounding;
+            }
+
+            for (int o = 0; o < mNoiseOctaves; o++) {
+                GenNoiseSpan(seed++, xs, ys, zs, ws, noise, count, rowAligned);
+
+                switch (mFractalType) {
+                default:
+                case FractalType_FBm:
+                    for (int i = 0; i < count; i++) {
+                        out[i] += noise[i] * amp[i];
+                        amp[i] *= Lerp(1.0f, (noise[i] + 1) * 0.5f, mWeightedStrength);
+                    }
+                    break;
+                case FractalType_Ridged:
+                    for (int i = 0; i < count; i++) {
+                        float n = FastAbs(noise[i]);
+                        out[i] += (n * -2 + 1) * amp[i];
+                        amp[i] *= Lerp(1.0f, 1 - n, mWeightedStrength);
+                    }
+                    break;
+                case FractalType_PingPong:
+                    for (int i = 0; i < count; i++) {
+                        float n = PingPong((noise[i] + 1) * mPingPongStrength);
+                        out[i] += (n - 0.5f) * 2 * amp[i];
+                        amp[i] *= Lerp(1.0f, n, mWeightedStrength);
+                    }
+                    break;
+                }
+
+                for (int i = 0; i < count; i++) {
+                    xs[i] *= mLacunarity;
+                    ys[i] *= mLacunarity;
+                    zs[i] *= mLacunarity;
+                    ws[i] *= mLacunarity;
+                    amp[i] *= mGain;
+                }
+            }
+        }
+
+        void GenNoiseSpan(int seed, const double *xs, float *out, int count) const {
+            switch (mNoiseType) {
+            case NoiseType_OpenSimplex2:
+            case NoiseType_OpenSimplex2S:
+            case NoiseType_Perlin:
+                StreamPerlin(seed, xs, out, count);
+                return;
+            case NoiseType_ValueCubic:
+                StreamValueCubic(seed, xs, out, count);
+                return;
+            case NoiseType_Value:
+                StreamValue(seed, xs, out, count);
+                return;
+            default:
+                for (int i = 0; i < count; i++) {
+                    out[i] = 0;
+                }
+                return;
+            }
+        }
+
+        void GenNoiseSpan(int seed, const float *xs, const float *ys, float *out, int count, bool rowAligned) const {
+            if (rowAligned && mNoiseType == NoiseType_Cellular && !mCellularExtendedSearch) {
+                switch (mCellularDistanceFunction) {
+                default:
+                case CellularDistanceFunction_Euclidean:
+                case CellularDistanceFunction_EuclideanSq:
+                    CellularRow<CellularDistanceFunction_EuclideanSq>(seed, xs, ys[0], out, count);
+                    return;
+                case CellularDistanceFunction_Manhattan:
+                    CellularRow<CellularDistanceFunction_Manhattan>(seed, xs, ys[0], out, count);
+                    return;
+                case CellularDistanceFunction_Hybrid:
+                    CellularRow<CellularDistanceFunction_Hybrid>(seed, xs, ys[0], out, count);
+                    return;
+                }
+            }
+
+            if (rowAligned) {
+                switch (mNoiseType) {
+                case NoiseType_Perlin:
+                    if (mApproximateMath)
+                        PerlinRow<true>(seed, xs, ys[0], out, count);
+                    else
+                        PerlinRow<false>(seed, xs, ys[0], out, count);
+                    return;
+                case NoiseType_ValueCubic:
+                    if (mApproximateMath)
+                        ValueCubicRow<true>(seed, xs, ys[0], out, count);
+                    else
+                        ValueCubicRow<false>(seed, xs, ys[0], out, count);
+                    return;
+                case NoiseType_Value:
+                    ValueRow(seed, xs, ys[0], out, count);
+                    return;
+                default:
+                    break;
+                }
+            }
+
+            for (int i = 0; i < count; i++) {
+                out[i] = GenNoiseSingle(seed, xs[i], ys[i]);
+            }
+        }
+
+        void GenNoiseSpan(int seed, const float *xs, const float *ys, const float *zs, float *out, int count,
+                          bool rowAligned) const {
+            // Returns without Distance2 leave the row window scanning all 27 cells where the per-sample search
+            // prunes most of them, so those stay on GenNoiseSingle
+            if (rowAligned && mNoiseType == NoiseType_Cellular && !mCellularExtendedSearch &&
+                mCellularReturnType >= CellularReturnType_Distance2) {
+                switch (mCellularDistanceFunction) {
+                default:
+                case CellularDistanceFunction_Euclidean:
+                case CellularDistanceFunction_EuclideanSq:
+                    CellularRow<CellularDistanceFunction_EuclideanSq>(seed, xs, ys[0], zs[0], out, count);
+                    return;
+                case CellularDistanceFunction_Manhattan:
+                    CellularRow<CellularDistanceFunction_Manhattan>(seed, xs, ys[0], zs[0], out, count);
+                    return;
+                case CellularDistanceFunction_Hybrid:
+                    CellularRow<CellularDistanceFunction_Hybrid>(seed, xs, ys[0], zs[0], out, count);
+                    return;
+                }
+            }
+
+            if (rowAligned) {
+                switch (mNoiseType) {
+                case NoiseType_Perlin:
+                    if (mApproximateMath)
+                        PerlinRow<true>(seed, xs, ys[0], zs[0], out, count);
+                    else
+                        PerlinRow<false>(seed, xs, ys[0], zs[0], out, count);
+                    return;
+                case NoiseType_ValueCubic:
+                    if (mApproximateMath)
+                        ValueCubicRow<true>(seed, xs, ys[0], zs[0], out, count);
+                    else
+                        ValueCubicRow<false>(seed, xs, ys[0], zs[0], out, count);
+                    return;
+                case NoiseType_Value:
+                    ValueRow(seed, xs, ys[0], zs[0], out, count);
+                    return;
+                default:
+                    break;
+                }
+            }
+
+            for (int i = 0; i < count; i++) {
+                out[i] = GenNoiseSingle(seed, xs[i], ys[i], zs[i]);
+            }
+        }
+
+        void GenNoiseSpan(int seed, const float *xs, const float *ys, const float *zs, const float *ws, float *out,
+                          int count, bool rowAligned) const {
+            if (rowAligned) {
+                switch (mNoiseType) {
+                case NoiseType_Perlin:
+                    PerlinRow(seed, xs, ys[0], zs[0], ws[0], out, count);
+                    return;
+                case NoiseType_ValueCubic:
+                case NoiseType_Value:
+                    ValueRow(seed, xs, ys[0], zs[0], ws[0], out, count);
+                    return;
+                default:
+                    break;
+                }
+            }
+
+            for (int i = 0; i < count; i++) {
+                out[i] = GenNoiseSingle(seed, xs[i], ys[i], zs[i], ws[i]);
+            }
+        }
+
+        // Simplex/OpenSimplex2 Noise
+
+        template <typename FNfloat> float SingleSimplex(int seed, FNfloat x, FNfloat y) const {
+            // 2D OpenSimplex2 case uses the same algorithm as ordinary Simplex.
+
+            const float SQRT3 = 1.7320508075688772935274463415059f;
+            const float G2 = (3 - SQRT3) / 6;
+
+            /*
+             * --- Skew moved to TransformNoiseCoordinate method ---
+             * const FNfloat F2 = 0.5f * (SQRT3 - 1);
+             * FNfloat s = (x + y) * F2;
+             * x += s; y += s;
+             */
+
+            int i = FastFloor(x);
+            int j = FastFloor(y);
+            float xi = (float)(x - i);
+            float yi = (float)(y - j);
+
+            float t = (xi + yi) * G2;
+            float x0 = (float)(xi - t);
+            float y0 = (float)(yi - t);
+
+            i *= PrimeX;
+            j *= PrimeY;
+
+            float a = 0.5f - x0 * x0 - y0 * y0;
+            float n0 = KernelWeight(a) * GradCoord(seed, i, j, x0, y0);
+
+            float c = (float)(2 * (1 - 2 * G2) * (1 / G2 - 2)) * t + ((float)(-2 * (1 - 2 * G2) * (1 - 2 * G2)) + a);
+            float x2 = x0 + (2 * (float)G2 - 1);
+            float y2 = y0 + (2 * (float)G2 - 1);
+            float n2 = KernelWeight(c) * GradCoord(seed, i + PrimeX, j + PrimeY, x2, y2);
+
+            bool upper = y0 > x0;
+            float x1 = x0 + (upper ? (float)G2 : ((float)G2 - 1));
+            float y1 = y0 + (upper ? ((float)G2 - 1) : (float)G2);
+            float b = 0.5f - x1 * x1 - y1 * y1;
+            float n1 = KernelWeight(b) * GradCoord(seed, upper ? i : i + PrimeX, upper ? j + PrimeY : j, x1, y1);
+
+            return (n0 + n1 + n2) * 99.83685446303647f;
+        }
+
+        template <typename FNfloat> float SingleOpenSimplex2(int seed, FNfloat x, FNfloat y, FNfloat z) const {
+            // 3D OpenSimplex2 case uses two offset rotated cube grids.
+
+            /*
+             * --- Rotation moved to TransformNoiseCoordinate method ---
+             * const FNfloat R3 = (FNfloat)(2.0 / 3.0);
+             * FNfloat r = (x + y + z) * R3; // Rotation, not skew
+             * x = r - x; y = r - y; z = r - z;
+             */
+
+            int i = FastRound(x);
+            int j = FastRound(y);
+            int k = FastRound(z);
+            float x0 = (float)(x - i);
+            float y0 = (float)(y - j);
+            float z0 = (float)(z - k);
+
+            int xNSign = (int)(-1.0f - x0) | 1;
+            int yNSign = (int)(-1.0f - y0) | 1;
+            int zNSign = (int)(-1.0f - z0) | 1;
+
+            float ax0 = xNSign * -x0;
+            float ay0 = yNSign * -y0;
+            float az0 = zNSign * -z0;
+
+            i *= PrimeX;
+            j *= PrimeY;
+            k *= PrimeZ;
+
+            float value = 0;
+            float a = (0.6f - x0 * x0) - (y0 * y0 + z0 * z0);
+
+            for (int l = 0;; l++) {
+                value += KernelWeight(a) * GradCoord(seed, i, j, k, x0, y0, z0);
+
+                bool stepX = ax0 >= ay0 && ax0 >= az0;
+                bool stepY = !stepX && ay0 > ax0 && ay0 >= az0;
+                bool stepZ = !stepX && !stepY;
+
+                float x1 = stepX ? x0 + xNSign : x0;
+                float y1 = stepY ? y0 + yNSign : y0;
+                float z1 = stepZ ? z0 + zNSign : z0;
+                float b = a + 1;
+                b -= stepX ? xNSign * 2 * x1 : (stepY ? yNSign * 2 * y1 : zNSign * 2 * z1);
+                int i1 = stepX ? i - xNSign * PrimeX : i;
+                int j1 = stepY ? j - yNSign * PrimeY : j;
+                int k1 = stepZ ? k - zNSign * PrimeZ : k;
+
+                value += KernelWeight(b) * GradCoord(seed, i1, j1, k1, x1, y1, z1);
+
+                if (l == 1)
+                    break;
+
+                ax0 = 0.5f - ax0;
+                ay0 = 0.5f - ay0;
+                az0 = 0.5f - az0;
+
+                x0 = xNSign * ax0;
+                y0 = yNSign * ay0;
+                z0 = zNSign * az0;
+
+                a += (0.75f - ax0) - (ay0 + az0);
+
+                i += (xNSign >> 1) & PrimeX;
+                j += (yNSign >> 1) & PrimeY;
+                k += (zNSign >> 1) & PrimeZ;
+
+                xNSign = -xNSign;
+                yNSign = -yNSign;
+                zNSign = -zNSign;
+
+                seed = ~seed;
+            }
+
+            return value * 32.69428253173828125f;
+        }
+
+        // OpenSimplex2S Noise
+
+        template <typename FNfloat> float SingleOpenSimplex2S(int seed, FNfloat x, FNfloat y) const {
+            // 2D OpenSimplex2S case is a modified 2D simplex noise.
+
+            const FNfloat SQRT3 = (FNfloat)1.7320508075688772935274463415059;
+            const FNfloat G2 = (3 - SQRT3) / 6;
+
+            /*
+             * --- Skew moved to TransformNoiseCoordinate method ---
+             * const FNfloat F2 = 0.5f * (SQRT3 - 1);
+             * FNfloat s = (x + y) * F2;
+             * x += s; y += s;
+             */
+
+            int i = FastFloor(x);
+            int j = FastFloor(y);
+            float xi = (float)(x - i);
+            float yi = (float)(y - j);
+
+            i *= PrimeX;
+            j *= PrimeY;
+            int i1 = i + PrimeX;
+            int j1 = j + PrimeY;
+
+            float t = (xi + yi) * (float)G2;
+            float x0 = xi - t;
+            float y0 = yi - t;
+
+            float a0 = (2.0f / 3.0f) - x0 * x0 - y0 * y0;
+            float value = (a0 * a0) * (a0 * a0) * GradCoord(seed, i, j, x0, y0);
+
+            float a1 = (float)(2 * (1 - 2 * G2) * (1 / G2 - 2)) * t + ((float)(-2 * (1 - 2 * G2) * (1 - 2 * G2)) + a0);
+            float x1 = x0 - (float)(1 - 2 * G2);
+            float y1 = y0 - (float)(1 - 2 * G2);
+            value += (a1 * a1) * (a1 * a1) * GradCoord(seed, i1, j1, x1, y1);
+
+            // The third and fourth points each take one of four lattice offsets, chosen from the simplex half (t > G2)
+            // and a side test. Offsets come from small tables so the selection has no data dependent branches.
+            const float xOffset2[4] = {(float)(G2 - 1), (float)(1 - G2), (float)G2, (float)(3 * G2 - 2)};
+            const float yOffset2[4] = {(float)G2, -(float)G2, (float)(G2 - 1), (float)(3 * G2 - 1)};
+            const int iOffset2[4] = {PrimeX, -PrimeX, 0, PrimeX << 1};
+            const int jOffset2[4] = {0, 0, PrimeY, PrimeY};
+
+            const float xOffset3[4] = {(float)G2, -(float)G2, (float)(G2 - 1), (float)(3 * G2 - 1)};
+            const float yOffset3[4] = {(float)(G2 - 1), -(float)(G2 - 1), (float)G2, (float)(3 * G2 - 2)};
+            const int iOffset3[4] = {0, 0, PrimeX, PrimeX};
+            const int jOffset3[4] = {PrimeY, -PrimeY, 0, PrimeY << 1};
+
+            float xmyi = xi - yi;
+            int upper = t > G2;
+            int side2 = upper ? xi + xmyi > 1 : xi + xmyi < 0;
+            int side3 = upper ? yi - xmyi > 1 : yi < xmyi;
+            int index2 = (upper << 1) | side2;
+            int index3 = (upper << 1) | side3;
+
+            float x2 = x0 + xOffset2[index2];
+            float y2 = y0 + yOffset2[index2];
+            float a2 = (2.0f / 3.0f) - x2 * x2 - y2 * y2;
+            value += KernelWeight(a2) * GradCoord(seed, i + iOffset2[index2], j + jOffset2[index2], x2, y2);
+
+            float x3 = x0 + xOffset3[index3];
+            float y3 = y0 + yOffset3[index3];
+            float a3 = (2.0f / 3.0f) - x3 * x3 - y3 * y3;
+            value += KernelWeight(a3) * GradCoord(seed, i + iOffset3[index3], j + jOffset3[index3], x3, y3);
+
+            return value * 18.24196194486065f;
+        }
+
+        template <typename FNfloat> float SingleOpenSimplex2S(int seed, FNfloat x, FNfloat y, FNfloat z) const {
+            // 3D OpenSimplex2S case uses two offset rotated cube grids.
+
+            /*
+             * --- Rotation moved to TransformNoiseCoordinate method ---
+             * const FNfloat R3 = (FNfloat)(2.0 / 3.0);
+             * FNfloat r = (x + y + z) * R3; // Rotation, not skew
+             * x = r - x; y = r - y; z = r - z;
+             */
+
+            int i = FastFloor(x);
+            int j = FastFloor(y);
+            int k = FastFloor(z);
+            float xi = (float)(x - i);
+            float yi = (float)(y - j);
+            float zi = (float)(z - k);
+
+            i *= PrimeX;
+            j *= PrimeY;
+            k *= PrimeZ;
+            int seed2 = seed + 1293373;
+
+            int xNMask = (int)(-0.5f - xi);
+            int yNMask = (int)(-0.5f - yi);
+            int zNMask = (int)(-0.5f - zi);
+
+            float x0 = xi + xNMask;
+            float y0 = yi + yNMask;
+            float z0 = zi + zNMask;
+            float a0 = 0.75f - x0 * x0 - y0 * y0 - z0 * z0;
+            float value =
+                (a0 * a0) * (a0 * a0) *
+                GradCoord(seed, i + (xNMask & PrimeX), j + (yNMask & PrimeY), k + (zNMask & PrimeZ), x0, y0, z0);
+
+            float x1 = xi - 0.5f;
+            float y1 = yi - 0.5f;
+            float z1 = zi - 0.5f;
+            float a1 = 0.75f - x1 * x1 - y1 * y1 - z1 * z1;
+            value += (a1 * a1) * (a1 * a1) * GradCoord(seed2, i + PrimeX, j + PrimeY, k + PrimeZ, x1, y1, z1);
+
+            OpenSimplex2SLattice3D lattice = {{seed, seed2},
+                                              {i, j, k},
+                                              (xNMask & 1) | (yNMask & 2) | (zNMask & 4),
+                                              {a0, a1},
+                                              {{x0, y0, z0}, {x1, y1, z1}},
+                                              {}};
+            const int nMask[3] = {xNMask, yNMask, zNMask};
+            for (int axis = 0; axis < 3; axis++) {
+                float d1 = lattice.d[1][axis];
+                lattice.aFlip[0][axis] = ((nMask[axis] | 1) << 1) * d1;
+                lattice.aFlip[1][axis] = (-2 - (nMask[axis] << 2)) * d1 - 1.0f;
+            }
+
+            bool skipX = OpenSimplex2SGroup3D<0>(lattice, value);
+            bool skipY = OpenSimplex2SGroup3D<1>(lattice, value);
+            bool skipZ = OpenSimplex2SGroup3D<2>(lattice, value);
+
+            // Second grid vertices flipped along two axes, unless ruled out by their axis group
+            if (!skipX)
+                OpenSimplex2SVertex3D<3>(lattice, value);
+            if (!skipY)
+                OpenSimplex2SVertex3D<7>(lattice, value);
+            if (!skipZ)
+                OpenSimplex2SVertex3D<11>(lattice, value);
+
+            return value * 9.046026385208288f;
+        }
+
+        // 3D OpenSimplex2S visits the base vertex of each of its two grids (0 for the grid holding the closest
+        // vertex, 1 for the grid holding the cell centre) and up to 12 vertices flipped away from them. The flipped
+        // vertices come in three axis groups of four: the first grid flipped along the axis, the first grid flipped
+        // along the other two axes, then the same for the second grid. The region code holds one bit per axis, x in
+        // bit 0, set where the sample lies in the upper half of its cell. It selects every flipped vertex's lattice
+        // offset from a precomputed table, as the reference implementation does. d holds the offsets from each
+        // grid's base vertex and aFlip what flipping along an axis adds to a vertex's falloff.
+        struct OpenSimplex2SLattice3D {
+            int seed[2];
+            int cell[3];
+            int region;
+            float a[2];
+            float d[2][3];
+            float aFlip[2][3];
+        };
+
+        // Per region code and flipped vertex: the primed lattice offset from the sample's cell and the step added to
+        // the grid's base offset d, along each axis
+        struct OpenSimplex2SVertices3D {
+            int primed[8][12][3];
+            float step[8][12][3];
+        };
+
+        static constexpr OpenSimplex2SVertices3D BuildOpenSimplex2SVertices3D() {
+            OpenSimplex2SVertices3D table = {};
+            const unsigned primes[3] = {(unsigned)PrimeX, (unsigned)PrimeY, (unsigned)PrimeZ};
+
+            for (int region = 0; region < 8; region++) {
+                for (int vertex = 0; vertex < 12; vertex++) {
+                    int group = vertex >> 2;
+                    bool secondGrid = (vertex >> 1) & 1;
+                    bool otherAxes = vertex & 1;
+
+                    for (int axis = 0; axis < 3; axis++) {
+                        bool flip = otherAxes ? axis != group : axis == group;
+                        int upper = (region >> axis) & 1;
+                        int cells = secondGrid ? (flip ? upper * 2 : 1) : upper ^ (int)flip;
+                        int step = secondGrid ? 1 - upper * 2 : upper * 2 - 1;
+
+                        table.primed[region][vertex][axis] = (int)((unsigned)cells * primes[axis]);
+                        table.step[region][vertex][axis] = flip ? (float)step : 0.0f;
+                    }
+                }
+            }
+            return table;
+        }
+
+        static const OpenSimplex2SVertices3D &OpenSimplex2SVertexTable3D() {
+            static constexpr OpenSimplex2SVertices3D table = BuildOpenSimplex2SVertices3D();
+            return table;
+        }
+
+        // Falloff of a flipped vertex, summed in the same order as the unrolled kernel this replaced so output is
+        // unchanged
+        template <int Vertex> static float OpenSimplex2SFalloff3D(const OpenSimplex2SLattice3D &lattice) {
+            const int grid = (Vertex >> 1) & 1;
+            const int group = Vertex >> 2;
+            const float *aFlip = lattice.aFlip[grid];
+
+            if (Vertex & 1)
+                return aFlip[group == 0 ? 1 : 0] + aFlip[group == 2 ? 1 : 2] + lattice.a[grid];
+            return aFlip[group] + lattice.a[grid];
+        }
+
+        // One axis group takes the first grid vertex flipped along its axis. When that vertex is out of range it tries
+        // the first grid vertex flipped along the other two axes and the second grid vertex flipped along its axis.
+        // Returns whether the latter was in range, which rules out the second grid vertex flipped along the other two.
+        template <int Axis> bool OpenSimplex2SGroup3D(const OpenSimplex2SLattice3D &lattice, float &value) const {
+            if (OpenSimplex2SVertex3D<Axis * 4>(lattice, value))
+                return false;
+            OpenSimplex2SVertex3D<Axis * 4 + 1>(lattice, value);
+            return OpenSimplex2SVertex3D<Axis * 4 + 2>(lattice, value);
+        }
+
+        // Adds the falloff weighted gradient of a flipped vertex to value, returns false when it is out of range
+        template <int Vertex> bool OpenSimplex2SVertex3D(const OpenSimplex2SLattice3D &lattice, float &value) const {
+            float a = OpenSimplex2SFalloff3D<Vertex>(lattice);
+            if (a <= 0)
+                return false;
+
+            const OpenSimplex2SVertices3D &table = OpenSimplex2SVertexTable3D();
+            const int *primed = table.primed[lattice.region][Vertex];
+            const float *step = table.step[lattice.region][Vertex];
+            const int grid = (Vertex >> 1) & 1;
+            const float *d = lattice.d[grid];
+
+            int xPrimed = lattice.cell[0] + primed[0];
+            int yPrimed = lattice.cell[1] + primed[1];
+            int zPrimed = lattice.cell[2] + primed[2];
+            float dx = d[0] + step[0];
+            float dy = d[1] + step[1];
+            float dz = d[2] + step[2];
+            value += (a * a) * (a * a) * GradCoord(lattice.seed[grid], xPrimed, yPrimed, zPrimed, dx, dy, dz);
+            return true;
+        }
+
+        // Cellular Noise
+
+        float CellularReturn(float distance0, float distance1, int closestHash) const {
+            if (mCellularDistanceFunction == CellularDistanceFunction_Euclidean &&
+                mCellularReturnType >= CellularReturnType_Distance) {
+                distance0 = FastSqrt(distance0);
+
+                if (mCellularReturnType >= CellularReturnType_Distance2) {
+                    distance1 = FastSqrt(distance1);
+                }
+            }
+
+            switch (mCellularReturnType) {
+            case CellularReturnType_CellValue:
+                return closestHash * (1 / 2147483648.0f);
+            case CellularReturnType_Distance:
+                return distance0 - 1;
+            case CellularReturnType_Distance2:
+                return distance1 - 1;
+            case CellularReturnType_Distance2Add:
+                return (distance1 + distance0) * 0.5f - 1;
+            case CellularReturnType_Distance2Sub:
+                return distance1 - distance0 - 1;
+            case CellularReturnType_Distance2Mul:
+                return distance1 * distance0 * 0.5f - 1;
+            case CellularReturnType_Distance2Div:
+                return distance0 / distance1 - 1;
+            default:
+                return 0;
+            }
+        }
+
+        template <typename FNfloat> float SingleCellular(int seed, FNfloat x, FNfloat y) const {
+            if (mCellularExtendedSearch)
+                return SingleCellularExtended(seed, x, y);
+
+            int xr = FastRound(x);
+            int yr = FastRound(y);
+
+            float distance0 = 1e10f;
+            float distance1 = 1e10f;
+            int closestHash = 0;
+
+            float cellularJitter = 0.43701595f * mCellularJitterModifier;
+
+            int xPrimed = (xr - 1) * PrimeX;
+            int yPrimedBase = (yr - 1) * PrimeY;
+
+            switch (mCellularDistanceFunction) {
+            default:
+            case CellularDistanceFunction_Euclidean:
+            case CellularDistanceFunction_EuclideanSq:
+                for (int xi = xr - 1; xi <= xr + 1; xi++) {
+                    int yPrimed = yPrimedBase;
+
+                    for (int yi = yr - 1; yi <= yr + 1; yi++) {
+                        int hash = Hash(seed, xPrimed, yPrimed);
+                        int idx = hash & (255 << 1);
+
+                        float vecX = (float)(xi - x) + Lookup<float>::RandVecs2D[idx] * cellularJitter;
+                        float vecY = (float)(yi - y) + Lookup<float>::RandVecs2D[idx | 1] * cellularJitter;
+
+                        float newDistance = vecX * vecX + vecY * vecY;
+
+                        distance1 = FastMax(FastMin(distance1, newDistance), distance0);
+                        bool closer = newDistance < distance0;
+                        closestHash = closer ? hash : closestHash;
+                        distance0 = closer ? newDistance : distance0;
+                        yPrimed += PrimeY;
+                    }
+                    xPrimed += PrimeX;
+                }
+                break;
+            case CellularDistanceFunction_Manhattan:
+                for (int xi = xr - 1; xi <= xr + 1; xi++) {
+                    int yPrimed = yPrimedBase;
+
+                    for (int yi = yr - 1; yi <= yr + 1; yi++) {
+                        int hash = Hash(seed, xPrimed, yPrimed);
+                        int idx = hash & (255 << 1);
+
+                        float vecX = (float)(xi - x) + Lookup<float>::RandVecs2D[idx] * cellularJitter;
+                        float vecY = (float)(yi - y) + Lookup<float>::RandVecs2D[idx | 1] * cellularJitter;
+
+                        float newDistance = FastAbs(vecX) + FastAbs(vecY);
+
+                        distance1 = FastMax(FastMin(distance1, newDistance), distance0);
+                        bool closer = newDistance < distance0;
+                        closestHash = closer ? hash : closestHash;
+                        distance0 = closer ? newDistance : distance0;
+                        yPrimed += PrimeY;
+                    }
+                    xPrimed += PrimeX;
+                }
+                break;
+            case CellularDistanceFunction_Hybrid:
+                for (int xi = xr - 1; xi <= xr + 1; xi++) {
+                    int yPrimed = yPrimedBase;
+
+                    for (int yi = yr - 1; yi <= yr + 1; yi++) {
+                        int hash = Hash(seed, xPrimed, yPrimed);
+                        int idx = hash & (255 << 1);
+
+                        float vecX = (float)(xi - x) + Lookup<float>::RandVecs2D[idx] * cellularJitter;
+                        float vecY = (float)(yi - y) + Lookup<float>::RandVecs2D[idx | 1] * cellularJitter;
+
+                        float newDistance = (FastAbs(vecX) + FastAbs(vecY)) + (vecX * vecX + vecY * vecY);
+
+                        distance1 = FastMax(FastMin(distance1, newDistance), distance0);
+                        bool closer = newDistance < distance0;
+                        closestHash = closer ? hash : closestHash;
+                        distance0 = closer ? newDistance : distance0;
+                        yPrimed += PrimeY;
+                    }
+                    xPrimed += PrimeX;
+                }
+                break;
+            }
+
+            return CellularReturn(distance0, distance1, closestHash);
+        }
+
+        template <typename FNfloat> float SingleCellular(int seed, FNfloat x, FNfloat y, FNfloat z) const {
+            if (mCellularExtendedSearch)
+                return SingleCellularExtended(seed, x, y, z);
+
+            float distance0 = 1e10f;
+            float distance1 = 1e10f;
+            int closestHash = 0;
+
+            switch (mCellularDistanceFunction) {
+            case CellularDistanceFunction_Euclidean:
+            case CellularDistanceFunction_EuclideanSq:
+                SearchCellular<CellularDistanceFunction_EuclideanSq>(seed, x, y, z, distance0, distance1, closestHash);
+                break;
+            case CellularDistanceFunction_Manhattan:
+                SearchCellular<CellularDistanceFunction_Manhattan>(seed, x, y, z, distance0, distance1, closestHash);
+                break;
+            case CellularDistanceFunction_Hybrid:
+                SearchCellular<CellularDistanceFunction_Hybrid>(seed, x, y, z, distance0, distance1, closestHash);
+                break;
+            default:
+                break;
+            }
+
+            return CellularReturn(distance0, distance1, closestHash);
+        }
+
+        // The F2 bound only skips cells while jittered feature points stay well inside their cells. From a jitter
+        // modifier of about 0.6 it leaves too many of the 27 cells to pay for the ordered search's branches, measured
+        // with bench_cellular, so Distance2* returns fall back to the plain scan there
+        static bool CellularPrunesDistance2(float jitterModifier) { return FastAbs(jitterModifier) < 0.6f; }
+
+        // Plain scan of all 27 neighbouring cells in x, y, z order
+        template <CellularDistanceFunction DistanceFunction, typename FNfloat>
+        void ScanCellular(int seed, FNfloat x, FNfloat y, FNfloat z, float &distance0, float &distance1,
+                          int &closestHash) const {
+            int xr = FastRound(x);
+            int yr = FastRound(y);
+            int zr = FastRound(z);
+
+            float cellularJitter = 0.39614353f * mCellularJitterModifier;
+
+            unsigned xPrimed = (unsigned)(xr - 1) * (unsigned)PrimeX;
+            unsigned yPrimedBase = (unsigned)(yr - 1) * (unsigned)PrimeY;
+            unsigned zPrimedBase = (unsigned)(zr - 1) * (unsigned)PrimeZ;
+
+            for (int xi = xr - 1; xi <= xr + 1; xi++) {
+                unsigned yPrimed = yPrimedBase;
+
+                for (int yi = yr - 1; yi <= yr + 1; yi++) {
+                    unsigned zPrimed = zPrimedBase;
+
+                    for (int zi = zr - 1; zi <= zr + 1; zi++) {
+                        ENTROPY_CELLULAR_VISIT();
+
+                        int hash = Hash(seed, (int)xPrimed, (int)yPrimed, (int)zPrimed);
+                        int idx = hash & (255 << 2);
+
+                        float vecX = (float)(xi - x) + Lookup<float>::RandVecs3D[idx] * cellularJitter;
+                        float vecY = (float)(yi - y) + Lookup<float>::RandVecs3D[idx | 1] * cellularJitter;
+                        float vecZ = (float)(zi - z) + Lookup<float>::RandVecs3D[idx | 2] * cellularJitter;
+
+                        float newDistance = CellularDistance<DistanceFunction>(vecX, vecY, vecZ);
+
+                        distance1 = FastMax(FastMin(distance1, newDistance), distance0);
+                        bool closer = newDistance < distance0;
+                        closestHash = closer ? hash : closestHash;
+                        distance0 = closer ? newDistance : distance0;
+                        zPrimed += (unsigned)PrimeZ;
+                    }
+                    yPrimed += (unsigned)PrimeY;
+                }
+                xPrimed += (unsigned)PrimeX;
+            }
+        }
+
+        // Lower bound of the distance contribution along one axis for a feature point whose cell corner is `axis`
+        // away from the sample, given that each jittered offset component lies within [-jitter, jitter]
+        template <CellularDistanceFunction DistanceFunction> static float CellularAxisBound(float axis, float jitter) {
+            float gap = FastMax(FastAbs(axis) - jitter, 0.0f);
+
+            switch (DistanceFunction) {
+            case CellularDistanceFunction_Manhattan:
+                return gap;
+            case CellularDistanceFunction_Hybrid:
+                return gap + gap * gap;
+            default:
+                return gap * gap;
+            }
+        }
+
+        // Visits the 27 neighbouring cells nearest first and skips any slab, row or cell whose closest possible
+        // feature point cannot improve the distances the return type needs. Results match the plain x, y, z ordered
+        // scan, including which cell wins on equal distances.
+        template <CellularDistanceFunction DistanceFunction, typename FNfloat>
+        void SearchCellular(int seed, FNfloat x, FNfloat y, FNfloat z, float &distance0, float &distance1,
+                            int &closestHash) const {
+            bool needsDistance1 = mCellularReturnType >= CellularReturnType_Distance2;
+            if (needsDistance1 && !CellularPrunesDistance2(mCellularJitterModifier)) {
+                ScanCellular<DistanceFunction>(seed, x, y, z, distance0, distance1, closestHash);
+                return;
+            }
+
+            int xr = FastRound(x);
+            int yr = FastRound(y);
+            int zr = FastRound(z);
+
+            float cellularJitter = 0.39614353f * mCellularJitterModifier;
+            // Slack covers rounding in the offset products so pruning never drops a cell that could win
+            float boundJitter = FastAbs(cellularJitter) * 1.0001f + 1e-5f;
+
+            int xPrimed[3], yPrimed[3], zPrimed[3];
+            float axisX[3], axisY[3], axisZ[3];
+            float boundX[3], boundY[3], boundZ[3];
+
+            xPrimed[0] = (xr - 1) * PrimeX;
+            yPrimed[0] = (yr - 1) * PrimeY;
+            zPrimed[0] = (zr - 1) * PrimeZ;
+
+            for (int k = 0; k < 3; k++) {
+                if (k > 0) {
+                    xPrimed[k] = xPrimed[k - 1] + PrimeX;
+                    yPrimed[k] = yPrimed[k - 1] + PrimeY;
+                    zPrimed[k] = zPrimed[k - 1] + PrimeZ;
+                }
+                axisX[k] = (float)(xr - 1 + k - x);
+                axisY[k] = (float)(yr - 1 + k - y);
+                axisZ[k] = (float)(zr - 1 + k - z);
+                boundX[k] = CellularAxisBound<DistanceFunction>(axisX[k], boundJitter);
+                boundY[k] = CellularAxisBound<DistanceFunction>(axisY[k], boundJitter);
+                boundZ[k] = CellularAxisBound<DistanceFunction>(axisZ[k], boundJitter);
+            }
+
+            // Per axis: own cell, the neighbour on the side the sample lies in, then the far neighbour
+            int orderX[3] = {1, x >= xr ? 2 : 0, x >= xr ? 0 : 2};
+            int orderY[3] = {1, y >= yr ? 2 : 0, y >= yr ? 0 : 2};
+            int orderZ[3] = {1, z >= zr ? 2 : 0, z >= zr ? 0 : 2};
+            int closestIndex = 27;
+
+            for (int i = 0; i < 3; i++) {
+                int kx = orderX[i];
+                if (boundX[kx] > (needsDistance1 ? distance1 : distance0))
+                    continue;
+
+                for (int j = 0; j < 3; j++) {
+                    int ky = orderY[j];
+                    float boundXY = boundX[kx] + boundY[ky];
+                    if (boundXY > (needsDistance1 ? distance1 : distance0))
+                        continue;
+
+                    for (int l = 0; l < 3; l++) {
+                        int kz = orderZ[l];
+                        if (boundXY + boundZ[kz] > (needsDistance1 ? distance1 : distance0))
+                            continue;
+
+                        ENTROPY_CELLULAR_VISIT();
+
+                        int hash = Hash(seed, xPrimed[kx], yPrimed[ky], zPrimed[kz]);
+                        int idx = hash & (255 << 2);
+
+                        float vecX = axisX[kx] + Lookup<float>::RandVecs3D[idx] * cellularJitter;
+                        float vecY = axisY[ky] + Lookup<float>::RandVecs3D[idx | 1] * cellularJitter;
+                        float vecZ = axisZ[kz] + Lookup<float>::RandVecs3D[idx | 2] * cellularJitter;
+
+                        float newDistance = CellularDistance<DistanceFunction>(vecX, vecY, vecZ);
+
+                        // Index in x, y, z scan order breaks ties the same way the ordered scan does
+                        int index = (kx * 3 + ky) * 3 + kz;
+
+                        distance1 = FastMax(FastMin(distance1, newDistance), distance0);
+                        bool closer = (newDistance < distance0) | ((newDistance == distance0) & (index < closestIndex));
+                        closestHash = closer ? hash : closestHash;
+                        closestIndex = closer ? index : closestIndex;
+                        distance0 = closer ? newDistance : distance0;
+                    }
+                }
+            }
+        }
+
+        // Extended Cellular Search
+        // With large jitter a feature point can land several cells away from its grid position. Each axis is walked
+        // outwards from the sample's cell, near side first, and stops as soon as the per-axis bound alone rules out
+        // any closer point. The radius only caps the walk, it covers the F2 distance for every distance function.
+
+        static int CellularSearchRadius(float cellularJitter) {
+            return 3 + (int)std::ceil(2.75f * FastAbs(cellularJitter));
+        }
+
+        template <typename FNfloat> float SingleCellularExtended(int seed, FNfloat x, FNfloat y) const {
+            float distance0 = 1e10f;
+            float distance1 = 1e10f;
+            int closestHash = 0;
+
+            switch (mCellularDistanceFunction) {
+            default:
+            case CellularDistanceFunction_Euclidean:
+            case CellularDistanceFunction_EuclideanSq:
+                SearchCellularExtended<CellularDistanceFunction_EuclideanSq>(seed, x, y, distance0, distance1,
+                                                                             closestHash);
+                break;
+            case CellularDistanceFunction_Manhattan:
+                SearchCellularExtended<CellularDistanceFunction_Manhattan>(seed, x, y, distance0, distance1,
+                                                                           closestHash);
+                break;
+            case CellularDistanceFunction_Hybrid:
+                SearchCellularExtended<CellularDistanceFunction_Hybrid>(seed, x, y, distance0, distance1, closestHash);
+                break;
+            }
+
+            return CellularReturn(distance0, distance1, closestHash);
+        }
+
+        template <typename FNfloat> float SingleCellularExtended(int seed, FNfloat x, FNfloat y, FNfloat z) const {
+            float distance0 = 1e10f;
+            float distance1 = 1e10f;
+            int closestHash = 0;
+
+            switch (mCellularDistanceFunction) {
+            case CellularDistanceFunction_Euclidean:
+            case CellularDistanceFunction_EuclideanSq:
+                SearchCellularExtended<CellularDistanceFunction_EuclideanSq>(seed, x, y, z, distance0, distance1,
+                                                                             closestHash);
+                break;
+            case CellularDistanceFunction_Manhattan:
+                SearchCellularExtended<CellularDistanceFunction_Manhattan>(seed, x, y, z, distance0, distance1,
+                                                                           closestHash);
+                break;
+            case CellularDistanceFunction_Hybrid:
+                SearchCellularExtended<CellularDistanceFunction_Hybrid>(seed, x, y, z, distance0, distance1,
+                                                                        closestHash);
+                break;
+            default:
+                break;
+            }
+
+            return CellularReturn(distance0, distance1, closestHash);
+        }
+
+        template <CellularDistanceFunction DistanceFunction, typename FNfloat>
+        void SearchCellularExtended(int seed, FNfloat x, FNfloat y, float &distance0, float &distance1,
+                                    int &closestHash) const {
+            int xr = FastRound(x);
+            int yr = FastRound(y);
+
+            float cellularJitter = 0.43701595f * mCellularJitterModifier;
+            float boundJitter = FastAbs(cellularJitter) * 1.0001f + 1e-5f;
+            int radius = CellularSearchRadius(cellularJitter);
+            bool needsDistance1 = mCellularReturnType >= CellularReturnType_Distance2;
+
+            int sideX = x >= xr ? 1 : -1;
+            int sideY = y >= yr ? 1 : -1;
+
+            // Pass 0 walks from the sample's cell towards the side it lies in, pass 1 walks the opposite side
+            for (int passX = 0; passX < 2; passX++) {
+                int stepX = passX == 0 ? sideX : -sideX;
+
+                for (int dx = passX; dx <= radius; dx++) {
+                    int xi = xr + dx * stepX;
+                    float axisX = (float)(xi - x);
+                    float boundX = CellularAxisBound<DistanceFunction>(axisX, boundJitter);
+                    if (boundX > (needsDistance1 ? distance1 : distance0))
+                        break;
+
+                    int xPrimed = xi * PrimeX;
+
+                    for (int passY = 0; passY < 2; passY++) {
+                        int stepY = passY == 0 ? sideY : -sideY;
+
+                        for (int dy = passY; dy <= radius; dy++) {
+                            int yi = yr + dy * stepY;
+                            float axisY = (float)(yi - y);
+                            if (boundX + CellularAxisBound<DistanceFunction>(axisY, boundJitter) >
+                                (needsDistance1 ? distance1 : distance0))
+                                break;
+
+                            int hash = Hash(seed, xPrimed, yi * PrimeY);
+                            int idx = hash & (255 << 1);
+
+                            float vecX = axisX + Lookup<float>::RandVecs2D[idx] * cellularJitter;
+                            float vecY = axisY + Lookup<float>::RandVecs2D[idx | 1] * cellularJitter;
+
+                            float newDistance = CellularDistance<DistanceFunction>(vecX, vecY);
+
+                            distance1 = FastMax(FastMin(distance1, newDistance), distance0);
+                            if (newDistance < distance0) {
+                                distance0 = newDistance;
+                                closestHash = hash;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        template <CellularDistanceFunction DistanceFunction, typename FNfloat>
+        void SearchCellularExtended(int seed, FNfloat x, FNfloat y, FNfloat z, float &distance0, float &distance1,
+                                    int &closestHash) const {
+            int xr = FastRound(x);
+            int yr = FastRound(y);
+            int zr = FastRound(z);
+
+            float cellularJitter = 0.39614353f * mCellularJitterModifier;
+            float boundJitter = FastAbs(cellularJitter) * 1.0001f + 1e-5f;
+            int radius = CellularSearchRadius(cellularJitter);
+            bool needsDistance1 = mCellularReturnType >= CellularReturnType_Distance2;
+
+            int sideX = x >= xr ? 1 : -1;
+            int sideY = y >= yr ? 1 : -1;
+            int sideZ = z >= zr ? 1 : -1;
+
+            for (int passX = 0; passX < 2; passX++) {
+                int stepX = passX == 0 ? sideX : -sideX;
+
+                for (int dx = passX; dx <= radius; dx++) {
+                    int xi = xr + dx * stepX;
+                    float axisX = (float)(xi - x);
+                    float boundX = CellularAxisBound<DistanceFunction>(axisX, boundJitter);
+                    if (boundX > (needsDistance1 ? distance1 : distance0))
+                        break;
+
+                    int xPrimed = xi * PrimeX;
+
+                    for (int passY = 0; passY < 2; passY++) {
+                        int stepY = passY == 0 ? sideY : -sideY;
+
+                        for (int dy = passY; dy <= radius; dy++) {
+                            int yi = yr + dy * stepY;
+                            float axisY = (float)(yi - y);
+                            float boundXY = boundX + CellularAxisBound<DistanceFunction>(axisY, boundJitter);
+                            if (boundXY > (needsDistance1 ? distance1 : distance0))
+                                break;
+
+                            int yPrimed = yi * PrimeY;
+
+                            for (int passZ = 0; passZ < 2; passZ++) {
+                                int stepZ = passZ == 0 ? sideZ : -sideZ;
+
+                                for (int dz = passZ; dz <= radius; dz++) {
+                                    int zi = zr + dz * stepZ;
+                                    float axisZ = (float)(zi - z);
+                                    if (boundXY + CellularAxisBound<DistanceFunction>(axisZ, boundJitter) >
+                                        (needsDistance1 ? distance1 : distance0))
+                                        break;
+
+                                    ENTROPY_CELLULAR_VISIT();
+
+                                    int hash = Hash(seed, xPrimed, yPrimed, zi * PrimeZ);
+                                    int idx = hash & (255 << 2);
+
+                                    float vecX = axisX + Lookup<float>::RandVecs3D[idx] * cellularJitter;
+                                    float vecY = axisY + Lookup<float>::RandVecs3D[idx | 1] * cellularJitter;
+                                    float vecZ = axisZ + Lookup<float>::RandVecs3D[idx | 2] * cellularJitter;
+
+                                    float newDistance = CellularDistance<DistanceFunction>(vecX, vecY, vecZ);
+
+                                    distance1 = FastMax(FastMin(distance1, newDistance), distance0);
+                                    if (newDistance < distance0) {
+                                        distance0 = newDistance;
+                                        closestHash = hash;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // Cellular Grid Rows
+        // Feature points of a sliding window of 3 cell columns are kept while x moves along a row, so Hash and
+        // RandVecs lookups are paid once per cell instead of once per sample. Scan order matches SingleCellular.
+
+        void FillCellularColumn(int seed, int xi, int yr, float cellularJitter, float *offsetX, float *offsetY,
+                                int *hashes) const {
+            int xPrimed = xi * PrimeX;
+            unsigned yPrimed = (unsigned)(yr - 1) * (unsigned)PrimeY;
+
+            for (int r = 0; r < 3; r++) {
+                int hash = Hash(seed, xPrimed, (int)yPrimed);
+                int idx = hash & (255 << 1);
+
+                offsetX[r] = Lookup<float>::RandVecs2D[idx] * cellularJitter;
+                offsetY[r] = Lookup<float>::RandVecs2D[idx | 1] * cellularJitter;
+                hashes[r] = hash;
+                yPrimed += (unsigned)PrimeY;
+            }
+        }
+
+        void FillCellularColumn(int seed, int xi, int yr, int zr, float cellularJitter, float *offsetX,
+                                float *offsetY, float *offsetZ, int *hashes) const {
+            // Primed coordinates step in unsigned arithmetic, the products wrap and signed overflow would be undefined
+            int xPrimed = xi * PrimeX;
+            unsigned yPrimed = (unsigned)(yr - 1) * (unsigned)PrimeY;
+
+            for (int r = 0; r < 9; r += 3) {
+                unsigned zPrimed = (unsigned)(zr - 1) * (unsigned)PrimeZ;
+
+                for (int c = r; c < r + 3; c++) {
+                    int hash = Hash(seed, xPrimed, (int)yPrimed, (int)zPrimed);
+                    int idx = hash & (255 << 2);
+
+                    offsetX[c] = Lookup<float>::RandVecs3D[idx] * cellularJitter;
+                    offsetY[c] = Lookup<float>::RandVecs3D[idx | 1] * cellularJitter;
+                    offsetZ[c] = Lookup<float>::RandVecs3D[idx | 2] * cellularJitter;
+                    hashes[c] = hash;
+                    zPrimed += (unsigned)PrimeZ;
+                }
+                yPrimed += (unsigned)PrimeY;
+            }
+        }
+
+        template <CellularDistanceFunction DistanceFunction>
+        void CellularRow(int seed, const float *xs, float y, float *out, int count) const {
+            float cellularJitter = 0.43701595f * mCellularJitterModifier;
+            int yr = FastRound(y);
+
+            // [column][row] for columns windowX - 1 ... windowX + 1
+            float offsetX[3][3], offsetY[3][3];
+            int hashes[3][3];
+            int windowX = 0;
+
+            for (int i = 0; i < count; i++) {
+                float x = xs[i];
+                int xr = FastRound(x);
+
+                if (i == 0 || xr != windowX) {
+                    int shift = i == 0 ? 3 : xr - windowX;
+                    int first = 0, last = 2;
+
+                    if (shift == 1) {
+                        for (int r = 0; r < 3; r++) {
+                            offsetX[0][r] = offsetX[1][r], offsetX[1][r] = offsetX[2][r];
+                            offsetY[0][r] = offsetY[1][r], offsetY[1][r] = offsetY[2][r];
+                            hashes[0][r] = hashes[1][r], hashes[1][r] = hashes[2][r];
+                        }
+                        first = 2;
+                    } else if (shift == -1) {
+                        for (int r = 0; r < 3; r++) {
+                            offsetX[2][r] = offsetX[1][r], offsetX[1][r] = offsetX[0][r];
+                            offsetY[2][r] = offsetY[1][r], offsetY[1][r] = offsetY[0][r];
+                            hashes[2][r] = hashes[1][r], hashes[1][r] = hashes[0][r];
+                        }
+                        last = 0;
+                    }
+
+                    for (int c = first; c <= last; c++) {
+                        FillCellularColumn(seed, xr - 1 + c, yr, cellularJitter, offsetX[c], offsetY[c], hashes[c]);
+                    }
+                    windowX = xr;
+                }
+
+                float distance0 = 1e10f;
+                float distance1 = 1e10f;
+                int closestHash = 0;
+
+                for (int c = 0; c < 3; c++) {
+                    int xi = xr - 1 + c;
+
+                    for (int r = 0; r < 3; r++) {
+                        int yi = yr - 1 + r;
+
+                        float vecX = (float)(xi - x) + offsetX[c][r];
+                        float vecY = (float)(yi - y) + offsetY[c][r];
+
+                        float newDistance = CellularDistance<DistanceFunction>(vecX, vecY);
+
+                        distance1 = FastMax(FastMin(distance1, newDistance), distance0);
+                        if (newDistance < distance0) {
+                            distance0 = newDistance;
+                            closestHash = hashes[c][r];
+                        }
+                    }
+                }
+
+                out[i] = CellularReturn(distance0, distance1, closestHash);
+            }
+        }
+
+        template <CellularDistanceFunction DistanceFunction>
+        void CellularRow(int seed, const float *xs, float y, float z, float *out, int count) const {
+            float cellularJitter = 0.39614353f * mCellularJitterModifier;
+            int yr = FastRound(y);
+            int zr = FastRound(z);
+
+            // [column][row] for columns windowX - 1 ... windowX + 1, rows are (y, z) pairs with z innermost
+            float offsetX[3][9], offsetY[3][9], offsetZ[3][9];
+            int hashes[3][9];
+            int windowX = 0;
+
+            for (int i = 0; i < count; i++) {
+                float x = xs[i];
+                int xr = FastRound(x);
+
+                if (i == 0 || xr != windowX) {
+                    int shift = i == 0 ? 3 : xr - windowX;
+                    int first = 0, last = 2;
+
+                    if (shift == 1) {
+                        for (int r = 0; r < 9; r++) {
+                            offsetX[0][r] = offsetX[1][r], offsetX[1][r] = offsetX[2][r];
+                            offsetY[0][r] = offsetY[1][r], offsetY[1][r] = offsetY[2][r];
+                            offsetZ[0][r] = offsetZ[1][r], offsetZ[1][r] = offsetZ[2][r];
+                            hashes[0][r] = hashes[1][r], hashes[1][r] = hashes[2][r];
+                        }
+                        first = 2;
+                    } else if (shift == -1) {
+                        for (int r = 0; r < 9; r++) {
+                            offsetX[2][r] = offsetX[1][r], offsetX[1][r] = offsetX[0][r];
+                            offsetY[2][r] = offsetY[1][r], offsetY[1][r] = offsetY[0][r];
+                            offsetZ[2][r] = offsetZ[1][r], offsetZ[1][r] = offsetZ[0][r];
+                            hashes[2][r] = hashes[1][r], hashes[1][r] = hashes[0][r];
+                        }
+                        last = 0;
+                    }
+
+                    for (int c = first; c <= last; c++) {
+                        FillCellularColumn(seed, xr - 1 + c, yr, zr, cellularJitter, offsetX[c], offsetY[c],
+                                           offsetZ[c], hashes[c]);
+                    }
+                    windowX = xr;
+                }
+
+                float distance0 = 1e10f;
+                float distance1 = 1e10f;
+                int closestHash = 0;
+
+                for (int c = 0; c < 3; c++) {
+                    int xi = xr - 1 + c;
+
+                    for (int r = 0; r < 9; r++) {
+                        int yi = yr - 1 + r / 3;
+                        int zi = zr - 1 + r % 3;
+
+                        float vecX = (float)(xi - x) + offsetX[c][r];
+                        float vecY = (float)(yi - y) + offsetY[c][r];
+                        float vecZ = (float)(zi - z) + offsetZ[c][r];
+
+                        float newDistance = CellularDistance<DistanceFunction>(vecX, vecY, vecZ);
+
+                        distance1 = FastMax(FastMin(distance1, newDistance), distance0);
+                        if (newDistance < distance0) {
+                            distance0 = newDistance;
+                            closestHash = hashes[c][r];
+                        }
+                    }
+                }
+
+                out[i] = CellularReturn(distance0, distance1, closestHash);
+            }
+        }
+
+        // Cellular Multi-Output Query
+
+        template <CellularDistanceFunction DistanceFunction> static float CellularDistance(float vecX, float vecY) {
+            switch (DistanceFunction) {
+            case CellularDistanceFunction_Manhattan:
+                return FastAbs(vecX) + FastAbs(vecY);
+            case CellularDistanceFunction_Hybrid:
+                return (FastAbs(vecX) + FastAbs(vecY)) + (vecX * vecX + vecY * vecY);
+            default:
+                return vecX * vecX + vecY * vecY;
+            }
+        }
+
+        template <CellularDistanceFunction DistanceFunction>
+        static float CellularDistance(float vecX, float vecY, float vecZ) {
+            switch (DistanceFunction) {
+            case CellularDistanceFunction_Manhattan:
+                return FastAbs(vecX) + FastAbs(vecY) + FastAbs(vecZ);
+            case CellularDistanceFunction_Hybrid:
+                return (FastAbs(vecX) + FastAbs(vecY) + FastAbs(vecZ)) + (vecX * vecX + vecY * vecY + vecZ * vecZ);
+            default:
+                return vecX * vecX + vecY * vecY + vecZ * vecZ;
+            }
+        }
+
+        // Keeps the Count smallest distances sorted, returns true when newDistance is the new closest
+        template <int Count> static bool InsertCellularDistance(float *distance, float newDistance) {
+            if (!(newDistance < distance[Count - 1]))
+                return false;
+
+            int i = Count - 1;
+            for (; i > 0 && newDistance < distance[i - 1]; i--) {
+                distance[i] = distance[i - 1];
+            }
+            distance[i] = newDistance;
+            return i == 0;
+        }
+
+        template <int Count> void FinishCellularResult(CellularResult &result) const {
+            if (mCellularDistanceFunction == CellularDistanceFunction_Euclidean) {
+                for (int i = 0; i < Count; i++) {
+                    result.distance[i] = FastSqrt(result.distance[i]);
+                }
+            }
+            for (int i = Count; i < 4; i++) {
+                result.distance[i] = 0;
+            }
+            result.cellValue = result.closestHash * (1 / 2147483648.0f);
+        }
+
+        template <int Count, CellularDistanceFunction DistanceFunction, typename FNfloat>
+        void ScanCellularResult(int seed, FNfloat x, FNfloat y, CellularResult &result) const {
+            int xr = FastRound(x);
+            int yr = FastRound(y);
+
+            float cellularJitter = 0.43701595f * mCellularJitterModifier;
+
+            int xPrimed = (xr - 1) * PrimeX;
+            int yPrimedBase = (yr - 1) * PrimeY;
+
+            for (int xi = xr - 1; xi <= xr + 1; xi++) {
+                int yPrimed = yPrimedBase;
+
+                for (int yi = yr - 1; yi <= yr + 1; yi++) {
+                    int hash = Hash(seed, xPrimed, yPrimed);
+                    int idx = hash & (255 << 1);
+
+                    float offsetX = Lookup<float>::RandVecs2D[idx] * cellularJitter;
+                    float offsetY = Lookup<float>::RandVecs2D[idx | 1] * cellularJitter;
+                    float vecX = (float)(xi - x) + offsetX;
+                    float vecY = (float)(yi - y) + offsetY;
+
+                    if (InsertCellularDistance<Count>(result.distance,
+                                                      CellularDistance<DistanceFunction>(vecX, vecY))) {
+                        result.closestHash = hash;
+                        result.pointX = (float)xi + offsetX;
+                        result.pointY = (float)yi + offsetY;
+                    }
+                    yPrimed += PrimeY;
+                }
+                xPrimed += PrimeX;
+            }
+        }
+
+        template <int Count, CellularDistanceFunction DistanceFunction, typename FNfloat>
+        void ScanCellularResult(int seed, FNfloat x, FNfloat y, FNfloat z, CellularResult &result) const {
+            int xr = FastRound(x);
+            int yr = FastRound(y);
+            int zr = FastRound(z);
+
+            float cellularJitter = 0.39614353f * mCellularJitterModifier;
+
+            // Primed coordinates step in unsigned arithmetic, the products wrap and signed overflow would be undefined
+            unsigned xPrimed = (unsigned)(xr - 1) * (unsigned)PrimeX;
+            unsigned yPrimedBase = (unsigned)(yr - 1) * (unsigned)PrimeY;
+            unsigned zPrimedBase = (unsigned)(zr - 1) * (unsigned)PrimeZ;
+
+            for (int xi = xr - 1; xi <= xr + 1; xi++) {
+                unsigned yPrimed = yPrimedBase;
+
+                for (int yi = yr - 1; yi <= yr + 1; yi++) {
+                    unsigned zPrimed = zPrimedBase;
+
+                    for (int zi = zr - 1; zi <= zr + 1; zi++) {
+                        int hash = Hash(seed, (int)xPrimed, (int)yPrimed, (int)zPrimed);
+                        int idx = hash & (255 << 2);
+
+                        float offsetX = Lookup<float>::RandVecs3D[idx] * cellularJitter;
+                        float offsetY = Lookup<float>::RandVecs3D[idx | 1] * cellularJitter;
+                        float offsetZ = Lookup<float>::RandVecs3D[idx | 2] * cellularJitter;
+                        float vecX = (float)(xi - x) + offsetX;
+                        float vecY = (float)(yi - y) + offsetY;
+                        float vecZ = (float)(zi - z) + offsetZ;
+
+                        if (InsertCellularDistance<Count>(result.distance,
+                                                          CellularDistance<DistanceFunction>(vecX, vecY, vecZ))) {
+                            result.closestHash = hash;
+                            result.pointX = (float)xi + offsetX;
+                            result.pointY = (float)yi + offsetY;
+                            result.pointZ = (float)zi + offsetZ;
+                        }
+                        zPrimed += (unsigned)PrimeZ;
+                    }
+                    yPrimed += (unsigned)PrimeY;
+                }
+                xPrimed += (unsigned)PrimeX;
+            }
+        }
+
+        template <int Count, typename FNfloat>
+        void SingleCellularResult(int seed, FNfloat x, FNfloat y, CellularResult &result) const {
+            for (int i = 0; i < Count; i++) {
+                result.distance[i] = 1e10f;
+            }
+            result.closestHash = 0;
+            result.pointX = result.pointY = result.pointZ = 0;
+
+            switch (mCellularDistanceFunction) {
+            default:
+            case CellularDistanceFunction_Euclidean:
+            case CellularDistanceFunction_EuclideanSq:
+                ScanCellularResult<Count, CellularDistanceFunction_EuclideanSq>(seed, x, y, result);
+                break;
+            case CellularDistanceFunction_Manhattan:
+                ScanCellularResult<Count, CellularDistanceFunction_Manhattan>(seed, x, y, result);
+                break;
+            case CellularDistanceFunction_Hybrid:
+                ScanCellularResult<Count, CellularDistanceFunction_Hybrid>(seed, x, y, result);
+                break;
+            }
+
+            FinishCellularResult<Count>(result);
+        }
+
+        template <int Count, typename FNfloat>
+        void SingleCellularResult(int seed, FNfloat x, FNfloat y, FNfloat z, CellularResult &result) const {
+            for (int i = 0; i < Count; i++) {
+                result.distance[i] = 1e10f;
+            }
+            result.closestHash = 0;
+            result.pointX = result.pointY = result.pointZ = 0;
+
+            switch (mCellularDistanceFunction) {
+            default:
+            case CellularDistanceFunction_Euclidean:
+            case CellularDistanceFunction_EuclideanSq:
+                ScanCellularResult<Count, CellularDistanceFunction_EuclideanSq>(seed, x, y, z, result);
+                break;
+            case CellularDistanceFunction_Manhattan:
+                ScanCellularResult<Count, CellularDistanceFunction_Manhattan>(seed, x, y, z, result);
+                break;
+            case CellularDistanceFunction_Hybrid:
+                ScanCellularResult<Count, CellularDistanceFunction_Hybrid>(seed, x, y, z, result);
+                break;
+            }
+
+            FinishCellularResult<Count>(result);
+        }
+
+        // Cellular Point Enumeration
+        // Feature points are generated per lattice cell exactly as the cellular searches place them, then mapped back
+        // to input coordinates. Cell ranges cover the box grown by the largest jitter offset, points are tested
+        // against the box afterwards.
+
+        struct AppendCellularPoint {
+            std::vector<CellularPoint> &out;
+
+            void operator()(const CellularPoint &point) const { out.push_back(point); }
+        };
+
+        // Bounds in cellular space (frequency and rotation applied) of the input box grown by reach
+        void CellularBounds3D(TransformType3D transformType, float xMin, float yMin, float zMin, float xMax,
+                              float yMax, float zMax, float reach, float *low, float *high) const {
+            for (int axis = 0; axis < 3; axis++) {
+                low[axis] = 1e30f;
+                high[axis] = -1e30f;
+            }
+
+            for (int corner = 0; corner < 8; corner++) {
+                float c[3] = {(corner & 1 ? xMax : xMin) * mFrequency, (corner & 2 ? yMax : yMin) * mFrequency,
+                              (corner & 4 ? zMax : zMin) * mFrequency};
+                RotateCoordinate3D(transformType, c[0], c[1], c[2]);
+
+                for (int axis = 0; axis < 3; axis++) {
+                    low[axis] = FastMin(low[axis], c[axis] - reach);
+                    high[axis] = FastMax(high[axis], c[axis] + reach);
+                }
+            }
+        }
+
+        // Maps a point from cellular space back to input coordinates and reports it when inside the box
+        template <typename Callback>
+        void EmitCellularPoint(TransformType3D transformType, int hash, float xMin, float yMin, float zMin, float xMax,
+                               float yMax, float zMax, CellularPoint &point, Callback &callback) const {
+            InverseRotateCoordinate3D(transformType, point.x, point.y, point.z);
+            point.x /= mFrequency;
+            point.y /= mFrequency;
+            point.z /= mFrequency;
+
+            if (point.x >= xMin && point.x < xMax && point.y >= yMin && point.y < yMax && point.z >= zMin &&
+                point.z < zMax) {
+                point.hash = hash;
+                point.cellValue = hash * (1 / 2147483648.0f);
+                callback(point);
+            }
+        }
+
+        // Density Scattering
+        // Candidates are buffered until a full span can go through the density generator's array path. A candidate
+        // is kept when the high 23 bits of its hash, uniform in 0...1, fall below its keep probability. Bits 1 to 8
+        // already chose its jitter offset, so the two stay independent.
+
+        template <typename Callback> struct ScatterFilter {
+            const NoiseGen &density;
+            Callback &callback;
+            float low;
+            float scale;
+            int count = 0;
+            float xs[BatchSize];
+            float ys[BatchSize];
+            CellularPoint points[BatchSize];
+
+            ScatterFilter(const NoiseGen &density, Callback &callback, float low, float high)
+                : density(density), callback(callback), low(low), scale(high != low ? 1 / (high - low) : 1e30f) {}
+
+            void operator()(const CellularPoint &point) {
+                xs[count] = point.x;
+                ys[count] = point.y;
+                points[count] = point;
+                if (++count == BatchSize) {
+                    Flush();
+                }
+            }
+
+            void Flush() {
+                float noise[BatchSize];
+                density.GetNoiseArray2D(xs, ys, noise, count);
+
+                for (int i = 0; i < count; i++) {
+                    float probability = (noise[i] - low) * scale;
+                    float threshold = (float)((uint32_t)points[i].hash >> 9) * (1 / 8388608.0f);
+                    if (threshold < probability) {
+                        callback(points[i]);
+                    }
+                }
+                count = 0;
+            }
+        };
+
+        // Perlin Noise
+
+        template <typename FNfloat> float SinglePerlin(int seed, FNfloat x, FNfloat y) const {
+            int x0 = FastFloor(x);
+            int y0 = FastFloor(y);
+
+            float xd0 = (float)(x - x0);
+            float yd0 = (float)(y - y0);
+            float xd1 = xd0 - 1;
+            float yd1 = yd0 - 1;
+
+            float xs = InterpQuintic(xd0);
+            float ys = InterpQuintic(yd0);
+
+            x0 *= PrimeX;
+            y0 *= PrimeY;
+            int x1 = x0 + PrimeX;
+            int y1 = y0 + PrimeY;
+
+            float xf0 = Lerp(GradCoord(seed, x0, y0, xd0, yd0), GradCoord(seed, x1, y0, xd1, yd0), xs);
+            float xf1 = Lerp(GradCoord(seed, x0, y1, xd0, yd1), GradCoord(seed, x1, y1, xd1, yd1), xs);
+
+            return Lerp(xf0, xf1, ys) * 1.4247691104677813f;
+        }
+
+        template <typename FNfloat> float SinglePerlin(int seed, FNfloat x, FNfloat y, FNfloat z) const {
+            int x0 = FastFloor(x);
+            int y0 = FastFloor(y);
+            int z0 = FastFloor(z);
+
+            float xd0 = (float)(x - x0);
+            float yd0 = (float)(y - y0);
+            float zd0 = (float)(z - z0);
+            float xd1 = xd0 - 1;
+            float yd1 = yd0 - 1;
+            float zd1 = zd0 - 1;
+
+            float xs = InterpQuintic(xd0);
+            float ys = InterpQuintic(yd0);
+            float zs = InterpQuintic(zd0);
+
+            x0 *= PrimeX;
+            y0 *= PrimeY;
+            z0 *= PrimeZ;
+            int x1 = x0 + PrimeX;
+            int y1 = y0 + PrimeY;
+            int z1 = z0 + PrimeZ;
+
+            float xf00 =
+                Lerp(GradCoord(seed, x0, y0, z0, xd0, yd0, zd0), GradCoord(seed, x1, y0, z0, xd1, yd0, zd0), xs);
+            float xf10 =
+                Lerp(GradCoord(seed, x0, y1, z0, xd0, yd1, zd0), GradCoord(seed, x1, y1, z0, xd1, yd1, zd0), xs);
+            float xf01 =
+                Lerp(GradCoord(seed, x0, y0, z1, xd0, yd0, zd1), GradCoord(seed, x1, y0, z1, xd1, yd0, zd1), xs);
+            float xf11 =
+                Lerp(GradCoord(seed, x0, y1, z1, xd0, yd1, zd1), GradCoord(seed, x1, y1, z1, xd1, yd1, zd1), xs);
+
+            float yf0 = Lerp(xf00, xf10, ys);
+            float yf1 = Lerp(xf01, xf11, ys);
+
+            return Lerp(yf0, yf1, zs) * 0.964921414852142333984375f;
+        }
+
+        // Value Cubic Noise
+
+        template <typename FNfloat> float SingleValueCubic(int seed, FNfloat x, FNfloat y) const {
+            int x1 = FastFloor(x);
+            int y1 = FastFloor(y);
+
+            float xs = (float)(x - x1);
+            float ys = (float)(y - y1);
+
+            x1 *= PrimeX;
+            y1 *= PrimeY;
+            int x0 = x1 - PrimeX;
+            int y0 = y1 - PrimeY;
+            int x2 = x1 + PrimeX;
+            int y2 = y1 + PrimeY;
+            int x3 = x1 + (int)((long)PrimeX << 1);
+            int y3 = y1 + (int)((long)PrimeY << 1);
+
+            return CubicLerp(CubicLerp(ValCoord(seed, x0, y0), ValCoord(seed, x1, y0), ValCoord(seed, x2, y0),
+                                       ValCoord(seed, x3, y0), xs),
+                             CubicLerp(ValCoord(seed, x0, y1), ValCoord(seed, x1, y1), ValCoord(seed, x2, y1),
+                                       ValCoord(seed, x3, y1), xs),
+                             CubicLerp(ValCoord(seed, x0, y2), ValCoord(seed, x1, y2), ValCoord(seed, x2, y2),
+                                       ValCoord(seed, x3, y2), xs),
+                             CubicLerp(ValCoord(seed, x0, y3), ValCoord(seed, x1, y3), ValCoord(seed, x2, y3),
+                                       ValCoord(seed, x3, y3), xs),
+                             ys) *
+                   (1 / (1.5f * 1.5f));
+        }
+
+        template <typename FNfloat> float SingleValueCubic(int seed, FNfloat x, FNfloat y, FNfloat z) const {
+            int x1 = FastFloor(x);
+            int y1 = FastFloor(y);
+            int z1 = FastFloor(z);
+
+            float xs = (float)(x - x1);
+            float ys = (float)(y - y1);
+            float zs = (float)(z - z1);
+
+            x1 *= PrimeX;
+            y1 *= PrimeY;
+            z1 *= PrimeZ;
+
+            int x0 = x1 - PrimeX;
+            int y0 = y1 - PrimeY;
+            int z0 = z1 - PrimeZ;
+            int x2 = x1 + PrimeX;
+            int y2 = y1 + PrimeY;
+            int z2 = z1 + PrimeZ;
+            int x3 = x1 + (int)((long)PrimeX << 1);
+            int y3 = y1 + (int)((long)PrimeY << 1);
+            int z3 = z1 + (int)((long)PrimeZ << 1);
+
+            return CubicLerp(CubicLerp(CubicLerp(ValCoord(seed, x0, y0, z0), ValCoord(seed, x1, y0, z0),
+                                                 ValCoord(seed, x2, y0, z0), ValCoord(seed, x3, y0, z0), xs),
+                                       CubicLerp(ValCoord(seed, x0, y1, z0), ValCoord(seed, x1, y1, z0),
+                                                 ValCoord(seed, x2, y1, z0), ValCoord(seed, x3, y1, z0), xs),
+                                       CubicLerp(ValCoord(seed, x0, y2, z0), ValCoord(seed, x1, y2, z0),
+                                                 ValCoord(seed, x2, y2, z0), ValCoord(seed, x3, y2, z0), xs),
+                                       CubicLerp(ValCoord(seed, x0, y3, z0), ValCoord(seed, x1, y3, z0),
+                                                 ValCoord(seed, x2, y3, z0), ValCoord(seed, x3, y3, z0), xs),
+                                       ys),
+                             CubicLerp(CubicLerp(ValCoord(seed, x0, y0, z1), ValCoord(seed, x1, y0, z1),
+                                                 ValCoord(seed, x2, y0, z1), ValCoord(seed, x3, y0, z1), xs),
+                                       CubicLerp(ValCoord(seed, x0, y1, z1), ValCoord(seed, x1, y1, z1),
+                                                 ValCoord(seed, x2, y1, z1), ValCoord(seed, x3, y1, z1), xs),
+                                       CubicLerp(ValCoord(seed, x0, y2, z1), ValCoord(seed, x1, y2, z1),
+                                                 ValCoord(seed, x2, y2, z1), ValCoord(seed, x3, y2, z1), xs),
+                                       CubicLerp(ValCoord(seed, x0, y3, z1), ValCoord(seed, x1, y3, z1),
+                                                 ValCoord(seed, x2, y3, z1), ValCoord(seed, x3, y3, z1), xs),
+                                       ys),
+                             CubicLerp(CubicLerp(ValCoord(seed, x0, y0, z2), ValCoord(seed, x1, y0, z2),
+                                                 ValCoord(seed, x2, y0, z2), ValCoord(seed, x3, y0, z2), xs),
+                                       CubicLerp(ValCoord(seed, x0, y1, z2), ValCoord(seed, x1, y1, z2),
+                                                 ValCoord(seed, x2, y1, z2), ValCoord(seed, x3, y1, z2), xs),
+                                       CubicLerp(ValCoord(seed, x0, y2, z2), ValCoord(seed, x1, y2, z2),
+                                                 ValCoord(seed, x2, y2, z2), ValCoord(seed, x3, y2, z2), xs),
+                                       CubicLerp(ValCoord(seed, x0, y3, z2), ValCoord(seed, x1, y3, z2),
+                                                 ValCoord(seed, x2, y3, z2), ValCoord(seed, x3, y3, z2), xs),
+                                       ys),
+                             CubicLerp(CubicLerp(ValCoord(seed, x0, y0, z3), ValCoord(seed, x1, y0, z3),
+                                                 ValCoord(seed, x2, y0, z3), ValCoord(seed, x3, y0, z3), xs),
+                                       CubicLerp(ValCoord(seed, x0, y1, z3), ValCoord(seed, x1, y1, z3),
+                                                 ValCoord(seed, x2, y1, z3), ValCoord(seed, x3, y1, z3), xs),
+                                       CubicLerp(ValCoord(seed, x0, y2, z3), ValCoord(seed, x1, y2, z3),
+                                                 ValCoord(seed, x2, y2, z3), ValCoord(seed, x3, y2, z3), xs),
+                                       CubicLerp(ValCoord(seed, x0, y3, z3), ValCoord(seed, x1, y3, z3),
+                                                 ValCoord(seed, x2, y3, z3), ValCoord(seed, x3, y3, z3), xs),
+                                       ys),
+                             zs) *
+                   (1 / (1.5f * 1.5f * 1.5f));
+        }
+
+        // Value Noise
+
+        template <typename FNfloat> float SingleValue(int seed, FNfloat x, FNfloat y) const {
+            int x0 = FastFloor(x);
+            int y0 = FastFloor(y);
+
+            float xs = InterpHermite((float)(x - x0));
+            float ys = InterpHermite((float)(y - y0));
+
+            x0 *= PrimeX;
+            y0 *= PrimeY;
+            int x1 = x0 + PrimeX;
+            int y1 = y0 + PrimeY;
+
+            float xf0 = Lerp(ValCoord(seed, x0, y0), ValCoord(seed, x1, y0), xs);
+            float xf1 = Lerp(ValCoord(seed, x0, y1), ValCoord(seed, x1, y1), xs);
+
+            return Lerp(xf0, xf1, ys);
+        }
+
+        template <typename FNfloat> float SingleValue(int seed, FNfloat x, FNfloat y, FNfloat z) const {
+            int x0 = FastFloor(x);
+            int y0 = FastFloor(y);
+            int z0 = FastFloor(z);
+
+            float xs = InterpHermite((float)(x - x0));
+            float ys = InterpHermite((float)(y - y0));
+            float zs = InterpHermite((float)(z - z0));
+
+            x0 *= PrimeX;
+            y0 *= PrimeY;
+            z0 *= PrimeZ;
+            int x1 = x0 + PrimeX;
+            int y1 = y0 + PrimeY;
+            int z1 = z0 + PrimeZ;
+
+            float xf00 = Lerp(ValCoord(seed, x0, y0, z0), ValCoord(seed, x1, y0, z0), xs);
+            float xf10 = Lerp(ValCoord(seed, x0, y1, z0), ValCoord(seed, x1, y1, z0), xs);
+            float xf01 = Lerp(ValCoord(seed, x0, y0, z1), ValCoord(seed, x1, y0, z1), xs);
+            float xf11 = Lerp(ValCoord(seed, x0, y1, z1), ValCoord(seed, x1, y1, z1), xs);
+
+            float yf0 = Lerp(xf00, xf10, ys);
+            float yf1 = Lerp(xf01, xf11, ys);
+
+            return Lerp(yf0, yf1, zs);
+        }
+
+        // Approximate Kernels
+        // Used instead of the exact kernels when SetApproximateMath is enabled. Lattice hashing is unchanged, only the
+        // interpolation arithmetic is cheaper. Cellular distances keep sqrtf, a reciprocal square root estimate with a
+        // Newton step measured slower than the hardware square root.
+
+        // CubicLerp(a, b, c, d, t) as weights of a, b, c and d, including the 1 / 1.5 output scale
+        static void CubicWeights(float t, float *w) {
+            const float scale = 1 / 1.5f;
+            w[0] = t * (t * (2 - t) - 1) * scale;
+            w[1] = (t * t * (t - 2) + 1) * scale;
+            w[2] = t * (t * (1 - t) + 1) * scale;
+            w[3] = t * t * (t - 1) * scale;
+        }
+
+        // Lattice values of one x column blended with the y (and z) weights, the x weights are applied last. The
+        // Approx kernels spell out the same sums so rows built on these match them exactly
+        static float BlendColumn(const float *column, const float *wy) {
+            return wy[0] * column[0] + wy[1] * column[1] + wy[2] * column[2] + wy[3] * column[3];
+        }
+
+        static float BlendColumn(const float *column, const float *wy, const float *wz) {
+            return wz[0] * BlendColumn(column, wy) + wz[1] * BlendColumn(column + 4, wy) +
+                   wz[2] * BlendColumn(column + 8, wy) + wz[3] * BlendColumn(column + 12, wy);
+        }
+
+        // Primed lattice coordinates of the four cubic taps around the primed cell coordinate p1
+        static void LatticeTaps(int p1, int prime, int *p) {
+            p[0] = p1 - prime;
+            p[1] = p1;
+            p[2] = p1 + prime;
+            p[3] = p1 + (int)((long)prime << 1);
+        }
+
+        template <typename FNfloat> float SinglePerlinApprox(int seed, FNfloat x, FNfloat y) const {
+            int x0 = FastFloor(x);
+            int y0 = FastFloor(y);
+
+            float xd0 = (float)(x - x0);
+            float yd0 = (float)(y - y0);
+            float xd1 = xd0 - 1;
+            float yd1 = yd0 - 1;
+
+            float xs = InterpHermite(xd0);
+            float ys = InterpHermite(yd0);
+
+            x0 *= PrimeX;
+            y0 *= PrimeY;
+            int x1 = x0 + PrimeX;
+            int y1 = y0 + PrimeY;
+
+            float xf0 = Lerp(GradCoord(seed, x0, y0, xd0, yd0), GradCoord(seed, x1, y0, xd1, yd0), xs);
+            float xf1 = Lerp(GradCoord(seed, x0, y1, xd0, yd1), GradCoord(seed, x1, y1, xd1, yd1), xs);
+
+            return Lerp(xf0, xf1, ys) * 1.4247691104677813f;
+        }
+
+        template <typename FNfloat> float SinglePerlinApprox(int seed, FNfloat x, FNfloat y, FNfloat z) const {
+            int x0 = FastFloor(x);
+            int y0 = FastFloor(y);
+            int z0 = FastFloor(z);
+
+            float xd0 = (float)(x - x0);
+            float yd0 = (float)(y - y0);
+            float zd0 = (float)(z - z0);
+            float xd1 = xd0 - 1;
+            float yd1 = yd0 - 1;
+            float zd1 = zd0 - 1;
+
+            float xs = InterpHermite(xd0);
+            float ys = InterpHermite(yd0);
+            float zs = InterpHermite(zd0);
+
+            x0 *= PrimeX;
+            y0 *= PrimeY;
+            z0 *= PrimeZ;
+            int x1 = x0 + PrimeX;
+            int y1 = y0 + PrimeY;
+            int z1 = z0 + PrimeZ;
+
+            float xf00 =
+                Lerp(GradCoord(seed, x0, y0, z0, xd0, yd0, zd0), GradCoord(seed, x1, y0, z0, xd1, yd0, zd0), xs);
+            float xf10 =
+                Lerp(GradCoord(seed, x0, y1, z0, xd0, yd1, zd0), GradCoord(seed, x1, y1, z0, xd1, yd1, zd0), xs);
+            float xf01 =
+                Lerp(GradCoord(seed, x0, y0, z1, xd0, yd0, zd1), GradCoord(seed, x1, y0, z1, xd1, yd0, zd1), xs);
+            float xf11 =
+                Lerp(GradCoord(seed, x0, y1, z1, xd0, yd1, zd1), GradCoord(seed, x1, y1, z1, xd1, yd1, zd1), xs);
+
+            float yf0 = Lerp(xf00, xf10, ys);
+            float yf1 = Lerp(xf01, xf11, ys);
+
+            return Lerp(yf0, yf1, zs) * 0.964921414852142333984375f;
+        }
+
+        template <typename FNfloat> float SingleValueCubicApprox(int seed, FNfloat x, FNfloat y) const {
+            int x1 = FastFloor(x);
+            int y1 = FastFloor(y);
+
+            float wx[4];
+            float wy[4];
+            CubicWeights((float)(x - x1), wx);
+            CubicWeights((float)(y - y1), wy);
+
+            int xp[4];
+            int yp[4];
+            LatticeTaps(x1 * PrimeX, PrimeX, xp);
+            LatticeTaps(y1 * PrimeY, PrimeY, yp);
+
+            float blended[4];
+            for (int i = 0; i < 4; i++) {
+                blended[i] = wy[0] * ValCoord(seed, xp[i], yp[0]) + wy[1] * ValCoord(seed, xp[i], yp[1]) +
+                             wy[2] * ValCoord(seed, xp[i], yp[2]) + wy[3] * ValCoord(seed, xp[i], yp[3]);
             }
+            return wx[0] * blended[0] + wx[1] * blended[1] + wx[2] * blended[2] + wx[3] * blended[3];
         }
 
-        void UpdateTransformType3D() {
-            switch (mRotationType3D) {
-            case RotationType3D_ImproveXYPlanes:
-                mTransformType3D = TransformType3D_ImproveXYPlanes;
-                break;
-            case RotationType3D_ImproveXZPlanes:
-                mTransformType3D = TransformType3D_ImproveXZPlanes;
-                break;
-            default:
-                switch (mNoiseType) {
-                case NoiseType_OpenSimplex2:
-                case NoiseType_OpenSimplex2S:
-                    mTransformType3D = TransformType3D_DefaultOpenSimplex2;
-                    break;
-                default:
-                    mTransformType3D = TransformType3D_None;
-                    break;
+        template <typename FNfloat> float SingleValueCubicApprox(int seed, FNfloat x, FNfloat y, FNfloat z) const {
+            int x1 = FastFloor(x);
+            int y1 = FastFloor(y);
+            int z1 = FastFloor(z);
+
+            float wx[4];
+            float wy[4];
+            float wz[4];
+            CubicWeights((float)(x - x1), wx);
+            CubicWeights((float)(y - y1), wy);
+            CubicWeights((float)(z - z1), wz);
+
+            int xp[4];
+            int yp[4];
+            int zp[4];
+            LatticeTaps(x1 * PrimeX, PrimeX, xp);
+            LatticeTaps(y1 * PrimeY, PrimeY, yp);
+            LatticeTaps(z1 * PrimeZ, PrimeZ, zp);
+
+            float blended[4];
+            for (int i = 0; i < 4; i++) {
+                float plane[4];
+                for (int k = 0; k < 4; k++) {
+                    plane[k] = wy[0] * ValCoord(seed, xp[i], yp[0], zp[k]) +
+                               wy[1] * ValCoord(seed, xp[i], yp[1], zp[k]) +
+                               wy[2] * ValCoord(seed, xp[i], yp[2], zp[k]) +
+                               wy[3] * ValCoord(seed, xp[i], yp[3], zp[k]);
                 }
-                break;
+                blended[i] = wz[0] * plane[0] + wz[1] * plane[1] + wz[2] * plane[2] + wz[3] * plane[3];
             }
+            return wx[0] * blended[0] + wx[1] * blended[1] + wx[2] * blended[2] + wx[3] * blended[3];
         }
 
-        // Domain Warp Coordinate Transforms
+        // Noise Gradients
+        // Value and noise derivative with respect to the (transformed) position, the value matches the Single kernel
 
-        template <typename FNfloat> void TransformDomainWarpCoordinate(FNfloat &x, FNfloat &y) const {
-            switch (mDomainWarpType) {
-            case DomainWarpType_OpenSimplex2:
-            case DomainWarpType_OpenSimplex2Reduced: {
-                const FNfloat SQRT3 = (FNfloat)1.7320508075688772935274463415059;
-                const FNfloat F2 = 0.5f * (SQRT3 - 1);
-                FNfloat t = (x + y) * F2;
-                x += t;
-                y += t;
-            } break;
-            default:
-                break;
-            }
+        float SingleValueGradient(int seed, float x, float y, float &dx, float &dy) const {
+            int x0 = FastFloor(x);
+            int y0 = FastFloor(y);
+
+            float xd = x - x0;
+            float yd = y - y0;
+            float xs = InterpHermite(xd);
+            float ys = InterpHermite(yd);
+
+            x0 *= PrimeX;
+            y0 *= PrimeY;
+            int x1 = x0 + PrimeX;
+            int y1 = y0 + PrimeY;
+
+            float v00 = ValCoord(seed, x0, y0);
+            float v10 = ValCoord(seed, x1, y0);
+            float v01 = ValCoord(seed, x0, y1);
+            float v11 = ValCoord(seed, x1, y1);
+            float xf0 = Lerp(v00, v10, xs);
+            float xf1 = Lerp(v01, v11, xs);
+
+            dx = Lerp(v10 - v00, v11 - v01, ys) * (6 * xd * (1 - xd));
+            dy = (xf1 - xf0) * (6 * yd * (1 - yd));
+            return Lerp(xf0, xf1, ys);
         }
 
-        template <typename FNfloat> void TransformDomainWarpCoordinate(FNfloat &x, FNfloat &y, FNfloat &z) const {
-            switch (mWarpTransformType3D) {
-            case TransformType3D_ImproveXYPlanes: {
-                FNfloat xy = x + y;
-                FNfloat s2 = xy * -(FNfloat)0.211324865405187;
-                z *= (FNfloat)0.577350269189626;
-                x += s2 - z;
-                y = y + s2 - z;
-                z += xy * (FNfloat)0.577350269189626;
-            } break;
-            case TransformType3D_ImproveXZPlanes: {
-                FNfloat xz = x + z;
-                FNfloat s2 = xz * -(FNfloat)0.211324865405187;
-                y *= (FNfloat)0.577350269189626;
-                x += s2 - y;
-                z += s2 - y;
-                y += xz * (FNfloat)0.577350269189626;
-            } break;
-            case TransformType3D_DefaultOpenSimplex2: {
-                const FNfloat R3 = (FNfloat)(2.0 / 3.0);
-                FNfloat r = (x + y + z) * R3; // Rotation, not skew
-                x = r - x;
-                y = r - y;
-                z = r - z;
-            } break;
-            default:
-                break;
-            }
+        float SinglePerlinGradient(int seed, float x, float y, float &dx, float &dy) const {
+            const float SCALE = 1.4247691104677813f;
+            int x0 = FastFloor(x);
+            int y0 = FastFloor(y);
+
+            float xd0 = x - x0;
+            float yd0 = y - y0;
+            float xd1 = xd0 - 1;
+            float yd1 = yd0 - 1;
+
+            float xs = InterpQuintic(xd0);
+            float ys = InterpQuintic(yd0);
+            float xsd = 30 * xd0 * xd0 * xd1 * xd1;
+            float ysd = 30 * yd0 * yd0 * yd1 * yd1;
+
+            x0 *= PrimeX;
+            y0 *= PrimeY;
+            int x1 = x0 + PrimeX;
+            int y1 = y0 + PrimeY;
+
+            float gx00, gy00, gx10, gy10, gx01, gy01, gx11, gy11;
+            Gradient2D(seed, x0, y0, gx00, gy00);
+            Gradient2D(seed, x1, y0, gx10, gy10);
+            Gradient2D(seed, x0, y1, gx01, gy01);
+            Gradient2D(seed, x1, y1, gx11, gy11);
+
+            float a00 = xd0 * gx00 + yd0 * gy00;
+            float a10 = xd1 * gx10 + yd0 * gy10;
+            float a01 = xd0 * gx01 + yd1 * gy01;
+            float a11 = xd1 * gx11 + yd1 * gy11;
+
+            float xf0 = Lerp(a00, a10, xs);
+            float xf1 = Lerp(a01, a11, xs);
+
+            float dxf0 = Lerp(gx00, gx10, xs) + xsd * (a10 - a00);
+            float dxf1 = Lerp(gx01, gx11, xs) + xsd * (a11 - a01);
+            float dyf0 = Lerp(gy00, gy10, xs);
+            float dyf1 = Lerp(gy01, gy11, xs);
+
+            dx = Lerp(dxf0, dxf1, ys) * SCALE;
+            dy = (Lerp(dyf0, dyf1, ys) + ysd * (xf1 - xf0)) * SCALE;
+            return Lerp(xf0, xf1, ys) * SCALE;
         }
 
-        void UpdateWarpTransformType3D() {
-            switch (mRotationType3D) {
-            case RotationType3D_ImproveXYPlanes:
-                mWarpTransformType3D = TransformType3D_ImproveXYPlanes;
-                break;
-            case RotationType3D_ImproveXZPlanes:
-                mWarpTransformType3D = TransformType3D_ImproveXZPlanes;
-                break;
-            default:
-                switch (mDomainWarpType) {
-                case DomainWarpType_OpenSimplex2:
-                case DomainWarpType_OpenSimplex2Reduced:
-                    mWarpTransformType3D = TransformType3D_DefaultOpenSimplex2;
-                    break;
-                default:
-                    mWarpTransformType3D = TransformType3D_None;
-                    break;
-                }
-                break;
-            }
+        static void Gradient2D(int seed, int xPrimed, int yPrimed, float &xg, float &yg) {
+            int hash = Hash(seed, xPrimed, yPrimed);
+            hash ^= hash >> 15;
+            hash &= 127 << 1;
+
+            xg = Lookup<float>::Gradients2D[hash];
+            yg = Lookup<float>::Gradients2D[hash | 1];
         }
 
-        // Fractal FBm
+        // 1D Noise
 
-        template <typename FNfloat> float GenFractalFBm(FNfloat x, FNfloat y) const {
-            int seed = mSeed;
-            float sum = 0;
-            float amp = mFractalBounding;
+        template <typename FNfloat> float SinglePerlin(int seed, FNfloat x) const {
+            int x0 = FastFloor(x);
 
-            for (int i = 0; i < mOctaves; i++) {
-                float noise = GenNoiseSingle(seed++, x, y);
-                sum += noise * amp;
-                amp *= Lerp(1.0f, FastMin(noise + 1, 2) * 0.5f, mWeightedStrength);
+            float xd0 = (float)(x - x0);
+            float xd1 = xd0 - 1;
 
-                x *= mLacunarity;
-                y *= mLacunarity;
-                amp *= mGain;
-            }
+            float xs = InterpQuintic(xd0);
 
-            return sum;
+            x0 *= PrimeX;
+            int x1 = x0 + PrimeX;
+
+            return Lerp(GradCoord(seed, x0, xd0), GradCoord(seed, x1, xd1), xs) * 2.0f;
         }
 
-        template <typename FNfloat> float GenFractalFBm(FNfloat x, FNfloat y, FNfloat z) const {
-            int seed = mSeed;
-            float sum = 0;
-            float amp = mFractalBounding;
+        template <typename FNfloat> float SingleValueCubic(int seed, FNfloat x) const {
+            int x1 = FastFloor(x);
 
-            for (int i = 0; i < mOctaves; i++) {
-                float noise = GenNoiseSingle(seed++, x, y, z);
-                sum += noise * amp;
-                amp *= Lerp(1.0f, (noise + 1) * 0.5f, mWeightedStrength);
+            float xs = (float)(x - x1);
 
-                x *= mLacunarity;
-                y *= mLacunarity;
-                z *= mLacunarity;
-                amp *= mGain;
-            }
+            x1 *= PrimeX;
+            int x0 = x1 - PrimeX;
+            int x2 = x1 + PrimeX;
+            int x3 = x1 + (int)((long)PrimeX << 1);
 
-            return sum;
+            return CubicLerp(ValCoord(seed, x0), ValCoord(seed, x1), ValCoord(seed, x2), ValCoord(seed, x3), xs) *
+                   (1 / 1.5f);
         }
 
-        // Fractal Ridged
-
-        template <typename FNfloat> float GenFractalRidged(FNfloat x, FNfloat y) const {
-            int seed = mSeed;
-            float sum = 0;
-            float amp = mFractalBounding;
+        template <typename FNfloat> float SingleValue(int seed, FNfloat x) const {
+            int x0 = FastFloor(x);
 
-            for (int i = 0; i < mOctaves; i++) {
-                float noise = FastAbs(GenNoiseSingle(seed++, x, y));
-                sum += (noise * -2 + 1) * amp;
-                amp *= Lerp(1.0f, 1 - noise, mWeightedStrength);
+            float xs = InterpHermite((float)(x - x0));
 
-                x *= mLacunarity;
-                y *= mLacunarity;
-                amp *= mGain;
-            }
+            x0 *= PrimeX;
+            int x1 = x0 + PrimeX;
 
-            return sum;
+            return Lerp(ValCoord(seed, x0), ValCoord(seed, x1), xs);
         }
 
-        template <typename FNfloat> float GenFractalRidged(FNfloat x, FNfloat y, FNfloat z) const {
-            int seed = mSeed;
-            float sum = 0;
-            float amp = mFractalBounding;
+        // 1D Noise Streams
+        // Consecutive stream samples mostly share a lattice cell, so the hashed values around the current cell are
+        // kept and only refreshed when a sample leaves it, shifting them along when it moves to a neighbour cell.
+        // Per sample arithmetic is the same as the Single kernels above.
 
-            for (int i = 0; i < mOctaves; i++) {
-                float noise = FastAbs(GenNoiseSingle(seed++, x, y, z));
-                sum += (noise * -2 + 1) * amp;
-                amp *= Lerp(1.0f, 1 - noise, mWeightedStrength);
+        void StreamPerlin(int seed, const double *xs, float *out, int count) const {
+            int cell = FastFloor(xs[0]);
+            float g0 = Gradient1D(seed, cell * PrimeX);
+            float g1 = Gradient1D(seed, cell * PrimeX + PrimeX);
 
-                x *= mLacunarity;
-                y *= mLacunarity;
-                z *= mLacunarity;
-                amp *= mGain;
+            for (int i = 0; i < count; i++) {
+                int x0 = FastFloor(xs[i]);
+
+                if (x0 != cell) {
+                    int x0Primed = x0 * PrimeX;
+                    g0 = x0 == cell + 1 ? g1 : Gradient1D(seed, x0Primed);
+                    g1 = Gradient1D(seed, x0Primed + PrimeX);
+                    cell = x0;
+                }
+
+                float xd0 = (float)(xs[i] - x0);
+                float xd1 = xd0 - 1;
+
+                out[i] = Lerp(xd0 * g0, xd1 * g1, InterpQuintic(xd0)) * 2.0f;
             }
+        }
 
-            return sum;
+        void StreamValueCubic(int seed, const double *xs, float *out, int count) const {
+            int cell = FastFloor(xs[0]) - 2;
+            float v0 = 0, v1 = 0, v2 = 0, v3 = 0;
+
+            for (int i = 0; i < count; i++) {
+                int x1 = FastFloor(xs[i]);
+
+                if (x1 != cell) {
+                    int x1Primed = x1 * PrimeX;
+                    if (x1 == cell + 1) {
+                        v0 = v1;
+                        v1 = v2;
+                        v2 = v3;
+                    } else {
+                        v0 = ValCoord(seed, x1Primed - PrimeX);
+                        v1 = ValCoord(seed, x1Primed);
+                        v2 = ValCoord(seed, x1Primed + PrimeX);
+                    }
+                    v3 = ValCoord(seed, x1Primed + (int)((long)PrimeX << 1));
+                    cell = x1;
+                }
+
+                out[i] = CubicLerp(v0, v1, v2, v3, (float)(xs[i] - x1)) * (1 / 1.5f);
+            }
         }
 
-        // Fractal PingPong
+        void StreamValue(int seed, const double *xs, float *out, int count) const {
+            int cell = FastFloor(xs[0]);
+            float v0 = ValCoord(seed, cell * PrimeX);
+            float v1 = ValCoord(seed, cell * PrimeX + PrimeX);
 
-        template <typename FNfloat> float GenFractalPingPong(FNfloat x, FNfloat y) const {
-            int seed = mSeed;
-            float sum = 0;
-            float amp = mFractalBounding;
+            for (int i = 0; i < count; i++) {
+                int x0 = FastFloor(xs[i]);
 
-            for (int i = 0; i < mOctaves; i++) {
-                float noise = PingPong((GenNoiseSingle(seed++, x, y) + 1) * mPingPongStrength);
-                sum += (noise - 0.5f) * 2 * amp;
-                amp *= Lerp(1.0f, noise, mWeightedStrength);
+                if (x0 != cell) {
+                    int x0Primed = x0 * PrimeX;
+                    v0 = x0 == cell + 1 ? v1 : ValCoord(seed, x0Primed);
+                    v1 = ValCoord(seed, x0Primed + PrimeX);
+                    cell = x0;
+                }
 
-                x *= mLacunarity;
-                y *= mLacunarity;
-                amp *= mGain;
+                out[i] = Lerp(v0, v1, InterpHermite((float)(xs[i] - x0)));
+            }
+        }
+
+        // Lattice Rows
+        // Row aligned spans share y, z and w between samples, so lattice values around the current sample are kept per
+        // column of lattice points along x and shifted along when a sample moves to the neighbouring cell, as in the
+        // 1D streams. Weights and gradient terms that only depend on y, z and w are computed once per row. Per sample
+        // arithmetic is the same as the Single kernels, or the Approx kernels with Approximate set, so rows match them
+        // exactly.
+
+        static void ValueColumn(int seed, int xPrimed, const int *yPrimed, float *column, int rows) {
+            for (int r = 0; r < rows; r++) {
+                column[r] = ValCoord(seed, xPrimed, yPrimed[r]);
             }
+        }
 
-            return sum;
+        static void ValueColumn(int seed, int xPrimed, const int *yPrimed, const int *zPrimed, float *column,
+                                int rows) {
+            for (int r = 0; r < rows; r++) {
+                column[r] = ValCoord(seed, xPrimed, yPrimed[r], zPrimed[r]);
+            }
         }
 
-        template <typename FNfloat> float GenFractalPingPong(FNfloat x, FNfloat y, FNfloat z) const {
-            int seed = mSeed;
-            float sum = 0;
-            float amp = mFractalBounding;
+        // Gradient x component and the y and z terms of GradCoord(...) for the lattice points of one column
+        static void PerlinColumn(int seed, int xPrimed, const int *yPrimed, const float *yd, float *xg, float *yTerm,
+                                 int rows) {
+            for (int r = 0; r < rows; r++) {
+                int hash = Hash(seed, xPrimed, yPrimed[r]);
+                hash ^= hash >> 15;
+                hash &= 127 << 1;
 
-            for (int i = 0; i < mOctaves; i++) {
-                float noise = PingPong((GenNoiseSingle(seed++, x, y, z) + 1) * mPingPongStrength);
-                sum += (noise - 0.5f) * 2 * amp;
-                amp *= Lerp(1.0f, noise, mWeightedStrength);
+                xg[r] = Lookup<float>::Gradients2D[hash];
+                yTerm[r] = yd[r] * Lookup<float>::Gradients2D[hash | 1];
+            }
+        }
 
-                x *= mLacunarity;
-                y *= mLacunarity;
-                z *= mLacunarity;
-                amp *= mGain;
+        static void PerlinColumn(int seed, int xPrimed, const int *yPrimed, const int *zPrimed, const float *yd,
+                                 const float *zd, float *xg, float *yTerm, float *zTerm, int rows) {
+            for (int r = 0; r < rows; r++) {
+                int hash = Hash(seed, xPrimed, yPrimed[r], zPrimed[r]);
+                hash ^= hash >> 15;
+                hash &= 63 << 2;
+
+                xg[r] = Lookup<float>::Gradients3D[hash];
+                yTerm[r] = yd[r] * Lookup<float>::Gradients3D[hash | 1];
+                zTerm[r] = zd[r] * Lookup<float>::Gradients3D[hash | 2];
             }
+        }
+
+        void ValueRow(int seed, const float *xs, float y, float *out, int count) const {
+            int y0 = FastFloor(y);
+            float ys = InterpHermite((float)(y - y0));
+            const int yPrimed[2] = {y0 * PrimeY, y0 * PrimeY + PrimeY};
+
+            // [column][row] for columns cell, cell + 1
+            float v[2][2] = {};
+            int cell = FastFloor(xs[0]) - 2;
+
+            for (int i = 0; i < count; i++) {
+                int x0 = FastFloor(xs[i]);
+
+                if (x0 != cell) {
+                    int x0Primed = x0 * PrimeX;
+                    if (x0 == cell + 1) {
+                        v[0][0] = v[1][0], v[0][1] = v[1][1];
+                    } else {
+                        ValueColumn(seed, x0Primed, yPrimed, v[0], 2);
+                    }
+                    ValueColumn(seed, x0Primed + PrimeX, yPrimed, v[1], 2);
+                    cell = x0;
+                }
+
+                float xs0 = InterpHermite((float)(xs[i] - x0));
+
+                float xf0 = Lerp(v[0][0], v[1][0], xs0);
+                float xf1 = Lerp(v[0][1], v[1][1], xs0);
 
-            return sum;
+                out[i] = Lerp(xf0, xf1, ys);
+            }
         }
 
-        // Simplex/OpenSimplex2 Noise
+        void ValueRow(int seed, const float *xs, float y, float z, float *out, int count) const {
+            int y0 = FastFloor(y);
+            int z0 = FastFloor(z);
+            float ys = InterpHermite((float)(y - y0));
+            float zs = InterpHermite((float)(z - z0));
 
-        template <typename FNfloat> float SingleSimplex(int seed, FNfloat x, FNfloat y) const {
-            // 2D OpenSimplex2 case uses the same algorithm as ordinary Simplex.
+            // Rows are (y, z) pairs with y innermost
+            int y0Primed = y0 * PrimeY, z0Primed = z0 * PrimeZ;
+            const int yPrimed[4] = {y0Primed, y0Primed + PrimeY, y0Primed, y0Primed + PrimeY};
+            const int zPrimed[4] = {z0Primed, z0Primed, z0Primed + PrimeZ, z0Primed + PrimeZ};
 
-            const float SQRT3 = 1.7320508075688772935274463415059f;
-            const float G2 = (3 - SQRT3) / 6;
+            // [column][row] for columns cell, cell + 1
+            float v[2][4] = {};
+            int cell = FastFloor(xs[0]) - 2;
 
-            /*
-             * --- Skew moved to TransformNoiseCoordinate method ---
-             * const FNfloat F2 = 0.5f * (SQRT3 - 1);
-             * FNfloat s = (x + y) * F2;
-             * x += s; y += s;
-             */
+            for (int i = 0; i < count; i++) {
+                int x0 = FastFloor(xs[i]);
 
-            int i = FastFloor(x);
-            int j = FastFloor(y);
-            float xi = (float)(x - i);
-            float yi = (float)(y - j);
+                if (x0 != cell) {
+                    int x0Primed = x0 * PrimeX;
+                    if (x0 == cell + 1) {
+                        for (int r = 0; r < 4; r++) {
+                            v[0][r] = v[1][r];
+                        }
+                    } else {
+                        ValueColumn(seed, x0Primed, yPrimed, zPrimed, v[0], 4);
+                    }
+                    ValueColumn(seed, x0Primed + PrimeX, yPrimed, zPrimed, v[1], 4);
+                    cell = x0;
+                }
 
-            float t = (xi + yi) * G2;
-            float x0 = (float)(xi - t);
-            float y0 = (float)(yi - t);
+                float xs0 = InterpHermite((float)(xs[i] - x0));
 
-            i *= PrimeX;
-            j *= PrimeY;
+                float xf00 = Lerp(v[0][0], v[1][0], xs0);
+                float xf10 = Lerp(v[0][1], v[1][1], xs0);
+                float xf01 = Lerp(v[0][2], v[1][2], xs0);
+                float xf11 = Lerp(v[0][3], v[1][3], xs0);
 
-            float n0, n1, n2;
+                float yf0 = Lerp(xf00, xf10, ys);
+                float yf1 = Lerp(xf01, xf11, ys);
 
-            float a = 0.5f - x0 * x0 - y0 * y0;
-            if (a <= 0)
-                n0 = 0;
-            else {
-                n0 = (a * a) * (a * a) * GradCoord(seed, i, j, x0, y0);
+                out[i] = Lerp(yf0, yf1, zs);
             }
+        }
 
-            float c = (float)(2 * (1 - 2 * G2) * (1 / G2 - 2)) * t + ((float)(-2 * (1 - 2 * G2) * (1 - 2 * G2)) + a);
-            if (c <= 0)
-                n2 = 0;
-            else {
-                float x2 = x0 + (2 * (float)G2 - 1);
-                float y2 = y0 + (2 * (float)G2 - 1);
-                n2 = (c * c) * (c * c) * GradCoord(seed, i + PrimeX, j + PrimeY, x2, y2);
-            }
-
-            if (y0 > x0) {
-                float x1 = x0 + (float)G2;
-                float y1 = y0 + ((float)G2 - 1);
-                float b = 0.5f - x1 * x1 - y1 * y1;
-                if (b <= 0)
-                    n1 = 0;
-                else {
-                    n1 = (b * b) * (b * b) * GradCoord(seed, i, j + PrimeY, x1, y1);
+        template <bool Approximate>
+        void ValueCubicRow(int seed, const float *xs, float y, float *out, int count) const {
+            int y1 = FastFloor(y);
+            float ys = (float)(y - y1);
+            float wy[4];
+            CubicWeights(ys, wy);
+            int y1Primed = y1 * PrimeY;
+            const int yPrimed[4] = {y1Primed - PrimeY, y1Primed, y1Primed + PrimeY,
+                                    y1Primed + (int)((long)PrimeY << 1)};
+
+            // [column][row] for columns cell - 1 ... cell + 2, and each column blended along y when Approximate
+            float v[4][4] = {};
+            float blended[4] = {};
+            int cell = FastFloor(xs[0]) - 2;
+
+            for (int i = 0; i < count; i++) {
+                int x1 = FastFloor(xs[i]);
+
+                if (x1 != cell) {
+                    int x1Primed = x1 * PrimeX;
+                    if (x1 == cell + 1) {
+                        for (int c = 0; c < 3; c++) {
+                            for (int r = 0; r < 4; r++) {
+                                v[c][r] = v[c + 1][r];
+                            }
+                        }
+                    } else {
+                        ValueColumn(seed, x1Primed - PrimeX, yPrimed, v[0], 4);
+                        ValueColumn(seed, x1Primed, yPrimed, v[1], 4);
+                        ValueColumn(seed, x1Primed + PrimeX, yPrimed, v[2], 4);
+                    }
+                    ValueColumn(seed, x1Primed + (int)((long)PrimeX << 1), yPrimed, v[3], 4);
+                    cell = x1;
+
+                    if (Approximate) {
+                        for (int c = 0; c < 4; c++) {
+                            blended[c] = BlendColumn(v[c], wy);
+                        }
+                    }
                 }
-            } else {
-                float x1 = x0 + ((float)G2 - 1);
-                float y1 = y0 + (float)G2;
-                float b = 0.5f - x1 * x1 - y1 * y1;
-                if (b <= 0)
-                    n1 = 0;
-                else {
-                    n1 = (b * b) * (b * b) * GradCoord(seed, i + PrimeX, j, x1, y1);
+
+                float xs1 = (float)(xs[i] - x1);
+
+                if (Approximate) {
+                    float wx[4];
+                    CubicWeights(xs1, wx);
+                    out[i] = wx[0] * blended[0] + wx[1] * blended[1] + wx[2] * blended[2] + wx[3] * blended[3];
+                    continue;
                 }
-            }
 
-            return (n0 + n1 + n2) * 99.83685446303647f;
+                out[i] = CubicLerp(CubicLerp(v[0][0], v[1][0], v[2][0], v[3][0], xs1),
+                                   CubicLerp(v[0][1], v[1][1], v[2][1], v[3][1], xs1),
+                                   CubicLerp(v[0][2], v[1][2], v[2][2], v[3][2], xs1),
+                                   CubicLerp(v[0][3], v[1][3], v[2][3], v[3][3], xs1), ys) *
+                         (1 / (1.5f * 1.5f));
+            }
         }
 
-        template <typename FNfloat> float SingleOpenSimplex2(int seed, FNfloat x, FNfloat y, FNfloat z) const {
-            // 3D OpenSimplex2 case uses two offset rotated cube grids.
-
-            /*
-             * --- Rotation moved to TransformNoiseCoordinate method ---
-             * const FNfloat R3 = (FNfloat)(2.0 / 3.0);
-             * FNfloat r = (x + y + z) * R3; // Rotation, not skew
-             * x = r - x; y = r - y; z = r - z;
-             */
+        template <bool Approximate>
+        void ValueCubicRow(int seed, const float *xs, float y, float z, float *out, int count) const {
+            int y1 = FastFloor(y);
+            int z1 = FastFloor(z);
+            float ys = (float)(y - y1);
+            float zs = (float)(z - z1);
+            float wy[4], wz[4];
+            CubicWeights(ys, wy);
+            CubicWeights(zs, wz);
+
+            // Rows are (y, z) pairs with y innermost
+            int y1Primed = y1 * PrimeY, z1Primed = z1 * PrimeZ;
+            const int yOffsets[4] = {y1Primed - PrimeY, y1Primed, y1Primed + PrimeY,
+                                     y1Primed + (int)((long)PrimeY << 1)};
+            const int zOffsets[4] = {z1Primed - PrimeZ, z1Primed, z1Primed + PrimeZ,
+                                     z1Primed + (int)((long)PrimeZ << 1)};
+            int yPrimed[16], zPrimed[16];
+            for (int r = 0; r < 16; r++) {
+                yPrimed[r] = yOffsets[r & 3];
+                zPrimed[r] = zOffsets[r >> 2];
+            }
 
-            int i = FastRound(x);
-            int j = FastRound(y);
-            int k = FastRound(z);
-            float x0 = (float)(x - i);
-            float y0 = (float)(y - j);
-            float z0 = (float)(z - k);
+            // [column][row] for columns cell - 1 ... cell + 2, and each column blended along y and z when Approximate
+            float v[4][16] = {};
+            float blended[4] = {};
+            int cell = FastFloor(xs[0]) - 2;
 
-            int xNSign = (int)(-1.0f - x0) | 1;
-            int yNSign = (int)(-1.0f - y0) | 1;
-            int zNSign = (int)(-1.0f - z0) | 1;
+            for (int i = 0; i < count; i++) {
+                int x1 = FastFloor(xs[i]);
 
-            float ax0 = xNSign * -x0;
-            float ay0 = yNSign * -y0;
-            float az0 = zNSign * -z0;
+                if (x1 != cell) {
+                    int x1Primed = x1 * PrimeX;
+                    if (x1 == cell + 1) {
+                        for (int c = 0; c < 3; c++) {
+                            for (int r = 0; r < 16; r++) {
+                                v[c][r] = v[c + 1][r];
+                            }
+                        }
+                    } else {
+                        ValueColumn(seed, x1Primed - PrimeX, yPrimed, zPrimed, v[0], 16);
+                        ValueColumn(seed, x1Primed, yPrimed, zPrimed, v[1], 16);
+                        ValueColumn(seed, x1Primed + PrimeX, yPrimed, zPrimed, v[2], 16);
+                    }
+                    ValueColumn(seed, x1Primed + (int)((long)PrimeX << 1), yPrimed, zPrimed, v[3], 16);
+                    cell = x1;
 
-            i *= PrimeX;
-            j *= PrimeY;
-            k *= PrimeZ;
+                    if (Approximate) {
+                        for (int c = 0; c < 4; c++) {
+                            blended[c] = BlendColumn(v[c], wy, wz);
+                        }
+                    }
+                }
 
-            float value = 0;
-            float a = (0.6f - x0 * x0) - (y0 * y0 + z0 * z0);
+                float xs1 = (float)(xs[i] - x1);
 
-            for (int l = 0;; l++) {
-                if (a > 0) {
-                    value += (a * a) * (a * a) * GradCoord(seed, i, j, k, x0, y0, z0);
+                if (Approximate) {
+                    float wx[4];
+                    CubicWeights(xs1, wx);
+                    out[i] = wx[0] * blended[0] + wx[1] * blended[1] + wx[2] * blended[2] + wx[3] * blended[3];
+                    continue;
                 }
 
-                float b = a + 1;
-                int i1 = i;
-                int j1 = j;
-                int k1 = k;
-                float x1 = x0;
-                float y1 = y0;
-                float z1 = z0;
-
-                if (ax0 >= ay0 && ax0 >= az0) {
-                    x1 += xNSign;
-                    b -= xNSign * 2 * x1;
-                    i1 -= xNSign * PrimeX;
-                } else if (ay0 > ax0 && ay0 >= az0) {
-                    y1 += yNSign;
-                    b -= yNSign * 2 * y1;
-                    j1 -= yNSign * PrimeY;
-                } else {
-                    z1 += zNSign;
-                    b -= zNSign * 2 * z1;
-                    k1 -= zNSign * PrimeZ;
+                float yf[4];
+                for (int zi = 0; zi < 4; zi++) {
+                    float xf[4];
+                    for (int yi = 0; yi < 4; yi++) {
+                        int r = zi * 4 + yi;
+                        xf[yi] = CubicLerp(v[0][r], v[1][r], v[2][r], v[3][r], xs1);
+                    }
+                    yf[zi] = CubicLerp(xf[0], xf[1], xf[2], xf[3], ys);
                 }
 
-                if (b > 0) {
-                    value += (b * b) * (b * b) * GradCoord(seed, i1, j1, k1, x1, y1, z1);
+                out[i] = CubicLerp(yf[0], yf[1], yf[2], yf[3], zs) * (1 / (1.5f * 1.5f * 1.5f));
+            }
+        }
+
+        template <bool Approximate> void PerlinRow(int seed, const float *xs, float y, float *out, int count) const {
+            int y0 = FastFloor(y);
+            float yd0 = (float)(y - y0);
+            float ys = Approximate ? InterpHermite(yd0) : InterpQuintic(yd0);
+            const int yPrimed[2] = {y0 * PrimeY, y0 * PrimeY + PrimeY};
+            const float yd[2] = {yd0, yd0 - 1};
+
+            // [column][row] for columns cell, cell + 1
+            float xg[2][2] = {}, yTerm[2][2] = {};
+            int cell = FastFloor(xs[0]) - 2;
+
+            for (int i = 0; i < count; i++) {
+                int x0 = FastFloor(xs[i]);
+
+                if (x0 != cell) {
+                    int x0Primed = x0 * PrimeX;
+                    if (x0 == cell + 1) {
+                        for (int r = 0; r < 2; r++) {
+                            xg[0][r] = xg[1][r], yTerm[0][r] = yTerm[1][r];
+                        }
+                    } else {
+                        PerlinColumn(seed, x0Primed, yPrimed, yd, xg[0], yTerm[0], 2);
+                    }
+                    PerlinColumn(seed, x0Primed + PrimeX, yPrimed, yd, xg[1], yTerm[1], 2);
+                    cell = x0;
                 }
 
-                if (l == 1)
-                    break;
+                float xd0 = (float)(xs[i] - x0);
+                float xd1 = xd0 - 1;
+                float xs0 = Approximate ? InterpHermite(xd0) : InterpQuintic(xd0);
 
-                ax0 = 0.5f - ax0;
-                ay0 = 0.5f - ay0;
-                az0 = 0.5f - az0;
+                float xf0 = Lerp(xd0 * xg[0][0] + yTerm[0][0], xd1 * xg[1][0] + yTerm[1][0], xs0);
+                float xf1 = Lerp(xd0 * xg[0][1] + yTerm[0][1], xd1 * xg[1][1] + yTerm[1][1], xs0);
 
-                x0 = xNSign * ax0;
-                y0 = yNSign * ay0;
-                z0 = zNSign * az0;
+                out[i] = Lerp(xf0, xf1, ys) * 1.4247691104677813f;
+            }
+        }
 
-                a += (0.75f - ax0) - (ay0 + az0);
+        template <bool Approximate>
+        void PerlinRow(int seed, const float *xs, float y, float z, float *out, int count) const {
+            int y0 = FastFloor(y);
+            int z0 = FastFloor(z);
+            float yd0 = (float)(y - y0);
+            float zd0 = (float)(z - z0);
+            float ys = Approximate ? InterpHermite(yd0) : InterpQuintic(yd0);
+            float zs = Approximate ? InterpHermite(zd0) : InterpQuintic(zd0);
+
+            // Rows are (y, z) pairs with y innermost
+            int y0Primed = y0 * PrimeY, z0Primed = z0 * PrimeZ;
+            const int yPrimed[4] = {y0Primed, y0Primed + PrimeY, y0Primed, y0Primed + PrimeY};
+            const int zPrimed[4] = {z0Primed, z0Primed, z0Primed + PrimeZ, z0Primed + PrimeZ};
+            const float yd[4] = {yd0, yd0 - 1, yd0, yd0 - 1};
+            const float zd[4] = {zd0, zd0, zd0 - 1, zd0 - 1};
+
+            // [column][row] for columns cell, cell + 1
+            float xg[2][4] = {}, yTerm[2][4] = {}, zTerm[2][4] = {};
+            int cell = FastFloor(xs[0]) - 2;
+
+            for (int i = 0; i < count; i++) {
+                int x0 = FastFloor(xs[i]);
+
+                if (x0 != cell) {
+                    int x0Primed = x0 * PrimeX;
+                    if (x0 == cell + 1) {
+                        for (int r = 0; r < 4; r++) {
+                            xg[0][r] = xg[1][r], yTerm[0][r] = yTerm[1][r], zTerm[0][r] = zTerm[1][r];
+                        }
+                    } else {
+                        PerlinColumn(seed, x0Primed, yPrimed, zPrimed, yd, zd, xg[0], yTerm[0], zTerm[0], 4);
+                    }
+                    PerlinColumn(seed, x0Primed + PrimeX, yPrimed, zPrimed, yd, zd, xg[1], yTerm[1], zTerm[1], 4);
+                    cell = x0;
+                }
 
-                i += (xNSign >> 1) & PrimeX;
-                j += (yNSign >> 1) & PrimeY;
-                k += (zNSign >> 1) & PrimeZ;
+                float xd0 = (float)(xs[i] - x0);
+                float xd1 = xd0 - 1;
+                float xs0 = Approximate ? InterpHermite(xd0) : InterpQuintic(xd0);
 
-                xNSign = -xNSign;
-                yNSign = -yNSign;
-                zNSign = -zNSign;
+                float xf[4];
+                for (int r = 0; r < 4; r++) {
+                    xf[r] = Lerp(xd0 * xg[0][r] + yTerm[0][r] + zTerm[0][r], xd1 * xg[1][r] + yTerm[1][r] + zTerm[1][r],
+                                 xs0);
+                }
 
-                seed = ~seed;
+                float yf0 = Lerp(xf[0], xf[1], ys);
+                float yf1 = Lerp(xf[2], xf[3], ys);
+
+                out[i] = Lerp(yf0, yf1, zs) * 0.964921414852142333984375f;
             }
+        }
 
-            return value * 32.69428253173828125f;
+        static void ValueColumn(int seed, int xPrimed, const int *yPrimed, const int *zPrimed, const int *wPrimed,
+                                float *column, int rows) {
+            for (int r = 0; r < rows; r++) {
+                column[r] = ValCoord(seed, xPrimed, yPrimed[r], zPrimed[r], wPrimed[r]);
+            }
         }
 
-        // OpenSimplex2S Noise
+        static void PerlinColumn(int seed, int xPrimed, const int *yPrimed, const int *zPrimed, const int *wPrimed,
+                                 const float *yd, const float *zd, const float *wd, float *xg, float *yTerm,
+                                 float *zTerm, float *wTerm, int rows) {
+            for (int r = 0; r < rows; r++) {
+                int hash = Hash(seed, xPrimed, yPrimed[r], zPrimed[r], wPrimed[r]);
+                hash ^= hash >> 15;
+                hash &= 31 << 2;
+
+                xg[r] = Lookup<float>::Gradients4D[hash];
+                yTerm[r] = yd[r] * Lookup<float>::Gradients4D[hash | 1];
+                zTerm[r] = zd[r] * Lookup<float>::Gradients4D[hash | 2];
+                wTerm[r] = wd[r] * Lookup<float>::Gradients4D[hash | 3];
+            }
+        }
 
-        template <typename FNfloat> float SingleOpenSimplex2S(int seed, FNfloat x, FNfloat y) const {
-            // 2D OpenSimplex2S case is a modified 2D simplex noise.
+        void ValueRow(int seed, const float *xs, float y, float z, float w, float *out, int count) const {
+            int y0 = FastFloor(y);
+            int z0 = FastFloor(z);
+            int w0 = FastFloor(w);
+            float ys = InterpHermite((float)(y - y0));
+            float zs = InterpHermite((float)(z - z0));
+            float ws = InterpHermite((float)(w - w0));
+
+            // Rows are (y, z, w) triples with y innermost
+            int yPrimed[8], zPrimed[8], wPrimed[8];
+            for (int r = 0; r < 8; r++) {
+                yPrimed[r] = y0 * PrimeY + (r & 1 ? PrimeY : 0);
+                zPrimed[r] = z0 * PrimeZ + (r & 2 ? PrimeZ : 0);
+                wPrimed[r] = w0 * PrimeW + (r & 4 ? PrimeW : 0);
+            }
 
-            const FNfloat SQRT3 = (FNfloat)1.7320508075688772935274463415059;
-            const FNfloat G2 = (3 - SQRT3) / 6;
+            // [column][row] for columns cell, cell + 1
+            float v[2][8] = {};
+            int cell = FastFloor(xs[0]) - 2;
 
-            /*
-             * --- Skew moved to TransformNoiseCoordinate method ---
-             * const FNfloat F2 = 0.5f * (SQRT3 - 1);
-             * FNfloat s = (x + y) * F2;
-             * x += s; y += s;
-             */
+            for (int i = 0; i < count; i++) {
+                int x0 = FastFloor(xs[i]);
 
-            int i = FastFloor(x);
-            int j = FastFloor(y);
-            float xi = (float)(x - i);
-            float yi = (float)(y - j);
+                if (x0 != cell) {
+                    int x0Primed = x0 * PrimeX;
+                    if (x0 == cell + 1) {
+                        for (int r = 0; r < 8; r++) {
+                            v[0][r] = v[1][r];
+                        }
+                    } else {
+                        ValueColumn(seed, x0Primed, yPrimed, zPrimed, wPrimed, v[0], 8);
+                    }
+                    ValueColumn(seed, x0Primed + PrimeX, yPrimed, zPrimed, wPrimed, v[1], 8);
+                    cell = x0;
+                }
 
-            i *= PrimeX;
-            j *= PrimeY;
-            int i1 = i + PrimeX;
-            int j1 = j + PrimeY;
+                float xs0 = InterpHermite((float)(xs[i] - x0));
 
-            float t = (xi + yi) * (float)G2;
-            float x0 = xi - t;
-            float y0 = yi - t;
+                float zf[2];
+                for (int wi = 0; wi < 2; wi++) {
+                    const float *v0 = v[0] + wi * 4;
+                    const float *v1 = v[1] + wi * 4;
 
-            float a0 = (2.0f / 3.0f) - x0 * x0 - y0 * y0;
-            float value = (a0 * a0) * (a0 * a0) * GradCoord(seed, i, j, x0, y0);
+                    float yf0 = Lerp(Lerp(v0[0], v1[0], xs0), Lerp(v0[1], v1[1], xs0), ys);
+                    float yf1 = Lerp(Lerp(v0[2], v1[2], xs0), Lerp(v0[3], v1[3], xs0), ys);
+                    zf[wi] = Lerp(yf0, yf1, zs);
+                }
 
-            float a1 = (float)(2 * (1 - 2 * G2) * (1 / G2 - 2)) * t + ((float)(-2 * (1 - 2 * G2) * (1 - 2 * G2)) + a0);
-            float x1 = x0 - (float)(1 - 2 * G2);
-            float y1 = y0 - (float)(1 - 2 * G2);
-            value += (a1 * a1) * (a1 * a1) * GradCoord(seed, i1, j1, x1, y1);
+                out[i] = Lerp(zf[0], zf[1], ws);
+            }
+        }
 
-            // Nested conditionals were faster than compact bit logic/arithmetic.
-            float xmyi = xi - yi;
-            if (t > G2) {
-                if (xi + xmyi > 1) {
-                    float x2 = x0 + (float)(3 * G2 - 2);
-                    float y2 = y0 + (float)(3 * G2 - 1);
-                    float a2 = (2.0f / 3.0f) - x2 * x2 - y2 * y2;
-                    if (a2 > 0) {
-                        value += (a2 * a2) * (a2 * a2) * GradCoord(seed, i + (PrimeX << 1), j + PrimeY, x2, y2);
-                    }
-                } else {
-                    float x2 = x0 + (float)G2;
-                    float y2 = y0 + (float)(G2 - 1);
-                    float a2 = (2.0f / 3.0f) - x2 * x2 - y2 * y2;
-                    if (a2 > 0) {
-                        value += (a2 * a2) * (a2 * a2) * GradCoord(seed, i, j + PrimeY, x2, y2);
-                    }
-                }
+        void PerlinRow(int seed, const float *xs, float y, float z, float w, float *out, int count) const {
+            int y0 = FastFloor(y);
+            int z0 = FastFloor(z);
+            int w0 = FastFloor(w);
+            float yd0 = (float)(y - y0);
+            float zd0 = (float)(z - z0);
+            float wd0 = (float)(w - w0);
+            float ys = InterpQuintic(yd0);
+            float zs = InterpQuintic(zd0);
+            float ws = InterpQuintic(wd0);
+
+            // Rows are (y, z, w) triples with y innermost
+            int yPrimed[8], zPrimed[8], wPrimed[8];
+            float yd[8], zd[8], wd[8];
+            for (int r = 0; r < 8; r++) {
+                yPrimed[r] = y0 * PrimeY + (r & 1 ? PrimeY : 0);
+                zPrimed[r] = z0 * PrimeZ + (r & 2 ? PrimeZ : 0);
+                wPrimed[r] = w0 * PrimeW + (r & 4 ? PrimeW : 0);
+                yd[r] = r & 1 ? yd0 - 1 : yd0;
+                zd[r] = r & 2 ? zd0 - 1 : zd0;
+                wd[r] = r & 4 ? wd0 - 1 : wd0;
+            }
 
-                if (yi - xmyi > 1) {
-                    float x3 = x0 + (float)(3 * G2 - 1);
-                    float y3 = y0 + (float)(3 * G2 - 2);
-                    float a3 = (2.0f / 3.0f) - x3 * x3 - y3 * y3;
-                    if (a3 > 0) {
-                        value += (a3 * a3) * (a3 * a3) * GradCoord(seed, i + PrimeX, j + (PrimeY << 1), x3, y3);
-                    }
-                } else {
-                    float x3 = x0 + (float)(G2 - 1);
-                    float y3 = y0 + (float)G2;
-                    float a3 = (2.0f / 3.0f) - x3 * x3 - y3 * y3;
-                    if (a3 > 0) {
-                        value += (a3 * a3) * (a3 * a3) * GradCoord(seed, i + PrimeX, j, x3, y3);
+            // [column][row] for columns cell, cell + 1
+            float xg[2][8] = {}, yTerm[2][8] = {}, zTerm[2][8] = {}, wTerm[2][8] = {};
+            int cell = FastFloor(xs[0]) - 2;
+
+            for (int i = 0; i < count; i++) {
+                int x0 = FastFloor(xs[i]);
+
+                if (x0 != cell) {
+                    int x0Primed = x0 * PrimeX;
+                    if (x0 == cell + 1) {
+                        for (int r = 0; r < 8; r++) {
+                            xg[0][r] = xg[1][r], yTerm[0][r] = yTerm[1][r];
+                            zTerm[0][r] = zTerm[1][r], wTerm[0][r] = wTerm[1][r];
+                        }
+                    } else {
+                        PerlinColumn(seed, x0Primed, yPrimed, zPrimed, wPrimed, yd, zd, wd, xg[0], yTerm[0], zTerm[0],
+                                     wTerm[0], 8);
                     }
+                    PerlinColumn(seed, x0Primed + PrimeX, yPrimed, zPrimed, wPrimed, yd, zd, wd, xg[1], yTerm[1],
+                                 zTerm[1], wTerm[1], 8);
+                    cell = x0;
                 }
-            } else {
-                if (xi + xmyi < 0) {
-                    float x2 = x0 + (float)(1 - G2);
-                    float y2 = y0 - (float)G2;
-                    float a2 = (2.0f / 3.0f) - x2 * x2 - y2 * y2;
-                    if (a2 > 0) {
-                        value += (a2 * a2) * (a2 * a2) * GradCoord(seed, i - PrimeX, j, x2, y2);
-                    }
-                } else {
-                    float x2 = x0 + (float)(G2 - 1);
-                    float y2 = y0 + (float)G2;
-                    float a2 = (2.0f / 3.0f) - x2 * x2 - y2 * y2;
-                    if (a2 > 0) {
-                        value += (a2 * a2) * (a2 * a2) * GradCoord(seed, i + PrimeX, j, x2, y2);
-                    }
+
+                float xd0 = (float)(xs[i] - x0);
+                float xd1 = xd0 - 1;
+                float xs0 = InterpQuintic(xd0);
+
+                float xf[8];
+                for (int r = 0; r < 8; r++) {
+                    xf[r] = Lerp(xd0 * xg[0][r] + yTerm[0][r] + zTerm[0][r] + wTerm[0][r],
+                                 xd1 * xg[1][r] + yTerm[1][r] + zTerm[1][r] + wTerm[1][r], xs0);
                 }
 
-                if (yi < xmyi) {
-                    float x2 = x0 - (float)G2;
-                    float y2 = y0 - (float)(G2 - 1);
-                    float a2 = (2.0f / 3.0f) - x2 * x2 - y2 * y2;
-                    if (a2 > 0) {
-                        value += (a2 * a2) * (a2 * a2) * GradCoord(seed, i, j - PrimeY, x2, y2);
-                    }
-                } else {
-                    float x2 = x0 + (float)G2;
-                    float y2 = y0 + (float)(G2 - 1);
-                    float a2 = (2.0f / 3.0f) - x2 * x2 - y2 * y2;
-                    if (a2 > 0) {
-                        value += (a2 * a2) * (a2 * a2) * GradCoord(seed, i, j + PrimeY, x2, y2);
-                    }
+                float zf[2];
+                for (int wi = 0; wi < 2; wi++) {
+                    float yf0 = Lerp(xf[wi * 4], xf[wi * 4 + 1], ys);
+                    float yf1 = Lerp(xf[wi * 4 + 2], xf[wi * 4 + 3], ys);
+                    zf[wi] = Lerp(yf0, yf1, zs);
                 }
-            }
 
-            return value * 18.24196194486065f;
+                out[i] = Lerp(zf[0], zf[1], ws) * 0.8f;
+            }
         }
 
-        template <typename FNfloat> float SingleOpenSimplex2S(int seed, FNfloat x, FNfloat y, FNfloat z) const {
-            // 3D OpenSimplex2S case uses two offset rotated cube grids.
+        // 4D Noise
 
-            /*
-             * --- Rotation moved to TransformNoiseCoordinate method ---
-             * const FNfloat R3 = (FNfloat)(2.0 / 3.0);
-             * FNfloat r = (x + y + z) * R3; // Rotation, not skew
-             * x = r - x; y = r - y; z = r - z;
-             */
+        // OpenSimplex2 in 4D sums one contribution from each of five copies of the A4 lattice, offset along the main
+        // diagonal by 0.2. Input is already skewed by TransformNoiseCoordinate. The falloff radius squared is 0.55,
+        // at 0.6 a second vertex of the same copy can come into range and leave small discontinuities.
+        template <typename FNfloat>
+        float SingleOpenSimplex2(int seed, FNfloat x, FNfloat y, FNfloat z, FNfloat w) const {
+            const float UNSKEW4 = 0.309016994374947424102293417182819f; // (sqrt(5) - 1) / 4
+            const float LATTICE_STEP4 = 0.2f;
+            const int SEED_OFFSET4 = 1293373;
+
+            int xsb = FastFloor(x);
+            int ysb = FastFloor(y);
+            int zsb = FastFloor(z);
+            int wsb = FastFloor(w);
+            float xsi = (float)(x - xsb);
+            float ysi = (float)(y - ysb);
+            float zsi = (float)(z - zsb);
+            float wsi = (float)(w - wsb);
+
+            // Start on the lattice copy whose base simplex is sure to contribute
+            float siSum = (xsi + ysi) + (zsi + wsi);
+            int startingLattice = (int)(siSum * 1.25f);
+            seed += startingLattice * SEED_OFFSET4;
+
+            float startingLatticeOffset = startingLattice * -LATTICE_STEP4;
+            xsi += startingLatticeOffset;
+            ysi += startingLatticeOffset;
+            zsi += startingLatticeOffset;
+            wsi += startingLatticeOffset;
+            float ssi = (siSum + startingLatticeOffset * 4) * UNSKEW4;
+
+            int xPrimed = xsb * PrimeX;
+            int yPrimed = ysb * PrimeY;
+            int zPrimed = zsb * PrimeZ;
+            int wPrimed = wsb * PrimeW;
 
-            int i = FastFloor(x);
-            int j = FastFloor(y);
-            int k = FastFloor(z);
-            float xi = (float)(x - i);
-            float yi = (float)(y - j);
-            float zi = (float)(z - k);
+            float value = 0;
+            for (int i = 0;; i++) {
+                // Closest vertex of the simplex whose base vertex is the current one
+                float score0 = 1.0f + ssi * (-1.0f / UNSKEW4);
+                if (xsi >= ysi && xsi >= zsi && xsi >= wsi && xsi >= score0) {
+                    xPrimed += PrimeX;
+                    xsi -= 1;
+                    ssi -= UNSKEW4;
+                } else if (ysi > xsi && ysi >= zsi && ysi >= wsi && ysi >= score0) {
+                    yPrimed += PrimeY;
+                    ysi -= 1;
+                    ssi -= UNSKEW4;
+                } else if (zsi > xsi && zsi > ysi && zsi >= wsi && zsi >= score0) {
+                    zPrimed += PrimeZ;
+                    zsi -= 1;
+                    ssi -= UNSKEW4;
+                } else if (wsi > xsi && wsi > ysi && wsi > zsi && wsi >= score0) {
+                    wPrimed += PrimeW;
+                    wsi -= 1;
+                    ssi -= UNSKEW4;
+                }
 
-            i *= PrimeX;
-            j *= PrimeY;
-            k *= PrimeZ;
-            int seed2 = seed + 1293373;
+                float dx = xsi + ssi;
+                float dy = ysi + ssi;
+                float dz = zsi + ssi;
+                float dw = wsi + ssi;
+                float a = (dx * dx + dy * dy) + (dz * dz + dw * dw);
+                if (a < 0.55f) {
+                    a -= 0.55f;
+                    a *= a;
+                    value += a * a * GradCoord(seed, xPrimed, yPrimed, zPrimed, wPrimed, dx, dy, dz, dw);
+                }
 
-            int xNMask = (int)(-0.5f - xi);
-            int yNMask = (int)(-0.5f - yi);
-            int zNMask = (int)(-0.5f - zi);
+                if (i == 4)
+                    break;
 
-            float x0 = xi + xNMask;
-            float y0 = yi + yNMask;
-            float z0 = zi + zNMask;
-            float a0 = 0.75f - x0 * x0 - y0 * y0 - z0 * z0;
-            float value =
-                (a0 * a0) * (a0 * a0) *
-                GradCoord(seed, i + (xNMask & PrimeX), j + (yNMask & PrimeY), k + (zNMask & PrimeZ), x0, y0, z0);
+                // Next lattice copy, shifted by -0.2 along the diagonal
+                xsi += LATTICE_STEP4;
+                ysi += LATTICE_STEP4;
+                zsi += LATTICE_STEP4;
+                wsi += LATTICE_STEP4;
+                ssi += LATTICE_STEP4 * 4 * UNSKEW4;
+                seed -= SEED_OFFSET4;
+
+                // Wrapping from the first copy back to the last moves the base vertex down one step
+                if (i == startingLattice) {
+                    xPrimed -= PrimeX;
+                    yPrimed -= PrimeY;
+                    zPrimed -= PrimeZ;
+                    wPrimed -= PrimeW;
+                    seed += SEED_OFFSET4 * 5;
+                }
+            }
+
+            return value * 40.0f;
+        }
+
+        template <typename FNfloat> float SinglePerlin(int seed, FNfloat x, FNfloat y, FNfloat z, FNfloat w) const {
+            int x0 = FastFloor(x);
+            int y0 = FastFloor(y);
+            int z0 = FastFloor(z);
+            int w0 = FastFloor(w);
+
+            float xd0 = (float)(x - x0);
+            float yd0 = (float)(y - y0);
+            float zd0 = (float)(z - z0);
+            float wd0 = (float)(w - w0);
+            float xd1 = xd0 - 1;
+            float yd1 = yd0 - 1;
+            float zd1 = zd0 - 1;
+            float wd1 = wd0 - 1;
+
+            float xs = InterpQuintic(xd0);
+            float ys = InterpQuintic(yd0);
+            float zs = InterpQuintic(zd0);
+            float ws = InterpQuintic(wd0);
+
+            x0 *= PrimeX;
+            y0 *= PrimeY;
+            z0 *= PrimeZ;
+            w0 *= PrimeW;
+            int x1 = x0 + PrimeX;
+            int y1 = y0 + PrimeY;
+            int z1 = z0 + PrimeZ;
+            int w1 = w0 + PrimeW;
+
+            float zf[2];
+            for (int wi = 0; wi < 2; wi++) {
+                int wPrimed = wi ? w1 : w0;
+                float wd = wi ? wd1 : wd0;
+
+                float xf00 = Lerp(GradCoord(seed, x0, y0, z0, wPrimed, xd0, yd0, zd0, wd),
+                                  GradCoord(seed, x1, y0, z0, wPrimed, xd1, yd0, zd0, wd), xs);
+                float xf10 = Lerp(GradCoord(seed, x0, y1, z0, wPrimed, xd0, yd1, zd0, wd),
+                                  GradCoord(seed, x1, y1, z0, wPrimed, xd1, yd1, zd0, wd), xs);
+                float xf01 = Lerp(GradCoord(seed, x0, y0, z1, wPrimed, xd0, yd0, zd1, wd),
+                                  GradCoord(seed, x1, y0, z1, wPrimed, xd1, yd0, zd1, wd), xs);
+                float xf11 = Lerp(GradCoord(seed, x0, y1, z1, wPrimed, xd0, yd1, zd1, wd),
+                                  GradCoord(seed, x1, y1, z1, wPrimed, xd1, yd1, zd1, wd), xs);
+
+                float yf0 = Lerp(xf00, xf10, ys);
+                float yf1 = Lerp(xf01, xf11, ys);
+                zf[wi] = Lerp(yf0, yf1, zs);
+            }
 
-            float x1 = xi - 0.5f;
-            float y1 = yi - 0.5f;
-            float z1 = zi - 0.5f;
-            float a1 = 0.75f - x1 * x1 - y1 * y1 - z1 * z1;
-            value += (a1 * a1) * (a1 * a1) * GradCoord(seed2, i + PrimeX, j + PrimeY, k + PrimeZ, x1, y1, z1);
+            return Lerp(zf[0], zf[1], ws) * 0.8f;
+        }
 
-            float xAFlipMask0 = ((xNMask | 1) << 1) * x1;
-            float yAFlipMask0 = ((yNMask | 1) << 1) * y1;
-            float zAFlipMask0 = ((zNMask | 1) << 1) * z1;
-            float xAFlipMask1 = (-2 - (xNMask << 2)) * x1 - 1.0f;
-            float yAFlipMask1 = (-2 - (yNMask << 2)) * y1 - 1.0f;
-            float zAFlipMask1 = (-2 - (zNMask << 2)) * z1 - 1.0f;
-
-            bool skip5 = false;
-            float a2 = xAFlipMask0 + a0;
-            if (a2 > 0) {
-                float x2 = x0 - (xNMask | 1);
-                float y2 = y0;
-                float z2 = z0;
-                value +=
-                    (a2 * a2) * (a2 * a2) *
-                    GradCoord(seed, i + (~xNMask & PrimeX), j + (yNMask & PrimeY), k + (zNMask & PrimeZ), x2, y2, z2);
-            } else {
-                float a3 = yAFlipMask0 + zAFlipMask0 + a0;
-                if (a3 > 0) {
-                    float x3 = x0;
-                    float y3 = y0 - (yNMask | 1);
-                    float z3 = z0 - (zNMask | 1);
-                    value += (a3 * a3) * (a3 * a3) *
-                             GradCoord(seed, i + (xNMask & PrimeX), j + (~yNMask & PrimeY), k + (~zNMask & PrimeZ), x3,
-                                       y3, z3);
-                }
-
-                float a4 = xAFlipMask1 + a1;
-                if (a4 > 0) {
-                    float x4 = (xNMask | 1) + x1;
-                    float y4 = y1;
-                    float z4 = z1;
-                    value += (a4 * a4) * (a4 * a4) *
-                             GradCoord(seed2, i + (xNMask & (PrimeX * 2)), j + PrimeY, k + PrimeZ, x4, y4, z4);
-                    skip5 = true;
-                }
-            }
-
-            bool skip9 = false;
-            float a6 = yAFlipMask0 + a0;
-            if (a6 > 0) {
-                float x6 = x0;
-                float y6 = y0 - (yNMask | 1);
-                float z6 = z0;
-                value +=
-                    (a6 * a6) * (a6 * a6) *
-                    GradCoord(seed, i + (xNMask & PrimeX), j + (~yNMask & PrimeY), k + (zNMask & PrimeZ), x6, y6, z6);
-            } else {
-                float a7 = xAFlipMask0 + zAFlipMask0 + a0;
-                if (a7 > 0) {
-                    float x7 = x0 - (xNMask | 1);
-                    float y7 = y0;
-                    float z7 = z0 - (zNMask | 1);
-                    value += (a7 * a7) * (a7 * a7) *
-                             GradCoord(seed, i + (~xNMask & PrimeX), j + (yNMask & PrimeY), k + (~zNMask & PrimeZ), x7,
-                                       y7, z7);
-                }
-
-                float a8 = yAFlipMask1 + a1;
-                if (a8 > 0) {
-                    float x8 = x1;
-                    float y8 = (yNMask | 1) + y1;
-                    float z8 = z1;
-                    value += (a8 * a8) * (a8 * a8) *
-                             GradCoord(seed2, i + PrimeX, j + (yNMask & (PrimeY << 1)), k + PrimeZ, x8, y8, z8);
-                    skip9 = true;
-                }
-            }
-
-            bool skipD = false;
-            float aA = zAFlipMask0 + a0;
-            if (aA > 0) {
-                float xA = x0;
-                float yA = y0;
-                float zA = z0 - (zNMask | 1);
-                value +=
-                    (aA * aA) * (aA * aA) *
-                    GradCoord(seed, i + (xNMask & PrimeX), j + (yNMask & PrimeY), k + (~zNMask & PrimeZ), xA, yA, zA);
-            } else {
-                float aB = xAFlipMask0 + yAFlipMask0 + a0;
-                if (aB > 0) {
-                    float xB = x0 - (xNMask | 1);
-                    float yB = y0 - (yNMask | 1);
-                    float zB = z0;
-                    value += (aB * aB) * (aB * aB) *
-                             GradCoord(seed, i + (~xNMask & PrimeX), j + (~yNMask & PrimeY), k + (zNMask & PrimeZ), xB,
-                                       yB, zB);
-                }
+        template <typename FNfloat> float SingleValue(int seed, FNfloat x, FNfloat y, FNfloat z, FNfloat w) const {
+            int x0 = FastFloor(x);
+            int y0 = FastFloor(y);
+            int z0 = FastFloor(z);
+            int w0 = FastFloor(w);
 
-                float aC = zAFlipMask1 + a1;
-                if (aC > 0) {
-                    float xC = x1;
-                    float yC = y1;
-                    float zC = (zNMask | 1) + z1;
-                    value += (aC * aC) * (aC * aC) *
-                             GradCoord(seed2, i + PrimeX, j + PrimeY, k + (zNMask & (PrimeZ << 1)), xC, yC, zC);
-                    skipD = true;
-                }
-            }
+            float xs = InterpHermite((float)(x - x0));
+            float ys = InterpHermite((float)(y - y0));
+            float zs = InterpHermite((float)(z - z0));
+            float ws = InterpHermite((float)(w - w0));
 
-            if (!skip5) {
-                float a5 = yAFlipMask1 + zAFlipMask1 + a1;
-                if (a5 > 0) {
-                    float x5 = x1;
-                    float y5 = (yNMask | 1) + y1;
-                    float z5 = (zNMask | 1) + z1;
-                    value += (a5 * a5) * (a5 * a5) *
-                             GradCoord(seed2, i + PrimeX, j + (yNMask & (PrimeY << 1)), k + (zNMask & (PrimeZ << 1)),
-                                       x5, y5, z5);
-                }
-            }
+            x0 *= PrimeX;
+            y0 *= PrimeY;
+            z0 *= PrimeZ;
+            w0 *= PrimeW;
+            int x1 = x0 + PrimeX;
+            int y1 = y0 + PrimeY;
+            int z1 = z0 + PrimeZ;
+            int w1 = w0 + PrimeW;
 
-            if (!skip9) {
-                float a9 = xAFlipMask1 + zAFlipMask1 + a1;
-                if (a9 > 0) {
-                    float x9 = (xNMask | 1) + x1;
-                    float y9 = y1;
-                    float z9 = (zNMask | 1) + z1;
-                    value += (a9 * a9) * (a9 * a9) *
-                             GradCoord(seed2, i + (xNMask & (PrimeX * 2)), j + PrimeY, k + (zNMask & (PrimeZ << 1)), x9,
-                                       y9, z9);
-                }
-            }
+            float zf[2];
+            for (int wi = 0; wi < 2; wi++) {
+                int wPrimed = wi ? w1 : w0;
 
-            if (!skipD) {
-                float aD = xAFlipMask1 + yAFlipMask1 + a1;
-                if (aD > 0) {
-                    float xD = (xNMask | 1) + x1;
-                    float yD = (yNMask | 1) + y1;
-                    float zD = z1;
-                    value += (aD * aD) * (aD * aD) *
-                             GradCoord(seed2, i + (xNMask & (PrimeX << 1)), j + (yNMask & (PrimeY << 1)), k + PrimeZ,
-                                       xD, yD, zD);
-                }
+                float xf00 = Lerp(ValCoord(seed, x0, y0, z0, wPrimed), ValCoord(seed, x1, y0, z0, wPrimed), xs);
+                float xf10 = Lerp(ValCoord(seed, x0, y1, z0, wPrimed), ValCoord(seed, x1, y1, z0, wPrimed), xs);
+                float xf01 = Lerp(ValCoord(seed, x0, y0, z1, wPrimed), ValCoord(seed, x1, y0, z1, wPrimed), xs);
+                float xf11 = Lerp(ValCoord(seed, x0, y1, z1, wPrimed), ValCoord(seed, x1, y1, z1, wPrimed), xs);
+
+                float yf0 = Lerp(xf00, xf10, ys);
+                float yf1 = Lerp(xf01, xf11, ys);
+                zf[wi] = Lerp(yf0, yf1, zs);
             }
 
-            return value * 9.046026385208288f;
+            return Lerp(zf[0], zf[1], ws);
         }
 
-        // Cellular Noise
-
-        template <typename FNfloat> float SingleCellular(int seed, FNfloat x, FNfloat y) const {
-            int xr = FastRound(x);
-            int yr = FastRound(y);
-
+        template <typename FNfloat> float SingleCellular(int seed, FNfloat x, FNfloat y, FNfloat z, FNfloat w) const {
             float distance0 = 1e10f;
             float distance1 = 1e10f;
             int closestHash = 0;
 
-            float cellularJitter = 0.43701595f * mCellularJitterModifier;
-
-            int xPrimed = (xr - 1) * PrimeX;
-            int yPrimedBase = (yr - 1) * PrimeY;
-
             switch (mCellularDistanceFunction) {
-            default:
             case CellularDistanceFunction_Euclidean:
             case CellularDistanceFunction_EuclideanSq:
-                for (int xi = xr - 1; xi <= xr + 1; xi++) {
-                    int yPrimed = yPrimedBase;
-
-                    for (int yi = yr - 1; yi <= yr + 1; yi++) {
-                        int hash = Hash(seed, xPrimed, yPrimed);
-                        int idx = hash & (255 << 1);
-
-                        float vecX = (float)(xi - x) + Lookup<float>::RandVecs2D[idx] * cellularJitter;
-                        float vecY = (float)(yi - y) + Lookup<float>::RandVecs2D[idx | 1] * cellularJitter;
-
-                        float newDistance = vecX * vecX + vecY * vecY;
-
-                        distance1 = FastMax(FastMin(distance1, newDistance), distance0);
-                        if (newDistance < distance0) {
-                            distance0 = newDistance;
-                            closestHash = hash;
-                        }
-                        yPrimed += PrimeY;
-                    }
-                    xPrimed += PrimeX;
-                }
+                SearchCellular<CellularDistanceFunction_EuclideanSq>(seed, x, y, z, w, distance0, distance1,
+                                                                     closestHash);
                 break;
             case CellularDistanceFunction_Manhattan:
-                for (int xi = xr - 1; xi <= xr + 1; xi++) {
-                    int yPrimed = yPrimedBase;
-
-                    for (int yi = yr - 1; yi <= yr + 1; yi++) {
-                        int hash = Hash(seed, xPrimed, yPrimed);
-                        int idx = hash & (255 << 1);
-
-                        float vecX = (float)(xi - x) + Lookup<float>::RandVecs2D[idx] * cellularJitter;
-                        float vecY = (float)(yi - y) + Lookup<float>::RandVecs2D[idx | 1] * cellularJitter;
-
-                        float newDistance = FastAbs(vecX) + FastAbs(vecY);
-
-                        distance1 = FastMax(FastMin(distance1, newDistance), distance0);
-                        if (newDistance < distance0) {
-                            distance0 = newDistance;
-                            closestHash = hash;
-                        }
-                        yPrimed += PrimeY;
-                    }
-                    xPrimed += PrimeX;
-                }
+                SearchCellular<CellularDistanceFunction_Manhattan>(seed, x, y, z, w, distance0, distance1, closestHash);
                 break;
             case CellularDistanceFunction_Hybrid:
-                for (int xi = xr - 1; xi <= xr + 1; xi++) {
-                    int yPrimed = yPrimedBase;
-
-                    for (int yi = yr - 1; yi <= yr + 1; yi++) {
-                        int hash = Hash(seed, xPrimed, yPrimed);
-                        int idx = hash & (255 << 1);
-
-                        float vecX = (float)(xi - x) + Lookup<float>::RandVecs2D[idx] * cellularJitter;
-                        float vecY = (float)(yi - y) + Lookup<float>::RandVecs2D[idx | 1] * cellularJitter;
+                SearchCellular<CellularDistanceFunction_Hybrid>(seed, x, y, z, w, distance0, distance1, closestHash);
+                break;
+            default:
+                break;
+            }
 
-                        float newDistance = (FastAbs(vecX) + FastAbs(vecY)) + (vecX * vecX + vecY * vecY);
+            return CellularReturn(distance0, distance1, closestHash);
+        }
 
-                        distance1 = FastMax(FastMin(distance1, newDistance), distance0);
-                        if (newDistance < distance0) {
-                            distance0 = newDistance;
-                            closestHash = hash;
+        // Each 4D cell holds one feature point offset by up to 0.4 * jitter per axis, taken from four bytes of a
+        // remixed cell hash. The 81 neighbouring cells are visited centre first and skipped by distance bound as in
+        // the 3D search.
+        template <CellularDistanceFunction DistanceFunction, typename FNfloat>
+        void SearchCellular(int seed, FNfloat x, FNfloat y, FNfloat z, FNfloat w, float &distance0, float &distance1,
+                            int &closestHash) const {
+            const int order[3] = {0, -1, 1};
+            int xr = FastRound(x);
+            int yr = FastRound(y);
+            int zr = FastRound(z);
+            int wr = FastRound(w);
+
+            float cellularJitter = 0.4f * mCellularJitterModifier * (1 / 127.5f);
+            float boundJitter = FastAbs(0.4f * mCellularJitterModifier) * 1.0001f + 1e-5f;
+            bool needsDistance1 = mCellularReturnType >= CellularReturnType_Distance2;
+
+            for (int wo : order) {
+                int wi = wr + wo;
+                float axisW = (float)(wi - w);
+                float boundW = CellularAxisBound<DistanceFunction>(axisW, boundJitter);
+                if (boundW > (needsDistance1 ? distance1 : distance0))
+                    continue;
+
+                for (int zo : order) {
+                    int zi = zr + zo;
+                    float axisZ = (float)(zi - z);
+                    float boundZW = boundW + CellularAxisBound<DistanceFunction>(axisZ, boundJitter);
+                    if (boundZW > (needsDistance1 ? distance1 : distance0))
+                        continue;
+
+                    for (int yo : order) {
+                        int yi = yr + yo;
+                        float axisY = (float)(yi - y);
+                        float boundYZW = boundZW + CellularAxisBound<DistanceFunction>(axisY, boundJitter);
+                        if (boundYZW > (needsDistance1 ? distance1 : distance0))
+                            continue;
+
+                        for (int xo : order) {
+                            int xi = xr + xo;
+                            float axisX = (float)(xi - x);
+                            if (boundYZW + CellularAxisBound<DistanceFunction>(axisX, boundJitter) >
+                                (needsDistance1 ? distance1 : distance0))
+                                continue;
+
+                            int hash = Hash(seed, xi * PrimeX, yi * PrimeY, zi * PrimeZ, wi * PrimeW);
+                            int bits = hash ^ (hash >> 15);
+                            bits *= 0x2c1b3c6d;
+                            bits ^= bits >> 12;
+
+                            float vecX = axisX + ((float)(bits & 255) - 127.5f) * cellularJitter;
+                            float vecY = axisY + ((float)((bits >> 8) & 255) - 127.5f) * cellularJitter;
+                            float vecZ = axisZ + ((float)((bits >> 16) & 255) - 127.5f) * cellularJitter;
+                            float vecW = axisW + ((float)((bits >> 24) & 255) - 127.5f) * cellularJitter;
+                            ENTROPY_CELLULAR_VISIT();
+
+                            float newDistance = CellularDistance<DistanceFunction>(vecX, vecY, vecZ, vecW);
+                            distance1 = FastMax(FastMin(distance1, newDistance), distance0);
+                            if (newDistance < distance0) {
+                                distance0 = newDistance;
+                                closestHash = hash;
+                            }
                         }
-                        yPrimed += PrimeY;
                     }
-                    xPrimed += PrimeX;
                 }
-                break;
             }
+        }
 
-            if (mCellularDistanceFunction == CellularDistanceFunction_Euclidean &&
-                mCellularReturnType >= CellularReturnType_Distance) {
-                distance0 = FastSqrt(distance0);
+        template <CellularDistanceFunction DistanceFunction>
+        static float CellularDistance(float vecX, float vecY, float vecZ, float vecW) {
+            switch (DistanceFunction) {
+            case CellularDistanceFunction_Manhattan:
+                return FastAbs(vecX) + FastAbs(vecY) + FastAbs(vecZ) + FastAbs(vecW);
+            case CellularDistanceFunction_Hybrid:
+                return (FastAbs(vecX) + FastAbs(vecY) + FastAbs(vecZ) + FastAbs(vecW)) +
+                       (vecX * vecX + vecY * vecY + vecZ * vecZ + vecW * vecW);
+            default:
+                return vecX * vecX + vecY * vecY + vecZ * vecZ + vecW * vecW;
+            }
+        }
 
-                if (mCellularReturnType >= CellularReturnType_Distance2) {
-                    distance1 = FastSqrt(distance1);
-                }
+        // Domain Warp
+
+        template <typename FNfloat>
+        void DoSingleDomainWarp(int seed, float amp, float freq, FNfloat x, FNfloat y, FNfloat &xr, FNfloat &yr) const {
+            switch (mDomainWarpType) {
+            case DomainWarpType_OpenSimplex2:
+                SingleDomainWarpSimplexGradient<false>(seed, amp * 38.283687591552734375f, freq, x, y, xr, yr);
+                break;
+            case DomainWarpType_OpenSimplex2Reduced:
+                SingleDomainWarpSimplexGradient<true>(seed, amp * 16.0f, freq, x, y, xr, yr);
+                break;
+            case DomainWarpType_BasicGrid:
+                SingleDomainWarpBasicGrid(seed, amp, freq, x, y, xr, yr);
+                break;
             }
+        }
 
-            switch (mCellularReturnType) {
-            case CellularReturnType_CellValue:
-                return closestHash * (1 / 2147483648.0f);
-            case CellularReturnType_Distance:
-                return distance0 - 1;
-            case CellularReturnType_Distance2:
-                return distance1 - 1;
-            case CellularReturnType_Distance2Add:
-                return (distance1 + distance0) * 0.5f - 1;
-            case CellularReturnType_Distance2Sub:
-                return distance1 - distance0 - 1;
-            case CellularReturnType_Distance2Mul:
-                return distance1 * distance0 * 0.5f - 1;
-            case CellularReturnType_Distance2Div:
-                return distance0 / distance1 - 1;
-            default:
-                return 0;
+        template <typename FNfloat>
+        void DoSingleDomainWarp(int seed, float amp, float freq, FNfloat x, FNfloat y, FNfloat z, FNfloat &xr,
+                                FNfloat &yr, FNfloat &zr) const {
+            switch (mDomainWarpType) {
+            case DomainWarpType_OpenSimplex2:
+                SingleDomainWarpOpenSimplex2Gradient<false>(seed, amp * 32.69428253173828125f, freq, x, y, z, xr, yr,
+                                                            zr);
+                break;
+            case DomainWarpType_OpenSimplex2Reduced:
+                SingleDomainWarpOpenSimplex2Gradient<true>(seed, amp * 7.71604938271605f, freq, x, y, z, xr, yr, zr);
+                break;
+            case DomainWarpType_BasicGrid:
+                SingleDomainWarpBasicGrid(seed, amp, freq, x, y, z, xr, yr, zr);
+                break;
             }
         }
 
-        template <typename FNfloat> float SingleCellular(int seed, FNfloat x, FNfloat y, FNfloat z) const {
-            int xr = FastRound(x);
-            int yr = FastRound(y);
-            int zr = FastRound(z);
+        // Domain Warp Single Wrapper
 
-            float distance0 = 1e10f;
-            float distance1 = 1e10f;
-            int closestHash = 0;
+        template <typename FNfloat> void DomainWarpSingle(FNfloat &x, FNfloat &y) const {
+            int seed = mSeed;
+            float amp = mDomainWarpAmp * mFractalBounding;
+            float freq = mFrequency;
 
-            float cellularJitter = 0.39614353f * mCellularJitterModifier;
+            FNfloat xs = x;
+            FNfloat ys = y;
+            TransformDomainWarpCoordinate(xs, ys);
 
-            int xPrimed = (xr - 1) * PrimeX;
-            int yPrimedBase = (yr - 1) * PrimeY;
-            int zPrimedBase = (zr - 1) * PrimeZ;
+            DoSingleDomainWarp(seed, amp, freq, xs, ys, x, y);
+        }
 
-            switch (mCellularDistanceFunction) {
-            case CellularDistanceFunction_Euclidean:
-            case CellularDistanceFunction_EuclideanSq:
-                for (int xi = xr - 1; xi <= xr + 1; xi++) {
-                    int yPrimed = yPrimedBase;
+        template <typename FNfloat> void DomainWarpSingle(FNfloat &x, FNfloat &y, FNfloat &z) const {
+            int seed = mSeed;
+            float amp = mDomainWarpAmp * mFractalBounding;
+            float freq = mFrequency;
 
-                    for (int yi = yr - 1; yi <= yr + 1; yi++) {
-                        int zPrimed = zPrimedBase;
+            FNfloat xs = x;
+            FNfloat ys = y;
+            FNfloat zs = z;
+            TransformDomainWarpCoordinate(xs, ys, zs);
 
-                        for (int zi = zr - 1; zi <= zr + 1; zi++) {
-                            int hash = Hash(seed, xPrimed, yPrimed, zPrimed);
-                            int idx = hash & (255 << 2);
+            DoSingleDomainWarp(seed, amp, freq, xs, ys, zs, x, y, z);
+        }
 
-                            float vecX = (float)(xi - x) + Lookup<float>::RandVecs3D[idx] * cellularJitter;
-                            float vecY = (float)(yi - y) + Lookup<float>::RandVecs3D[idx | 1] * cellularJitter;
-                            float vecZ = (float)(zi - z) + Lookup<float>::RandVecs3D[idx | 2] * cellularJitter;
+        // Domain Warp Fractal Progressive
 
-                            float newDistance = vecX * vecX + vecY * vecY + vecZ * vecZ;
+        template <typename FNfloat> void DomainWarpFractalProgressive(FNfloat &x, FNfloat &y) const {
+            int seed = mSeed;
+            float amp = mDomainWarpAmp * mFractalBounding;
+            float freq = mFrequency;
 
-                            distance1 = FastMax(FastMin(distance1, newDistance), distance0);
-                            if (newDistance < distance0) {
-                                distance0 = newDistance;
-                                closestHash = hash;
-                            }
-                            zPrimed += PrimeZ;
-                        }
-                        yPrimed += PrimeY;
-                    }
-                    xPrimed += PrimeX;
-                }
-                break;
-            case CellularDistanceFunction_Manhattan:
-                for (int xi = xr - 1; xi <= xr + 1; xi++) {
-                    int yPrimed = yPrimedBase;
+            for (int i = 0; i < mWarpOctaves; i++) {
+                FNfloat xs = x;
+                FNfloat ys = y;
+                TransformDomainWarpCoordinate(xs, ys);
 
-                    for (int yi = yr - 1; yi <= yr + 1; yi++) {
-                        int zPrimed = zPrimedBase;
+                DoSingleDomainWarp(seed, amp, freq, xs, ys, x, y);
 
-                        for (int zi = zr - 1; zi <= zr + 1; zi++) {
-                            int hash = Hash(seed, xPrimed, yPrimed, zPrimed);
-                            int idx = hash & (255 << 2);
+                seed++;
+                amp *= mGain;
+                freq *= mLacunarity;
+            }
+        }
 
-                            float vecX = (float)(xi - x) + Lookup<float>::RandVecs3D[idx] * cellularJitter;
-                            float vecY = (float)(yi - y) + Lookup<float>::RandVecs3D[idx | 1] * cellularJitter;
-                            float vecZ = (float)(zi - z) + Lookup<float>::RandVecs3D[idx | 2] * cellularJitter;
+        template <typename FNfloat> void DomainWarpFractalProgressive(FNfloat &x, FNfloat &y, FNfloat &z) const {
+            int seed = mSeed;
+            float amp = mDomainWarpAmp * mFractalBounding;
+            float freq = mFrequency;
 
-                            float newDistance = FastAbs(vecX) + FastAbs(vecY) + FastAbs(vecZ);
+            for (int i = 0; i < mWarpOctaves; i++) {
+                FNfloat xs = x;
+                FNfloat ys = y;
+                FNfloat zs = z;
+                TransformDomainWarpCoordinate(xs, ys, zs);
 
-                            distance1 = FastMax(FastMin(distance1, newDistance), distance0);
-                            if (newDistance < distance0) {
-                                distance0 = newDistance;
-                                closestHash = hash;
-                            }
-                            zPrimed += PrimeZ;
-                        }
-                        yPrimed += PrimeY;
-                    }
-                    xPrimed += PrimeX;
-                }
-                break;
-            case CellularDistanceFunction_Hybrid:
-                for (int xi = xr - 1; xi <= xr + 1; xi++) {
-                    int yPrimed = yPrimedBase;
+                DoSingleDomainWarp(seed, amp, freq, xs, ys, zs, x, y, z);
+
+                seed++;
+                amp *= mGain;
+                freq *= mLacunarity;
+            }
+        }
 
-                    for (int yi = yr - 1; yi <= yr + 1; yi++) {
-                        int zPrimed = zPrimedBase;
+        // Domain Warp Fractal Independant
 
-                        for (int zi = zr - 1; zi <= zr + 1; zi++) {
-                            int hash = Hash(seed, xPrimed, yPrimed, zPrimed);
-                            int idx = hash & (255 << 2);
+        // Octaves all warp the same transformed position, so they run as octave lanes (see GenFractalFBmLanes) whose
+        // displacements are added in octave order
 
-                            float vecX = (float)(xi - x) + Lookup<float>::RandVecs3D[idx] * cellularJitter;
-                            float vecY = (float)(yi - y) + Lookup<float>::RandVecs3D[idx | 1] * cellularJitter;
-                            float vecZ = (float)(zi - z) + Lookup<float>::RandVecs3D[idx | 2] * cellularJitter;
+        template <typename FNfloat> void DomainWarpFractalIndependent(FNfloat &x, FNfloat &y) const {
+            FNfloat xs = x;
+            FNfloat ys = y;
+            TransformDomainWarpCoordinate(xs, ys);
 
-                            float newDistance = (FastAbs(vecX) + FastAbs(vecY) + FastAbs(vecZ)) +
-                                                (vecX * vecX + vecY * vecY + vecZ * vecZ);
+            float amps[OctaveLanes];
+            float freqs[OctaveLanes];
+            FNfloat dx[OctaveLanes];
+            FNfloat dy[OctaveLanes];
 
-                            distance1 = FastMax(FastMin(distance1, newDistance), distance0);
-                            if (newDistance < distance0) {
-                                distance0 = newDistance;
-                                closestHash = hash;
-                            }
-                            zPrimed += PrimeZ;
-                        }
-                        yPrimed += PrimeY;
-                    }
-                    xPrimed += PrimeX;
-                }
-                break;
-            default:
-                break;
-            }
+            int seed = mSeed;
+            float amp = mDomainWarpAmp * mFractalBounding;
+            float freq = mFrequency;
 
-            if (mCellularDistanceFunction == CellularDistanceFunction_Euclidean &&
-                mCellularReturnType >= CellularReturnType_Distance) {
-                distance0 = FastSqrt(distance0);
+            for (int o = 0; o < mWarpOctaves; o += OctaveLanes) {
+                int count = mWarpOctaves - o < OctaveLanes ? mWarpOctaves - o : OctaveLanes;
 
-                if (mCellularReturnType >= CellularReturnType_Distance2) {
-                    distance1 = FastSqrt(distance1);
+                for (int i = 0; i < count; i++) {
+                    amps[i] = amp;
+                    freqs[i] = freq;
+                    dx[i] = dy[i] = 0;
+                    amp *= mGain;
+                    freq *= mLacunarity;
                 }
-            }
+                DoDomainWarpLanes(seed, amps, freqs, xs, ys, dx, dy, count);
+                seed += count;
 
-            switch (mCellularReturnType) {
-            case CellularReturnType_CellValue:
-                return closestHash * (1 / 2147483648.0f);
-            case CellularReturnType_Distance:
-                return distance0 - 1;
-            case CellularReturnType_Distance2:
-                return distance1 - 1;
-            case CellularReturnType_Distance2Add:
-                return (distance1 + distance0) * 0.5f - 1;
-            case CellularReturnType_Distance2Sub:
-                return distance1 - distance0 - 1;
-            case CellularReturnType_Distance2Mul:
-                return distance1 * distance0 * 0.5f - 1;
-            case CellularReturnType_Distance2Div:
-                return distance0 / distance1 - 1;
-            default:
-                return 0;
+                for (int i = 0; i < count; i++) {
+                    x += dx[i];
+                    y += dy[i];
+                }
             }
         }
 
-        // Perlin Noise
+        template <typename FNfloat> void DomainWarpFractalIndependent(FNfloat &x, FNfloat &y, FNfloat &z) const {
+            FNfloat xs = x;
+            FNfloat ys = y;
+            FNfloat zs = z;
+            TransformDomainWarpCoordinate(xs, ys, zs);
 
-        template <typename FNfloat> float SinglePerlin(int seed, FNfloat x, FNfloat y) const {
-            int x0 = FastFloor(x);
-            int y0 = FastFloor(y);
+            float amps[OctaveLanes];
+            float freqs[OctaveLanes];
+            FNfloat dx[OctaveLanes];
+            FNfloat dy[OctaveLanes];
+            FNfloat dz[OctaveLanes];
 
-            float xd0 = (float)(x - x0);
-            float yd0 = (float)(y - y0);
-            float xd1 = xd0 - 1;
-            float yd1 = yd0 - 1;
+            int seed = mSeed;
+            float amp = mDomainWarpAmp * mFractalBounding;
+            float freq = mFrequency;
 
-            float xs = InterpQuintic(xd0);
-            float ys = InterpQuintic(yd0);
+            for (int o = 0; o < mWarpOctaves; o += OctaveLanes) {
+                int count = mWarpOctaves - o < OctaveLanes ? mWarpOctaves - o : OctaveLanes;
 
-            x0 *= PrimeX;
-            y0 *= PrimeY;
-            int x1 = x0 + PrimeX;
-            int y1 = y0 + PrimeY;
+                for (int i = 0; i < count; i++) {
+                    amps[i] = amp;
+                    freqs[i] = freq;
+                    dx[i] = dy[i] = dz[i] = 0;
+                    amp *= mGain;
+                    freq *= mLacunarity;
+                }
+                DoDomainWarpLanes(seed, amps, freqs, xs, ys, zs, dx, dy, dz, count);
+                seed += count;
 
-            float xf0 = Lerp(GradCoord(seed, x0, y0, xd0, yd0), GradCoord(seed, x1, y0, xd1, yd0), xs);
-            float xf1 = Lerp(GradCoord(seed, x0, y1, xd0, yd1), GradCoord(seed, x1, y1, xd1, yd1), xs);
+                for (int i = 0; i < count; i++) {
+                    x += dx[i];
+                    y += dy[i];
+                    z += dz[i];
+                }
+            }
+        }
 
-            return Lerp(xf0, xf1, ys) * 1.4247691104677813f;
+        template <typename FNfloat>
+        void DoDomainWarpLanes(int seed, const float *amps, const float *freqs, FNfloat x, FNfloat y, FNfloat *xr,
+                               FNfloat *yr, int count) const {
+            switch (mDomainWarpType) {
+            case DomainWarpType_OpenSimplex2:
+                for (int i = 0; i < count; i++)
+                    SingleDomainWarpSimplexGradient<false>(seed + i, amps[i] * 38.283687591552734375f, freqs[i], x, y,
+                                                           xr[i], yr[i]);
+                break;
+            case DomainWarpType_OpenSimplex2Reduced:
+                for (int i = 0; i < count; i++)
+                    SingleDomainWarpSimplexGradient<true>(seed + i, amps[i] * 16.0f, freqs[i], x, y, xr[i], yr[i]);
+                break;
+            case DomainWarpType_BasicGrid:
+                for (int i = 0; i < count; i++)
+                    SingleDomainWarpBasicGrid(seed + i, amps[i], freqs[i], x, y, xr[i], yr[i]);
+                break;
+            }
         }
 
-        template <typename FNfloat> float SinglePerlin(int seed, FNfloat x, FNfloat y, FNfloat z) const {
-            int x0 = FastFloor(x);
-            int y0 = FastFloor(y);
-            int z0 = FastFloor(z);
+        template <typename FNfloat>
+        void DoDomainWarpLanes(int seed, const float *amps, const float *freqs, FNfloat x, FNfloat y, FNfloat z,
+                               FNfloat *xr, FNfloat *yr, FNfloat *zr, int count) const {
+            switch (mDomainWarpType) {
+            case DomainWarpType_OpenSimplex2:
+                for (int i = 0; i < count; i++)
+                    SingleDomainWarpOpenSimplex2Gradient<false>(seed + i, amps[i] * 32.69428253173828125f, freqs[i], x,
+                                                                y, z, xr[i], yr[i], zr[i]);
+                break;
+            case DomainWarpType_OpenSimplex2Reduced:
+                for (int i = 0; i < count; i++)
+                    SingleDomainWarpOpenSimplex2Gradient<true>(seed + i, amps[i] * 7.71604938271605f, freqs[i], x, y,
+                                                               z, xr[i], yr[i], zr[i]);
+                break;
+            case DomainWarpType_BasicGrid:
+                for (int i = 0; i < count; i++)
+                    SingleDomainWarpBasicGrid(seed + i, amps[i], freqs[i], x, y, z, xr[i], yr[i], zr[i]);
+                break;
+            }
+        }
 
-            float xd0 = (float)(x - x0);
-            float yd0 = (float)(y - y0);
-            float zd0 = (float)(z - z0);
-            float xd1 = xd0 - 1;
-            float yd1 = yd0 - 1;
-            float zd1 = zd0 - 1;
+        // Domain Warp Spans
+        // Same octave loops as the wrappers above, run over a span of positions one octave at a time so the warp type
+        // and coordinate transform switches are taken once per span and the kernel loops stay free of dispatch.
 
-            float xs = InterpQuintic(xd0);
-            float ys = InterpQuintic(yd0);
-            float zs = InterpQuintic(zd0);
+        template <typename FNfloat> void DomainWarpSpan(FNfloat *x, FNfloat *y, int count) const {
+            FNfloat xs[BatchSize];
+            FNfloat ys[BatchSize];
 
-            x0 *= PrimeX;
-            y0 *= PrimeY;
-            z0 *= PrimeZ;
-            int x1 = x0 + PrimeX;
-            int y1 = y0 + PrimeY;
-            int z1 = z0 + PrimeZ;
+            bool fractal = mFractalType == FractalType_DomainWarpProgressive ||
+                           mFractalType == FractalType_DomainWarpIndependent;
+            bool progressive = mFractalType == FractalType_DomainWarpProgressive;
+            int octaves = fractal ? mWarpOctaves : 1;
 
-            float xf00 =
-                Lerp(GradCoord(seed, x0, y0, z0, xd0, yd0, zd0), GradCoord(seed, x1, y0, z0, xd1, yd0, zd0), xs);
-            float xf10 =
-                Lerp(GradCoord(seed, x0, y1, z0, xd0, yd1, zd0), GradCoord(seed, x1, y1, z0, xd1, yd1, zd0), xs);
-            float xf01 =
-                Lerp(GradCoord(seed, x0, y0, z1, xd0, yd0, zd1), GradCoord(seed, x1, y0, z1, xd1, yd0, zd1), xs);
-            float xf11 =
-                Lerp(GradCoord(seed, x0, y1, z1, xd0, yd1, zd1), GradCoord(seed, x1, y1, z1, xd1, yd1, zd1), xs);
+            int seed = mSeed;
+            float amp = mDomainWarpAmp * mFractalBounding;
+            float freq = mFrequency;
 
-            float yf0 = Lerp(xf00, xf10, ys);
-            float yf1 = Lerp(xf01, xf11, ys);
+            for (int o = 0; o < octaves; o++) {
+                if (o == 0 || progressive) {
+                    for (int i = 0; i < count; i++) {
+                        xs[i] = x[i];
+                        ys[i] = y[i];
+                    }
+                    TransformDomainWarpSpan(xs, ys, count);
+                }
 
-            return Lerp(yf0, yf1, zs) * 0.964921414852142333984375f;
+                DoDomainWarpSpan(seed, amp, freq, xs, ys, x, y, count);
+
+                seed++;
+                amp *= mGain;
+                freq *= mLacunarity;
+            }
         }
 
-        // Value Cubic Noise
+        template <typename FNfloat> void DomainWarpSpan(FNfloat *x, FNfloat *y, FNfloat *z, int count) const {
+            FNfloat xs[BatchSize];
+            FNfloat ys[BatchSize];
+            FNfloat zs[BatchSize];
 
-        template <typename FNfloat> float SingleValueCubic(int seed, FNfloat x, FNfloat y) const {
-            int x1 = FastFloor(x);
-            int y1 = FastFloor(y);
+            bool fractal = mFractalType == FractalType_DomainWarpProgressive ||
+                           mFractalType == FractalType_DomainWarpIndependent;
+            bool progressive = mFractalType == FractalType_DomainWarpProgressive;
+            int octaves = fractal ? mWarpOctaves : 1;
 
-            float xs = (float)(x - x1);
-            float ys = (float)(y - y1);
+            int seed = mSeed;
+            float amp = mDomainWarpAmp * mFractalBounding;
+            float freq = mFrequency;
 
-            x1 *= PrimeX;
-            y1 *= PrimeY;
-            int x0 = x1 - PrimeX;
-            int y0 = y1 - PrimeY;
-            int x2 = x1 + PrimeX;
-            int y2 = y1 + PrimeY;
-            int x3 = x1 + (int)((long)PrimeX << 1);
-            int y3 = y1 + (int)((long)PrimeY << 1);
+            for (int o = 0; o < octaves; o++) {
+                if (o == 0 || progressive) {
+                    for (int i = 0; i < count; i++) {
+                        xs[i] = x[i];
+                        ys[i] = y[i];
+                        zs[i] = z[i];
+                    }
+                    TransformDomainWarpSpan(xs, ys, zs, count);
+                }
 
-            return CubicLerp(CubicLerp(ValCoord(seed, x0, y0), ValCoord(seed, x1, y0), ValCoord(seed, x2, y0),
-                                       ValCoord(seed, x3, y0), xs),
-                             CubicLerp(ValCoord(seed, x0, y1), ValCoord(seed, x1, y1), ValCoord(seed, x2, y1),
-                                       ValCoord(seed, x3, y1), xs),
-                             CubicLerp(ValCoord(seed, x0, y2), ValCoord(seed, x1, y2), ValCoord(seed, x2, y2),
-                                       ValCoord(seed, x3, y2), xs),
-                             CubicLerp(ValCoord(seed, x0, y3), ValCoord(seed, x1, y3), ValCoord(seed, x2, y3),
-                                       ValCoord(seed, x3, y3), xs),
-                             ys) *
-                   (1 / (1.5f * 1.5f));
+                DoDomainWarpSpan(seed, amp, freq, xs, ys, zs, x, y, z, count);
+
+                seed++;
+                amp *= mGain;
+                freq *= mLacunarity;
+            }
         }
 
-        template <typename FNfloat> float SingleValueCubic(int seed, FNfloat x, FNfloat y, FNfloat z) const {
-            int x1 = FastFloor(x);
-            int y1 = FastFloor(y);
-            int z1 = FastFloor(z);
+        template <typename FNfloat> void TransformDomainWarpSpan(FNfloat *xs, FNfloat *ys, int count) const {
+            if (mDomainWarpType == DomainWarpType_BasicGrid)
+                return;
 
-            float xs = (float)(x - x1);
-            float ys = (float)(y - y1);
-            float zs = (float)(z - z1);
+            for (int i = 0; i < count; i++) {
+                const FNfloat SQRT3 = (FNfloat)1.7320508075688772935274463415059;
+                const FNfloat F2 = 0.5f * (SQRT3 - 1);
+                FNfloat t = (xs[i] + ys[i]) * F2;
+                xs[i] += t;
+                ys[i] += t;
+            }
+        }
 
-            x1 *= PrimeX;
-            y1 *= PrimeY;
-            z1 *= PrimeZ;
+        template <typename FNfloat>
+        void TransformDomainWarpSpan(FNfloat *xs, FNfloat *ys, FNfloat *zs, int count) const {
+            switch (mWarpTransformType3D) {
+            case TransformType3D_ImproveXYPlanes:
+                for (int i = 0; i < count; i++)
+                    TransformDomainWarpCoordinate<TransformType3D_ImproveXYPlanes>(xs[i], ys[i], zs[i]);
+                break;
+            case TransformType3D_ImproveXZPlanes:
+                for (int i = 0; i < count; i++)
+                    TransformDomainWarpCoordinate<TransformType3D_ImproveXZPlanes>(xs[i], ys[i], zs[i]);
+                break;
+            case TransformType3D_DefaultOpenSimplex2:
+                for (int i = 0; i < count; i++)
+                    TransformDomainWarpCoordinate<TransformType3D_DefaultOpenSimplex2>(xs[i], ys[i], zs[i]);
+                break;
+            default:
+                break;
+            }
+        }
 
-            int x0 = x1 - PrimeX;
-            int y0 = y1 - PrimeY;
-            int z0 = z1 - PrimeZ;
-            int x2 = x1 + PrimeX;
-            int y2 = y1 + PrimeY;
-            int z2 = z1 + PrimeZ;
-            int x3 = x1 + (int)((long)PrimeX << 1);
-            int y3 = y1 + (int)((long)PrimeY << 1);
-            int z3 = z1 + (int)((long)PrimeZ << 1);
+        template <typename FNfloat>
+        void DoDomainWarpSpan(int seed, float amp, float freq, const FNfloat *xs, const FNfloat *ys, FNfloat *xr,
+                              FNfloat *yr, int count) const {
+            switch (mDomainWarpType) {
+            case DomainWarpType_OpenSimplex2: {
+                float warpAmp = amp * 38.283687591552734375f;
+                for (int i = 0; i < count; i++)
+                    SingleDomainWarpSimplexGradient<false>(seed, warpAmp, freq, xs[i], ys[i], xr[i], yr[i]);
+            } break;
+            case DomainWarpType_OpenSimplex2Reduced: {
+                float warpAmp = amp * 16.0f;
+                for (int i = 0; i < count; i++)
+                    SingleDomainWarpSimplexGradient<true>(seed, warpAmp, freq, xs[i], ys[i], xr[i], yr[i]);
+            } break;
+            case DomainWarpType_BasicGrid:
+                for (int i = 0; i < count; i++)
+                    SingleDomainWarpBasicGrid(seed, amp, freq, xs[i], ys[i], xr[i], yr[i]);
+                break;
+            }
+        }
 
-            return CubicLerp(CubicLerp(CubicLerp(ValCoord(seed, x0, y0, z0), ValCoord(seed, x1, y0, z0),
-                                                 ValCoord(seed, x2, y0, z0), ValCoord(seed, x3, y0, z0), xs),
-                                       CubicLerp(ValCoord(seed, x0, y1, z0), ValCoord(seed, x1, y1, z0),
-                                                 ValCoord(seed, x2, y1, z0), ValCoord(seed, x3, y1, z0), xs),
-                                       CubicLerp(ValCoord(seed, x0, y2, z0), ValCoord(seed, x1, y2, z0),
-                                                 ValCoord(seed, x2, y2, z0), ValCoord(seed, x3, y2, z0), xs),
-                                       CubicLerp(ValCoord(seed, x0, y3, z0), ValCoord(seed, x1, y3, z0),
-                                                 ValCoord(seed, x2, y3, z0), ValCoord(seed, x3, y3, z0), xs),
-                                       ys),
-                             CubicLerp(CubicLerp(ValCoord(seed, x0, y0, z1), ValCoord(seed, x1, y0, z1),
-                                                 ValCoord(seed, x2, y0, z1), ValCoord(seed, x3, y0, z1), xs),
-                                       CubicLerp(ValCoord(seed, x0, y1, z1), ValCoord(seed, x1, y1, z1),
-                                                 ValCoord(seed, x2, y1, z1), ValCoord(seed, x3, y1, z1), xs),
-                                       CubicLerp(ValCoord(seed, x0, y2, z1), ValCoord(seed, x1, y2, z1),
-                                                 ValCoord(seed, x2, y2, z1), ValCoord(seed, x3, y2, z1), xs),
-                                       CubicLerp(ValCoord(seed, x0, y3, z1), ValCoord(seed, x1, y3, z1),
-                                                 ValCoord(seed, x2, y3, z1), ValCoord(seed, x3, y3, z1), xs),
-                                       ys),
-                             CubicLerp(CubicLerp(ValCoord(seed, x0, y0, z2), ValCoord(seed, x1, y0, z2),
-                                                 ValCoord(seed, x2, y0, z2), ValCoord(seed, x3, y0, z2), xs),
-                                       CubicLerp(ValCoord(seed, x0, y1, z2), ValCoord(seed, x1, y1, z2),
-                                                 ValCoord(seed, x2, y1, z2), ValCoord(seed, x3, y1, z2), xs),
-                                       CubicLerp(ValCoord(seed, x0, y2, z2), ValCoord(seed, x1, y2, z2),
-                                                 ValCoord(seed, x2, y2, z2), ValCoord(seed, x3, y2, z2), xs),
-                                       CubicLerp(ValCoord(seed, x0, y3, z2), ValCoord(seed, x1, y3, z2),
-                                                 ValCoord(seed, x2, y3, z2), ValCoord(seed, x3, y3, z2), xs),
-                                       ys),
-                             CubicLerp(CubicLerp(ValCoord(seed, x0, y0, z3), ValCoord(seed, x1, y0, z3),
-                                                 ValCoord(seed, x2, y0, z3), ValCoord(seed, x3, y0, z3), xs),
-                                       CubicLerp(ValCoord(seed, x0, y1, z3), ValCoord(seed, x1, y1, z3),
-                                                 ValCoord(seed, x2, y1, z3), ValCoord(seed, x3, y1, z3), xs),
-                                       CubicLerp(ValCoord(seed, x0, y2, z3), ValCoord(seed, x1, y2, z3),
-                                                 ValCoord(seed, x2, y2, z3), ValCoord(seed, x3, y2, z3), xs),
-                                       CubicLerp(ValCoord(seed, x0, y3, z3), ValCoord(seed, x1, y3, z3),
-                                                 ValCoord(seed, x2, y3, z3), ValCoord(seed, x3, y3, z3), xs),
-                                       ys),
-                             zs) *
-                   (1 / (1.5f * 1.5f * 1.5f));
+        template <typename FNfloat>
+        void DoDomainWarpSpan(int seed, float amp, float freq, const FNfloat *xs, const FNfloat *ys, const FNfloat *zs,
+                              FNfloat *xr, FNfloat *yr, FNfloat *zr, int count) const {
+            switch (mDomainWarpType) {
+            case DomainWarpType_OpenSimplex2: {
+                float warpAmp = amp * 32.69428253173828125f;
+                for (int i = 0; i < count; i++)
+                    SingleDomainWarpOpenSimplex2Gradient<false>(seed, warpAmp, freq, xs[i], ys[i], zs[i], xr[i], yr[i],
+                                                                zr[i]);
+            } break;
+            case DomainWarpType_OpenSimplex2Reduced: {
+                float warpAmp = amp * 7.71604938271605f;
+                for (int i = 0; i < count; i++)
+                    SingleDomainWarpOpenSimplex2Gradient<true>(seed, warpAmp, freq, xs[i], ys[i], zs[i], xr[i], yr[i],
+                                                               zr[i]);
+            } break;
+            case DomainWarpType_BasicGrid:
+                for (int i = 0; i < count; i++)
+                    SingleDomainWarpBasicGrid(seed, amp, freq, xs[i], ys[i], zs[i], xr[i], yr[i], zr[i]);
+                break;
+            }
         }
 
-        // Value Noise
+        // Warp Field
+        // Node n of an axis sits on grid position (start + (n - 1) * decimation) * step. Interpolation uses nodes
+        // cell + 1 and cell + 2 (linear) or cell ... cell + 3 (cubic) for a sample in coarse cell "cell".
+
+        static void InitWarpField(WarpField &field, int dimensions, int xStart, int yStart, int zStart, int xSize,
+                                  int ySize, int zSize, int decimation, float step, bool cubic) {
+            field.dimensions = dimensions;
+            field.xStart = xStart;
+            field.yStart = yStart;
+            field.zStart = zStart;
+            field.xSize = xSize > 0 ? xSize : 0;
+            field.ySize = ySize > 0 ? ySize : 0;
+            field.zSize = zSize > 0 ? zSize : 0;
+            field.step = step;
+            field.decimation = decimation < 1 ? 1 : decimation;
+            field.cubic = cubic;
+            field.xNodes = WarpFieldNodeCount(field.xSize, field.decimation);
+            field.yNodes = WarpFieldNodeCount(field.ySize, field.decimation);
+            field.zNodes = dimensions == 3 ? WarpFieldNodeCount(field.zSize, field.decimation) : 1;
+            field.displacement.assign((size_t)field.xNodes * field.yNodes * field.zNodes * dimensions, 0.0f);
+            field.maxError = 0;
+        }
 
-        template <typename FNfloat> float SingleValue(int seed, FNfloat x, FNfloat y) const {
-            int x0 = FastFloor(x);
-            int y0 = FastFloor(y);
+        static int WarpFieldNodeCount(int size, int decimation) {
+            return size > 0 ? (size - 1) / decimation + 4 : 0;
+        }
 
-            float xs = InterpHermite((float)(x - x0));
-            float ys = InterpHermite((float)(y - y0));
+        static float WarpFieldNodePosition(const WarpField &field, int start, int node) {
+            return (float)(start + (node - 1) * field.decimation) * field.step;
+        }
 
-            x0 *= PrimeX;
-            y0 *= PrimeY;
-            int x1 = x0 + PrimeX;
-            int y1 = y0 + PrimeY;
+        static void WarpFieldWeights(float t, bool cubic, float *w) {
+            if (!cubic) {
+                w[0] = 1 - t;
+                w[1] = t;
+                return;
+            }
 
-            float xf0 = Lerp(ValCoord(seed, x0, y0), ValCoord(seed, x1, y0), xs);
-            float xf1 = Lerp(ValCoord(seed, x0, y1), ValCoord(seed, x1, y1), xs);
+            float t2 = t * t;
+            float t3 = t2 * t;
+            w[0] = 0.5f * (-t3 + 2 * t2 - t);
+            w[1] = 0.5f * (3 * t3 - 5 * t2 + 2);
+            w[2] = 0.5f * (-3 * t3 + 4 * t2 + t);
+            w[3] = 0.5f * (t3 - t2);
+        }
 
-            return Lerp(xf0, xf1, ys);
+        static void SampleWarpField(const WarpField &field, int xCell, float xt, int yCell, float yt, int zCell,
+                                    float zt, float *out) {
+            int taps = field.cubic ? 4 : 2;
+            int offset = field.cubic ? 0 : 1;
+            int zTaps = field.dimensions == 3 ? taps : 1;
+            float wx[4], wy[4], wz[4] = {1, 0, 0, 0};
+            WarpFieldWeights(xt, field.cubic, wx);
+            WarpFieldWeights(yt, field.cubic, wy);
+            if (field.dimensions == 3)
+                WarpFieldWeights(zt, field.cubic, wz);
+
+            out[0] = out[1] = out[2] = 0;
+            for (int c = 0; c < zTaps; c++) {
+                int zn = field.dimensions == 3 ? zCell + offset + c : 0;
+                for (int b = 0; b < taps; b++) {
+                    int yn = yCell + offset + b;
+                    for (int a = 0; a < taps; a++) {
+                        int xn = xCell + offset + a;
+                        float weight = wz[c] * wy[b] * wx[a];
+                        const float *node = field.displacement.data() +
+                                            (((size_t)zn * field.yNodes + yn) * field.xNodes + xn) * field.dimensions;
+                        for (int k = 0; k < field.dimensions; k++) {
+                            out[k] += weight * node[k];
+                        }
+                    }
+                }
+            }
         }
 
-        template <typename FNfloat> float SingleValue(int seed, FNfloat x, FNfloat y, FNfloat z) const {
-            int x0 = FastFloor(x);
-            int y0 = FastFloor(y);
-            int z0 = FastFloor(z);
+        // First node and four weights per grid column, linear interpolation is padded to four taps with zero weights
+        static void WarpFieldColumns(const WarpField &field, std::vector<int> &node, std::vector<float> &weight) {
+            node.resize(field.xSize);
+            weight.assign((size_t)field.xSize * 4, 0.0f);
+            float invDecimation = 1.0f / field.decimation;
+
+            for (int x = 0; x < field.xSize; x++) {
+                int cell = x / field.decimation;
+                float *w = weight.data() + (size_t)x * 4;
+                node[x] = cell;
+                WarpFieldWeights((x - cell * field.decimation) * invDecimation, field.cubic,
+                                 field.cubic ? w : w + 1);
+            }
+        }
 
-            float xs = InterpHermite((float)(x - x0));
-            float ys = InterpHermite((float)(y - y0));
-            float zs = InterpHermite((float)(z - z0));
+        // Interpolates the field along y and z for grid row (y, z), leaving one value per x node and component
+        static void CollapseWarpField(const WarpField &field, int y, int z, float *row) {
+            int taps = field.cubic ? 4 : 2;
+            int offset = field.cubic ? 0 : 1;
+            int zTaps = field.dimensions == 3 ? taps : 1;
+            float invDecimation = 1.0f / field.decimation;
+            int yCell = y / field.decimation;
+            int zCell = z / field.decimation;
+            float wy[4], wz[4] = {1, 0, 0, 0};
+            WarpFieldWeights((y - yCell * field.decimation) * invDecimation, field.cubic, wy);
+            if (field.dimensions == 3)
+                WarpFieldWeights((z - zCell * field.decimation) * invDecimation, field.cubic, wz);
+
+            size_t rowLength = (size_t)field.xNodes * field.dimensions;
+            for (size_t i = 0; i < rowLength; i++) {
+                row[i] = 0;
+            }
 
-            x0 *= PrimeX;
-            y0 *= PrimeY;
-            z0 *= PrimeZ;
-            int x1 = x0 + PrimeX;
-            int y1 = y0 + PrimeY;
-            int z1 = z0 + PrimeZ;
+            for (int c = 0; c < zTaps; c++) {
+                int zn = field.dimensions == 3 ? zCell + offset + c : 0;
+                for (int b = 0; b < taps; b++) {
+                    int yn = yCell + offset + b;
+                    float weight = wz[c] * wy[b];
+                    const float *nodes =
+                        field.displacement.data() + ((size_t)zn * field.yNodes + yn) * rowLength;
+                    for (size_t i = 0; i < rowLength; i++) {
+                        row[i] += weight * nodes[i];
+                    }
+                }
+            }
+        }
 
-            float xf00 = Lerp(ValCoord(seed, x0, y0, z0), ValCoord(seed, x1, y0, z0), xs);
-            float xf10 = Lerp(ValCoord(seed, x0, y1, z0), ValCoord(seed, x1, y1, z0), xs);
-            float xf01 = Lerp(ValCoord(seed, x0, y0, z1), ValCoord(seed, x1, y0, z1), xs);
-            float xf11 = Lerp(ValCoord(seed, x0, y1, z1), ValCoord(seed, x1, y1, z1), xs);
+        // Quantized Output
+        // Grids are generated span by span as for float output, each finished span is remapped and converted while
+        // it is still in cache.
 
-            float yf0 = Lerp(xf00, xf10, ys);
-            float yf1 = Lerp(xf01, xf11, ys);
+        struct QuantizeUNorm {
+            float scale, bias, max;
 
-            return Lerp(yf0, yf1, zs);
-        }
+            // Clamping before the cast keeps it defined, NaN clamps to 0. Members are copied to locals since 8-bit
+            // stores may alias them, which would stop the loop from vectorizing.
+            template <typename T> void Store(const float *noise, T *out, int count) const {
+                float s = scale, b = bias, m = max;
+                for (int i = 0; i < count; i++) {
+                    out[i] = (T)FastMin(FastMax(noise[i] * s + b, 0), m);
+                }
+            }
+        };
 
-        // Domain Warp
+        struct QuantizeHalf {
+            float scale, offset;
 
-        template <typename FNfloat>
-        void DoSingleDomainWarp(int seed, float amp, float freq, FNfloat x, FNfloat y, FNfloat &xr, FNfloat &yr) const {
-            switch (mDomainWarpType) {
-            case DomainWarpType_OpenSimplex2:
-                SingleDomainWarpSimplexGradient(seed, amp * 38.283687591552734375f, freq, x, y, xr, yr, false);
-                break;
-            case DomainWarpType_OpenSimplex2Reduced:
-                SingleDomainWarpSimplexGradient(seed, amp * 16.0f, freq, x, y, xr, yr, true);
-                break;
-            case DomainWarpType_BasicGrid:
-                SingleDomainWarpBasicGrid(seed, amp, freq, x, y, xr, yr);
-                break;
+            void Store(const float *noise, uint16_t *out, int count) const {
+                float s = scale, o = offset;
+                for (int i = 0; i < count; i++) {
+                    out[i] = FloatToHalf(noise[i] * s + o);
+                }
             }
+        };
+
+        static QuantizeUNorm MakeQuantizeUNorm(float max, float low, float high) {
+            QuantizeUNorm quantize;
+            quantize.scale = max / (high - low);
+            quantize.bias = 0.5f - low * quantize.scale; // + 0.5 so the truncating cast rounds to nearest
+            quantize.max = max;
+            return quantize;
         }
 
-        template <typename FNfloat>
-        void DoSingleDomainWarp(int seed, float amp, float freq, FNfloat x, FNfloat y, FNfloat z, FNfloat &xr,
-                                FNfloat &yr, FNfloat &zr) const {
-            switch (mDomainWarpType) {
-            case DomainWarpType_OpenSimplex2:
-                SingleDomainWarpOpenSimplex2Gradient(seed, amp * 32.69428253173828125f, freq, x, y, z, xr, yr, zr,
-                                                     false);
-                break;
-            case DomainWarpType_OpenSimplex2Reduced:
-                SingleDomainWarpOpenSimplex2Gradient(seed, amp * 7.71604938271605f, freq, x, y, z, xr, yr, zr, true);
-                break;
-            case DomainWarpType_BasicGrid:
-                SingleDomainWarpBasicGrid(seed, amp, freq, x, y, z, xr, yr, zr);
-                break;
+        // Round to nearest even, saturating to the largest finite half
+        static uint16_t FloatToHalf(float f) {
+            uint32_t bits;
+            std::memcpy(&bits, &f, sizeof(bits));
+            uint32_t sign = (bits >> 16) & 0x8000;
+            uint32_t magnitude = bits & 0x7fffffff;
+
+            if (magnitude >= 0x477ff000) // 65520 and above round past 65504
+                return (uint16_t)(sign | (magnitude > 0x7f800000 ? 0x7e00 : 0x7bff));
+
+            if (magnitude < 0x38800000) { // Below 2^-14, subnormal half in units of 2^-24
+                float a;
+                std::memcpy(&a, &magnitude, sizeof(a));
+                return (uint16_t)(sign | (uint32_t)lrintf(a * 16777216.0f));
             }
+
+            uint32_t half = (magnitude - 0x38000000) >> 13; // Rebias the exponent from 127 to 15
+            uint32_t rest = magnitude & 0x1fff;
+            half += rest > 0x1000 || (rest == 0x1000 && (half & 1));
+            return (uint16_t)(sign | half);
         }
 
-        // Domain Warp Single Wrapper
+        template <typename T, typename Quantize>
+        void GenQuantizedGrid2D(T *out, int xStart, int yStart, int xSize, int ySize, float step,
+                                const Quantize &quantize) const {
+            float xs[BatchSize];
+            float ys[BatchSize];
+            float noise[BatchSize];
+            bool rowAligned = IsRowAligned2D();
 
-        template <typename FNfloat> void DomainWarpSingle(FNfloat &x, FNfloat &y) const {
-            int seed = mSeed;
-            float amp = mDomainWarpAmp * mFractalBounding;
-            float freq = mFrequency;
+            for (int y = 0; y < ySize; y++) {
+                float yPos = (float)(yStart + y) * step;
 
-            FNfloat xs = x;
-            FNfloat ys = y;
-            TransformDomainWarpCoordinate(xs, ys);
+                for (int x0 = 0; x0 < xSize; x0 += BatchSize) {
+                    int count = xSize - x0 < BatchSize ? xSize - x0 : BatchSize;
 
-            DoSingleDomainWarp(seed, amp, freq, xs, ys, x, y);
+                    for (int i = 0; i < count; i++) {
+                        xs[i] = (float)(xStart + x0 + i) * step;
+                        ys[i] = yPos;
+                        TransformNoiseCoordinate(xs[i], ys[i]);
+                    }
+                    GenFractalSpan(xs, ys, noise, count, rowAligned);
+                    quantize.Store(noise, out + (size_t)y * xSize + x0, count);
+                }
+            }
         }
 
-        template <typename FNfloat> void DomainWarpSingle(FNfloat &x, FNfloat &y, FNfloat &z) const {
-            int seed = mSeed;
-            float amp = mDomainWarpAmp * mFractalBounding;
-            float freq = mFrequency;
+        template <typename T, typename Quantize>
+        void GenQuantizedGrid3D(T *out, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize,
+                                float step, const Quantize &quantize) const {
+            float xs[BatchSize];
+            float ys[BatchSize];
+            float zs[BatchSize];
+            float noise[BatchSize];
+            bool rowAligned = IsRowAligned3D();
+
+            for (int z = 0; z < zSize; z++) {
+                float zPos = (float)(zStart + z) * step;
+
+                for (int y = 0; y < ySize; y++) {
+                    float yPos = (float)(yStart + y) * step;
+                    T *row = out + ((size_t)z * ySize + y) * xSize;
+
+                    for (int x0 = 0; x0 < xSize; x0 += BatchSize) {
+                        int count = xSize - x0 < BatchSize ? xSize - x0 : BatchSize;
+
+                        for (int i = 0; i < count; i++) {
+                            xs[i] = (float)(xStart + x0 + i) * step;
+                            ys[i] = yPos;
+                            zs[i] = zPos;
+                            TransformNoiseCoordinate(xs[i], ys[i], zs[i]);
+                        }
+                        GenFractalSpan(xs, ys, zs, noise, count, rowAligned);
+                        quantize.Store(noise, row + x0, count);
+                    }
+                }
+            }
+        }
 
-            FNfloat xs = x;
-            FNfloat ys = y;
-            FNfloat zs = z;
-            TransformDomainWarpCoordinate(xs, ys, zs);
+        // Surface Normals
 
-            DoSingleDomainWarp(seed, amp, freq, xs, ys, zs, x, y, z);
+        bool HasAnalyticGradient2D() const {
+            if (mNoiseType != NoiseType_Value && (mNoiseType != NoiseType_Perlin || mApproximateMath))
+                return false;
+
+            switch (mFractalType) {
+            case FractalType_FBm:
+            case FractalType_Ridged:
+                return mWeightedStrength == 0;
+            case FractalType_PingPong:
+                return false;
+            default:
+                return true;
+            }
         }
 
-        // Domain Warp Fractal Progressive
+        // Same octave sums as GetNoise for the settings accepted by HasAnalyticGradient2D(), with derivatives
+        // carried through the chain rule. Derivatives are returned with respect to input coordinates.
+        void GenFractalGradientSpan(float *xs, float *ys, float *out, float *dx, float *dy, int count) const {
+            if (mFractalType != FractalType_FBm && mFractalType != FractalType_Ridged) {
+                GenNoiseGradientSpan(mSeed, xs, ys, out, dx, dy, count);
+                for (int i = 0; i < count; i++) {
+                    dx[i] *= mFrequency;
+                    dy[i] *= mFrequency;
+                }
+                return;
+            }
 
-        template <typename FNfloat> void DomainWarpFractalProgressive(FNfloat &x, FNfloat &y) const {
             int seed = mSeed;
-            float amp = mDomainWarpAmp * mFractalBounding;
-            float freq = mFrequency;
+            float amp = mFractalBounding;
+            float scale = mFrequency;
+            float noise[BatchSize];
+            float ndx[BatchSize];
+            float ndy[BatchSize];
+
+            for (int i = 0; i < count; i++) {
+                out[i] = 0;
+                dx[i] = 0;
+                dy[i] = 0;
+            }
 
-            for (int i = 0; i < mOctaves; i++) {
-                FNfloat xs = x;
-                FNfloat ys = y;
-                TransformDomainWarpCoordinate(xs, ys);
+            for (int o = 0; o < mNoiseOctaves; o++) {
+                GenNoiseGradientSpan(seed++, xs, ys, noise, ndx, ndy, count);
 
-                DoSingleDomainWarp(seed, amp, freq, xs, ys, x, y);
+                if (mFractalType == FractalType_FBm) {
+                    for (int i = 0; i < count; i++) {
+                        out[i] += noise[i] * amp;
+                        dx[i] += ndx[i] * (amp * scale);
+                        dy[i] += ndy[i] * (amp * scale);
+                    }
+                } else {
+                    for (int i = 0; i < count; i++) {
+                        float n = FastAbs(noise[i]);
+                        // The ridge itself is a crease, take the mean of both sides there like a central difference
+                        float sign = noise[i] < 0 ? 2.0f : noise[i] > 0 ? -2.0f : 0.0f;
+                        out[i] += (n * -2 + 1) * amp;
+                        dx[i] += ndx[i] * sign * (amp * scale);
+                        dy[i] += ndy[i] * sign * (amp * scale);
+                    }
+                }
 
-                seed++;
+                for (int i = 0; i < count; i++) {
+                    xs[i] *= mLacunarity;
+                    ys[i] *= mLacunarity;
+                }
                 amp *= mGain;
-                freq *= mLacunarity;
+                scale *= mLacunarity;
             }
         }
 
-        template <typename FNfloat> void DomainWarpFractalProgressive(FNfloat &x, FNfloat &y, FNfloat &z) const {
-            int seed = mSeed;
-            float amp = mDomainWarpAmp * mFractalBounding;
-            float freq = mFrequency;
+        void GenNoiseGradientSpan(int seed, const float *xs, const float *ys, float *out, float *dx, float *dy,
+                                  int count) const {
+            if (mNoiseType == NoiseType_Perlin) {
+                for (int i = 0; i < count; i++)
+                    out[i] = SinglePerlinGradient(seed, xs[i], ys[i], dx[i], dy[i]);
+            } else {
+                for (int i = 0; i < count; i++)
+                    out[i] = SingleValueGradient(seed, xs[i], ys[i], dx[i], dy[i]);
+            }
+        }
 
-            for (int i = 0; i < mOctaves; i++) {
-                FNfloat xs = x;
-                FNfloat ys = y;
-                FNfloat zs = z;
-                TransformDomainWarpCoordinate(xs, ys, zs);
+        static void StoreSurface(const float *h, const float *dx, const float *dy, size_t index, int count,
+                                 float *height, uint32_t *normals, float *slope, float heightScale,
+                                 NormalPacking packing) {
+            for (int i = 0; i < count; i++) {
+                float nx = -dx[i] * heightScale;
+                float ny = -dy[i] * heightScale;
+                float tangent2 = nx * nx + ny * ny;
+
+                if (height)
+                    height[index + i] = h[i];
+                if (slope)
+                    slope[index + i] = FastSqrt(tangent2);
+                if (!normals)
+                    continue;
+
+                float nz = 1 / FastSqrt(tangent2 + 1);
+                nx *= nz;
+                ny *= nz;
+
+                if (packing == NormalPacking_Octahedral16) {
+                    // Height field normals point up, so the octahedral fold for the lower hemisphere is never needed
+                    float l1 = 1 / (FastAbs(nx) + FastAbs(ny) + nz);
+                    uint32_t u = (uint32_t)FastMin(nx * l1 * 32767.5f + 32768.0f, 65535);
+                    uint32_t v = (uint32_t)FastMin(ny * l1 * 32767.5f + 32768.0f, 65535);
+                    normals[index + i] = u | v << 16;
+                } else {
+                    uint32_t r = (uint32_t)FastMin(nx * 127.5f + 128.0f, 255);
+                    uint32_t g = (uint32_t)FastMin(ny * 127.5f + 128.0f, 255);
+                    uint32_t b = (uint32_t)FastMin(nz * 127.5f + 128.0f, 255);
+                    normals[index + i] = r | g << 8 | b << 16 | 0xff000000u;
+                }
+            }
+        }
 
-                DoSingleDomainWarp(seed, amp, freq, xs, ys, zs, x, y, z);
+        // Padded Chunks
+        // Border boxes of a chunk are stored back to back in box index order, skipping the interior box 13. Box extents
+        // along each axis are padding, size - 2 * padding and padding voxels.
 
-                seed++;
-                amp *= mGain;
-                freq *= mLacunarity;
+        static size_t ChunkBorderOffset(int box, int size, int padding) {
+            int extent[3] = {padding, size - 2 * padding, padding};
+            size_t offset = 0;
+
+            for (int index = 0; index < box; index++) {
+                if (index != 13) {
+                    offset += (size_t)extent[index / 9] * extent[index / 3 % 3] * extent[index % 3];
+                }
             }
+            return offset;
         }
 
-        // Domain Warp Fractal Independant
+        // Copies a box between the padded volume and its border storage, toBorder after computing it here
+        static void CopyChunkBorder(float *volume, int paddedSize, float *box, int xSize, int ySize, int zSize,
+                                    bool toBorder) {
+            for (int z = 0; z < zSize; z++) {
+                for (int y = 0; y < ySize; y++) {
+                    float *row = volume + ((size_t)z * paddedSize + y) * paddedSize;
+                    float *boxRow = box + ((size_t)z * ySize + y) * xSize;
+
+                    if (toBorder) {
+                        std::memcpy(boxRow, row, sizeof(float) * xSize);
+                    } else {
+                        std::memcpy(row, boxRow, sizeof(float) * xSize);
+                    }
+                }
+            }
+        }
 
-        template <typename FNfloat> void DomainWarpFractalIndependent(FNfloat &x, FNfloat &y) const {
-            FNfloat xs = x;
-            FNfloat ys = y;
-            TransformDomainWarpCoordinate(xs, ys);
+        // Noise Slice Planes
+        // Without rotation the z lattice planes either side of a slice are the same for every pixel. Each octave keeps
+        // two plane slots holding the noise of one z plane reduced over x and y (Value), or its xy and z gradient
+        // parts (Perlin). A frame then only interpolates between the planes around its z.
 
-            int seed = mSeed;
-            float amp = mDomainWarpAmp * mFractalBounding;
-            float freq = mFrequency;
+        int SlicePlaneValues() const { return mNoiseType == NoiseType_Perlin ? 2 : 1; }
 
-            for (int i = 0; i < mOctaves; i++) {
-                DoSingleDomainWarp(seed, amp, freq, xs, ys, x, y);
+        const float *SlicePlane(const NoiseSlice &slice, int octave, int cell) const {
+            int slot = slice.planeCells[(size_t)octave * 2] == cell ? 0 : 1;
+            size_t pixels = (size_t)slice.xSize * slice.ySize;
+            return slice.planes.data() + ((size_t)octave * 2 + slot) * pixels * SlicePlaneValues();
+        }
 
-                seed++;
-                amp *= mGain;
-                freq *= mLacunarity;
+        void UpdateSlicePlanes(NoiseSlice &slice, int octave, int cell) const {
+            int *cells = slice.planeCells.data() + (size_t)octave * 2;
+
+            for (int k = cell; k <= cell + 1; k++) {
+                if (cells[0] == k || cells[1] == k)
+                    continue;
+
+                int slot = cells[0] == cell || cells[0] == cell + 1 ? 1 : 0;
+                BuildSlicePlane(slice, octave, slot, k);
+                cells[slot] = k;
             }
         }
 
-        template <typename FNfloat> void DomainWarpFractalIndependent(FNfloat &x, FNfloat &y, FNfloat &z) const {
-            FNfloat xs = x;
-            FNfloat ys = y;
-            FNfloat zs = z;
-            TransformDomainWarpCoordinate(xs, ys, zs);
+        void BuildSlicePlane(NoiseSlice &slice, int octave, int slot, int cell) const {
+            size_t pixels = (size_t)slice.xSize * slice.ySize;
+            float *plane = slice.planes.data() + ((size_t)octave * 2 + slot) * pixels * SlicePlaneValues();
+            int seed = mSeed + octave;
+            int zPrimed = cell * PrimeZ;
+
+            for (int y = 0; y < slice.ySize; y++) {
+                float yPos = (float)(slice.yStart + y) * slice.step;
+                yPos *= mFrequency;
+                for (int o = 0; o < octave; o++)
+                    yPos *= mLacunarity;
+
+                int y0 = FastFloor(yPos);
+                float yd0 = yPos - y0;
+                y0 *= PrimeY;
+                int y1 = y0 + PrimeY;
+
+                for (int x = 0; x < slice.xSize; x++) {
+                    float xPos = (float)(slice.xStart + x) * slice.step;
+                    xPos *= mFrequency;
+                    for (int o = 0; o < octave; o++)
+                        xPos *= mLacunarity;
+
+                    int x0 = FastFloor(xPos);
+                    float xd0 = xPos - x0;
+                    x0 *= PrimeX;
+                    int x1 = x0 + PrimeX;
+                    size_t i = (size_t)y * slice.xSize + x;
+
+                    if (mNoiseType == NoiseType_Value) {
+                        float xs = InterpHermite(xd0);
+                        float ys = InterpHermite(yd0);
+                        float xf0 = Lerp(ValCoord(seed, x0, y0, zPrimed), ValCoord(seed, x1, y0, zPrimed), xs);
+                        float xf1 = Lerp(ValCoord(seed, x0, y1, zPrimed), ValCoord(seed, x1, y1, zPrimed), xs);
+                        plane[i] = Lerp(xf0, xf1, ys);
+                        continue;
+                    }
 
-            int seed = mSeed;
-            float amp = mDomainWarpAmp * mFractalBounding;
-            float freq = mFrequency;
+                    float xd1 = xd0 - 1;
+                    float yd1 = yd0 - 1;
+                    float xs = InterpQuintic(xd0);
+                    float ys = InterpQuintic(yd0);
+                    float a00, a10, a01, a11, b00, b10, b01, b11;
+                    GradCoordPlane(seed, x0, y0, zPrimed, xd0, yd0, a00, b00);
+                    GradCoordPlane(seed, x1, y0, zPrimed, xd1, yd0, a10, b10);
+                    GradCoordPlane(seed, x0, y1, zPrimed, xd0, yd1, a01, b01);
+                    GradCoordPlane(seed, x1, y1, zPrimed, xd1, yd1, a11, b11);
+
+                    plane[i] = Lerp(Lerp(a00, a10, xs), Lerp(a01, a11, xs), ys);
+                    plane[pixels + i] = Lerp(Lerp(b00, b10, xs), Lerp(b01, b11, xs), ys);
+                }
+            }
+        }
 
-            for (int i = 0; i < mOctaves; i++) {
-                DoSingleDomainWarp(seed, amp, freq, xs, ys, zs, x, y, z);
+        // Splits the 3D gradient dot product into the part that is fixed on a z plane and the z gradient component
+        void GradCoordPlane(int seed, int xPrimed, int yPrimed, int zPrimed, float xd, float yd, float &xy,
+                            float &zg) const {
+            int hash = Hash(seed, xPrimed, yPrimed, zPrimed);
+            hash ^= hash >> 15;
+            hash &= 63 << 2;
 
-                seed++;
-                amp *= mGain;
-                freq *= mLacunarity;
+            xy = xd * Lookup<float>::Gradients3D[hash] + yd * Lookup<float>::Gradients3D[hash | 1];
+            zg = Lookup<float>::Gradients3D[hash | 2];
+        }
+
+        void SlicePlanesFrame(NoiseSlice &slice, float z, float *out) const {
+            z *= mFrequency;
+
+            float zo = z;
+            for (int o = 0; o < slice.octaves; o++) {
+                UpdateSlicePlanes(slice, o, FastFloor(zo));
+                zo *= mLacunarity;
+            }
+
+            size_t pixels = (size_t)slice.xSize * slice.ySize;
+            float amp[BatchSize];
+            float noise[BatchSize];
+
+            for (size_t i0 = 0; i0 < pixels; i0 += BatchSize) {
+                int count = pixels - i0 < (size_t)BatchSize ? (int)(pixels - i0) : BatchSize;
+
+                if (!IsFractalNoise()) {
+                    SlicePlanesOctave(slice, 0, z, i0, out + i0, count);
+                    continue;
+                }
+
+                for (int i = 0; i < count; i++) {
+                    out[i0 + i] = 0;
+                    amp[i] = mFractalBounding;
+                }
+
+                zo = z;
+                for (int o = 0; o < slice.octaves; o++) {
+                    SlicePlanesOctave(slice, o, zo, i0, noise, count);
+
+                    switch (mFractalType) {
+                    default:
+                    case FractalType_FBm:
+                        for (int i = 0; i < count; i++) {
+                            out[i0 + i] += noise[i] * amp[i];
+                            amp[i] *= Lerp(1.0f, (noise[i] + 1) * 0.5f, mWeightedStrength);
+                        }
+                        break;
+                    case FractalType_Ridged:
+                        for (int i = 0; i < count; i++) {
+                            float n = FastAbs(noise[i]);
+                            out[i0 + i] += (n * -2 + 1) * amp[i];
+                            amp[i] *= Lerp(1.0f, 1 - n, mWeightedStrength);
+                        }
+                        break;
+                    case FractalType_PingPong:
+                        for (int i = 0; i < count; i++) {
+                            float n = PingPong((noise[i] + 1) * mPingPongStrength);
+                            out[i0 + i] += (n - 0.5f) * 2 * amp[i];
+                            amp[i] *= Lerp(1.0f, n, mWeightedStrength);
+                        }
+                        break;
+                    }
+
+                    for (int i = 0; i < count; i++) {
+                        amp[i] *= mGain;
+                    }
+                    zo *= mLacunarity;
+                }
+            }
+        }
+
+        void SlicePlanesOctave(const NoiseSlice &slice, int octave, float z, size_t i0, float *out, int count) const {
+            int z0 = FastFloor(z);
+            float zd0 = z - z0;
+            const float *lower = SlicePlane(slice, octave, z0) + i0;
+            const float *upper = SlicePlane(slice, octave, z0 + 1) + i0;
+
+            if (mNoiseType == NoiseType_Value) {
+                float zs = InterpHermite(zd0);
+                for (int i = 0; i < count; i++) {
+                    out[i] = Lerp(lower[i], upper[i], zs);
+                }
+                return;
+            }
+
+            size_t pixels = (size_t)slice.xSize * slice.ySize;
+            float zd1 = zd0 - 1;
+            float zs = InterpQuintic(zd0);
+            for (int i = 0; i < count; i++) {
+                float zf0 = lower[i] + zd0 * lower[pixels + i];
+                float zf1 = upper[i] + zd1 * upper[pixels + i];
+                out[i] = Lerp(zf0, zf1, zs) * 0.964921414852142333984375f;
             }
         }
 
@@ -1951,9 +7367,29 @@ namespace entropy {
 
         // Domain Warp Simplex/OpenSimplex2
 
-        template <typename FNfloat>
+        // Contributions outside their kernel radius are weighted by zero instead of skipped, and lattice choices use
+        // selects, so the warp kernels have no data dependent branches and loops over them can be vectorized
+
+        template <bool OutGradOnly>
+        void WarpGradCoord(int seed, int xPrimed, int yPrimed, float xd, float yd, float &xo, float &yo) const {
+            if (OutGradOnly)
+                GradCoordOut(seed, xPrimed, yPrimed, xo, yo);
+            else
+                GradCoordDual(seed, xPrimed, yPrimed, xd, yd, xo, yo);
+        }
+
+        template <bool OutGradOnly>
+        void WarpGradCoord(int seed, int xPrimed, int yPrimed, int zPrimed, float xd, float yd, float zd, float &xo,
+                           float &yo, float &zo) const {
+            if (OutGradOnly)
+                GradCoordOut(seed, xPrimed, yPrimed, zPrimed, xo, yo, zo);
+            else
+                GradCoordDual(seed, xPrimed, yPrimed, zPrimed, xd, yd, zd, xo, yo, zo);
+        }
+
+        template <bool OutGradOnly, typename FNfloat>
         void SingleDomainWarpSimplexGradient(int seed, float warpAmp, float frequency, FNfloat x, FNfloat y,
-                                             FNfloat &xr, FNfloat &yr, bool outGradOnly) const {
+                                             FNfloat &xr, FNfloat &yr) const {
             const float SQRT3 = 1.7320508075688772935274463415059f;
             const float G2 = (3 - SQRT3) / 6;
 
@@ -1981,71 +7417,38 @@ namespace entropy {
 
             float vx, vy;
             vx = vy = 0;
+            float xo, yo;
 
             float a = 0.5f - x0 * x0 - y0 * y0;
-            if (a > 0) {
-                float aaaa = (a * a) * (a * a);
-                float xo, yo;
-                if (outGradOnly)
-                    GradCoordOut(seed, i, j, xo, yo);
-                else
-                    GradCoordDual(seed, i, j, x0, y0, xo, yo);
-                vx += aaaa * xo;
-                vy += aaaa * yo;
-            }
+            float aaaa = a > 0 ? (a * a) * (a * a) : 0;
+            WarpGradCoord<OutGradOnly>(seed, i, j, x0, y0, xo, yo);
+            vx += aaaa * xo;
+            vy += aaaa * yo;
 
             float c = (float)(2 * (1 - 2 * G2) * (1 / G2 - 2)) * t + ((float)(-2 * (1 - 2 * G2) * (1 - 2 * G2)) + a);
-            if (c > 0) {
-                float x2 = x0 + (2 * (float)G2 - 1);
-                float y2 = y0 + (2 * (float)G2 - 1);
-                float cccc = (c * c) * (c * c);
-                float xo, yo;
-                if (outGradOnly)
-                    GradCoordOut(seed, i + PrimeX, j + PrimeY, xo, yo);
-                else
-                    GradCoordDual(seed, i + PrimeX, j + PrimeY, x2, y2, xo, yo);
-                vx += cccc * xo;
-                vy += cccc * yo;
-            }
-
-            if (y0 > x0) {
-                float x1 = x0 + (float)G2;
-                float y1 = y0 + ((float)G2 - 1);
-                float b = 0.5f - x1 * x1 - y1 * y1;
-                if (b > 0) {
-                    float bbbb = (b * b) * (b * b);
-                    float xo, yo;
-                    if (outGradOnly)
-                        GradCoordOut(seed, i, j + PrimeY, xo, yo);
-                    else
-                        GradCoordDual(seed, i, j + PrimeY, x1, y1, xo, yo);
-                    vx += bbbb * xo;
-                    vy += bbbb * yo;
-                }
-            } else {
-                float x1 = x0 + ((float)G2 - 1);
-                float y1 = y0 + (float)G2;
-                float b = 0.5f - x1 * x1 - y1 * y1;
-                if (b > 0) {
-                    float bbbb = (b * b) * (b * b);
-                    float xo, yo;
-                    if (outGradOnly)
-                        GradCoordOut(seed, i + PrimeX, j, xo, yo);
-                    else
-                        GradCoordDual(seed, i + PrimeX, j, x1, y1, xo, yo);
-                    vx += bbbb * xo;
-                    vy += bbbb * yo;
-                }
-            }
+            float x2 = x0 + (2 * (float)G2 - 1);
+            float y2 = y0 + (2 * (float)G2 - 1);
+            float cccc = c > 0 ? (c * c) * (c * c) : 0;
+            WarpGradCoord<OutGradOnly>(seed, i + PrimeX, j + PrimeY, x2, y2, xo, yo);
+            vx += cccc * xo;
+            vy += cccc * yo;
+
+            bool upper = y0 > x0;
+            float x1 = x0 + (upper ? (float)G2 : ((float)G2 - 1));
+            float y1 = y0 + (upper ? ((float)G2 - 1) : (float)G2);
+            float b = 0.5f - x1 * x1 - y1 * y1;
+            float bbbb = b > 0 ? (b * b) * (b * b) : 0;
+            WarpGradCoord<OutGradOnly>(seed, upper ? i : i + PrimeX, upper ? j + PrimeY : j, x1, y1, xo, yo);
+            vx += bbbb * xo;
+            vy += bbbb * yo;
 
             xr += vx * warpAmp;
             yr += vy * warpAmp;
         }
 
-        template <typename FNfloat>
+        template <bool OutGradOnly, typename FNfloat>
         void SingleDomainWarpOpenSimplex2Gradient(int seed, float warpAmp, float frequency, FNfloat x, FNfloat y,
-                                                  FNfloat z, FNfloat &xr, FNfloat &yr, FNfloat &zr,
-                                                  bool outGradOnly) const {
+                                                  FNfloat z, FNfloat &xr, FNfloat &yr, FNfloat &zr) const {
             x *= frequency;
             y *= frequency;
             z *= frequency;
@@ -2078,54 +7481,34 @@ namespace entropy {
 
             float vx, vy, vz;
             vx = vy = vz = 0;
+            float xo, yo, zo;
 
             float a = (0.6f - x0 * x0) - (y0 * y0 + z0 * z0);
             for (int l = 0; l < 2; l++) {
-                if (a > 0) {
-                    float aaaa = (a * a) * (a * a);
-                    float xo, yo, zo;
-                    if (outGradOnly)
-                        GradCoordOut(seed, i, j, k, xo, yo, zo);
-                    else
-                        GradCoordDual(seed, i, j, k, x0, y0, z0, xo, yo, zo);
-                    vx += aaaa * xo;
-                    vy += aaaa * yo;
-                    vz += aaaa * zo;
-                }
+                float aaaa = a > 0 ? (a * a) * (a * a) : 0;
+                WarpGradCoord<OutGradOnly>(seed, i, j, k, x0, y0, z0, xo, yo, zo);
+                vx += aaaa * xo;
+                vy += aaaa * yo;
+                vz += aaaa * zo;
+
+                bool stepX = ax0 >= ay0 && ax0 >= az0;
+                bool stepY = !stepX && ay0 > ax0 && ay0 >= az0;
+                bool stepZ = !stepX && !stepY;
 
+                float x1 = stepX ? x0 + xNSign : x0;
+                float y1 = stepY ? y0 + yNSign : y0;
+                float z1 = stepZ ? z0 + zNSign : z0;
                 float b = a + 1;
-                int i1 = i;
-                int j1 = j;
-                int k1 = k;
-                float x1 = x0;
-                float y1 = y0;
-                float z1 = z0;
-
-                if (ax0 >= ay0 && ax0 >= az0) {
-                    x1 += xNSign;
-                    b -= xNSign * 2 * x1;
-                    i1 -= xNSign * PrimeX;
-                } else if (ay0 > ax0 && ay0 >= az0) {
-                    y1 += yNSign;
-                    b -= yNSign * 2 * y1;
-                    j1 -= yNSign * PrimeY;
-                } else {
-                    z1 += zNSign;
-                    b -= zNSign * 2 * z1;
-                    k1 -= zNSign * PrimeZ;
-                }
+                b -= stepX ? xNSign * 2 * x1 : (stepY ? yNSign * 2 * y1 : zNSign * 2 * z1);
+                int i1 = stepX ? i - xNSign * PrimeX : i;
+                int j1 = stepY ? j - yNSign * PrimeY : j;
+                int k1 = stepZ ? k - zNSign * PrimeZ : k;
 
-                if (b > 0) {
-                    float bbbb = (b * b) * (b * b);
-                    float xo, yo, zo;
-                    if (outGradOnly)
-                        GradCoordOut(seed, i1, j1, k1, xo, yo, zo);
-                    else
-                        GradCoordDual(seed, i1, j1, k1, x1, y1, z1, xo, yo, zo);
-                    vx += bbbb * xo;
-                    vy += bbbb * yo;
-                    vz += bbbb * zo;
-                }
+                float bbbb = b > 0 ? (b * b) * (b * b) : 0;
+                WarpGradCoord<OutGradOnly>(seed, i1, j1, k1, x1, y1, z1, xo, yo, zo);
+                vx += bbbb * xo;
+                vy += bbbb * yo;
+                vz += bbbb * zo;
 
                 if (l == 1)
                     break;
@@ -2318,6 +7701,15 @@ namespace entropy {
         0, 1, 1, 0, 0,  -1, 1, 0, 0, 1,  -1, 0, 0,  -1, -1, 0, 1, 0, 1, 0, -1, 0,  1, 0, 1,  0,  -1, 0, -1, 0,  -1, 0,
         1, 1, 0, 0, -1, 1,  0, 0, 1, -1, 0,  0, -1, -1, 0,  0, 1, 1, 0, 0, 0,  -1, 1, 0, -1, 1,  0,  0, 0,  -1, -1, 0};
 
+    template <typename T>
+    const T NoiseGen::Lookup<T>::Gradients4D[] = {
+        0,  1,  1,  1,  0,  1,  1,  -1, 0,  1,  -1, 1,  0,  1,  -1, -1, 0,  -1, 1,  1,  0,  -1, 1,  -1,
+        0,  -1, -1, 1,  0,  -1, -1, -1, 1,  0,  1,  1,  1,  0,  1,  -1, 1,  0,  -1, 1,  1,  0,  -1, -1,
+        -1, 0,  1,  1,  -1, 0,  1,  -1, -1, 0,  -1, 1,  -1, 0,  -1, -1, 1,  1,  0,  1,  1,  1,  0,  -1,
+        1,  -1, 0,  1,  1,  -1, 0,  -1, -1, 1,  0,  1,  -1, 1,  0,  -1, -1, -1, 0,  1,  -1, -1, 0,  -1,
+        1,  1,  1,  0,  1,  1,  -1, 0,  1,  -1, 1,  0,  1,  -1, -1, 0,  -1, 1,  1,  0,  -1, 1,  -1, 0,
+        -1, -1, 1,  0,  -1, -1, -1, 0};
+
     template <typename T>
     const T NoiseGen::Lookup<T>::RandVecs3D[] = {
         -0.7292736885f,  -0.6618439697f,    0.1735581948f,    0, 0.790292081f,    -0.5480887466f,  -0.2739291014f,  0,
@@ -0,0 +1,91 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "generator.hpp"
+
+namespace entropy {
+
+    /// <summary>
+    /// NoiseGen settings that can be changed while other threads sample, without readers taking a lock
+    /// </summary>
+    /// <remarks>
+    /// Settings are published as immutable NoiseGen snapshots through an atomic pointer (read-copy-update). Readers
+    /// call Get() once per task, one atomic load, and sample through the returned snapshot, which never changes under
+    /// them, so derived state such as the fractal bounding and the 3D transform always matches the other settings.
+    /// Writers copy the current snapshot, edit the copy and swap it in. Writers are serialized with a mutex, readers
+    /// never wait on it.
+    ///
+    /// A replaced snapshot may still be in use by a reader, so it is retired rather than freed. Call Reclaim() at a
+    /// point where no reader still holds a snapshot taken before the call, e.g. between frames once the workers of
+    /// the previous frame have finished. Retired snapshots are also freed on destruction.
+    /// </remarks>
+    class SharedNoiseGen {
+      public:
+        explicit SharedNoiseGen(const NoiseGen &gen = NoiseGen()) : mCurrent(new NoiseGen(gen)) {}
+
+        ~SharedNoiseGen() { delete mCurrent.load(std::memory_order_relaxed); }
+
+        SharedNoiseGen(const SharedNoiseGen &) = delete;
+        SharedNoiseGen &operator=(const SharedNoiseGen &) = delete;
+
+        /// <summary>
+        /// Current settings snapshot, valid until the next Reclaim() after it has been replaced
+        /// </summary>
+        const NoiseGen &Get() const { return *mCurrent.load(std::memory_order_acquire); }
+
+        /// <summary>
+        /// Publishes a copy of gen as the new snapshot
+        /// </summary>
+        void Publish(const NoiseGen &gen) {
+            std::lock_guard<std::mutex> lock(mWriteMutex);
+            Swap(new NoiseGen(gen));
+        }
+
+        /// <summary>
+        /// Applies edit(NoiseGen &) to a copy of the current settings and publishes the result
+        /// </summary>
+        /// <example>
+        /// <code>shared.Update([](NoiseGen &gen) { gen.SetFractalOctaves(6); gen.SetFractalGain(0.4f); });</code>
+        /// </example>
+        /// <remarks>
+        /// All changes made by one edit become visible to readers together
+        /// </remarks>
+        template <typename Edit> void Update(Edit &&edit) {
+            std::lock_guard<std::mutex> lock(mWriteMutex);
+            std::unique_ptr<NoiseGen> next(new NoiseGen(*mCurrent.load(std::memory_order_relaxed)));
+            std::forward<Edit>(edit)(*next);
+            Swap(next.release());
+        }
+
+        /// <summary>
+        /// Frees replaced snapshots, only call when no reader holds a snapshot taken before this call
+        /// </summary>
+        void Reclaim() {
+            std::lock_guard<std::mutex> lock(mWriteMutex);
+            mRetired.clear();
+        }
+
+        /// <summary>
+        /// Number of replaced snapshots waiting for Reclaim()
+        /// </summary>
+        size_t RetiredCount() const {
+            std::lock_guard<std::mutex> lock(mWriteMutex);
+            return mRetired.size();
+        }
+
+      private:
+        void Swap(NoiseGen *next) {
+            NoiseGen *previous = mCurrent.exchange(next, std::memory_order_acq_rel);
+            mRetired.emplace_back(previous);
+        }
+
+        std::atomic<NoiseGen *> mCurrent;
+        mutable std::mutex mWriteMutex;
+        std::vector<std::unique_ptr<NoiseGen>> mRetired;
+    };
+
+} // namespace entropy
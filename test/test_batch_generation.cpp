@@ -0,0 +1,765 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <doctest/doctest.h>
+#include <entropy/entropy.hpp>
+#include <vector>
+
+using entropy::NoiseGen;
+
+static void CheckGrid2D(const NoiseGen &gen, int xStart, int yStart, int xSize, int ySize, float step) {
+    std::vector<float> grid((size_t)xSize * ySize);
+    gen.GetNoiseGrid2D(grid.data(), xStart, yStart, xSize, ySize, step);
+
+    for (int y = 0; y < ySize; y++) {
+        for (int x = 0; x < xSize; x++) {
+            float expected = gen.GetNoise((float)(xStart + x) * step, (float)(yStart + y) * step);
+            CHECK(std::abs(grid[(size_t)y * xSize + x] - expected) < 1e-5f);
+        }
+    }
+}
+
+static void CheckGrid3D(const NoiseGen &gen, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize,
+                        float step) {
+    std::vector<float> grid((size_t)xSize * ySize * zSize);
+    gen.GetNoiseGrid3D(grid.data(), xStart, yStart, zStart, xSize, ySize, zSize, step);
+
+    for (int z = 0; z < zSize; z++) {
+        for (int y = 0; y < ySize; y++) {
+            for (int x = 0; x < xSize; x++) {
+                float expected = gen.GetNoise((float)(xStart + x) * step, (float)(yStart + y) * step,
+                                              (float)(zStart + z) * step);
+                CHECK(std::abs(grid[((size_t)z * ySize + y) * xSize + x] - expected) < 1e-5f);
+            }
+        }
+    }
+}
+
+TEST_CASE("Grid generation matches GetNoise") {
+    const NoiseGen::NoiseType types[] = {NoiseGen::NoiseType_OpenSimplex2, NoiseGen::NoiseType_OpenSimplex2S,
+                                         NoiseGen::NoiseType_Perlin,       NoiseGen::NoiseType_Value,
+                                         NoiseGen::NoiseType_ValueCubic,   NoiseGen::NoiseType_Cellular};
+
+    SUBCASE("Noise types") {
+        for (auto type : types) {
+            NoiseGen gen(42);
+            gen.SetNoiseType(type);
+            gen.SetFrequency(0.07f);
+            CheckGrid2D(gen, -20, 5, 300, 3, 0.5f);
+            CheckGrid3D(gen, 3, -4, 7, 20, 4, 3, 1.0f);
+        }
+    }
+
+    SUBCASE("Fractal types") {
+        const NoiseGen::FractalType fractals[] = {NoiseGen::FractalType_FBm, NoiseGen::FractalType_Ridged,
+                                                  NoiseGen::FractalType_PingPong};
+        for (auto type : types) {
+            for (auto fractal : fractals) {
+                NoiseGen gen(7);
+                gen.SetNoiseType(type);
+                gen.SetFrequency(0.03f);
+                gen.SetFractalType(fractal);
+                gen.SetFractalOctaves(4);
+                gen.SetFractalWeightedStrength(0.5f);
+                CheckGrid2D(gen, 0, 0, 40, 4, 1.0f);
+                CheckGrid3D(gen, 0, 0, 0, 12, 3, 3, 1.0f);
+            }
+        }
+    }
+
+    SUBCASE("3D rotation") {
+        NoiseGen gen(99);
+        gen.SetNoiseType(NoiseGen::NoiseType_Cellular);
+        gen.SetRotationType3D(NoiseGen::RotationType3D_ImproveXZPlanes);
+        gen.SetFrequency(0.1f);
+        CheckGrid3D(gen, -5, 2, 0, 30, 3, 2, 1.0f);
+    }
+}
+
+TEST_CASE("Cellular grid reuses feature points along rows") {
+    const NoiseGen::CellularDistanceFunction functions[] = {
+        NoiseGen::CellularDistanceFunction_Euclidean, NoiseGen::CellularDistanceFunction_EuclideanSq,
+        NoiseGen::CellularDistanceFunction_Manhattan, NoiseGen::CellularDistanceFunction_Hybrid};
+    const NoiseGen::CellularReturnType returnTypes[] = {
+        NoiseGen::CellularReturnType_CellValue,    NoiseGen::CellularReturnType_Distance,
+        NoiseGen::CellularReturnType_Distance2,    NoiseGen::CellularReturnType_Distance2Add,
+        NoiseGen::CellularReturnType_Distance2Sub, NoiseGen::CellularReturnType_Distance2Mul,
+        NoiseGen::CellularReturnType_Distance2Div};
+
+    SUBCASE("Distance functions and return types") {
+        for (auto function : functions) {
+            for (auto returnType : returnTypes) {
+                NoiseGen gen(1234);
+                gen.SetNoiseType(NoiseGen::NoiseType_Cellular);
+                gen.SetFrequency(0.11f);
+                gen.SetCellularDistanceFunction(function);
+                gen.SetCellularReturnType(returnType);
+                CheckGrid2D(gen, -37, -2, 80, 3, 1.0f);
+                CheckGrid3D(gen, -11, 4, -3, 40, 2, 2, 1.0f);
+            }
+        }
+    }
+
+    SUBCASE("Window refill on large steps and negative frequency") {
+        NoiseGen gen(5);
+        gen.SetNoiseType(NoiseGen::NoiseType_Cellular);
+        gen.SetCellularJitter(1.3f);
+        gen.SetFrequency(1.7f);
+        CheckGrid2D(gen, -10, 0, 25, 2, 1.0f);
+        CheckGrid3D(gen, -10, 0, 0, 25, 2, 1, 1.0f);
+
+        gen.SetFrequency(-0.2f);
+        CheckGrid2D(gen, -10, 0, 60, 2, 1.0f);
+        CheckGrid3D(gen, -10, 0, 0, 60, 2, 1, 1.0f);
+    }
+
+    SUBCASE("Adjacent tiles line up") {
+        NoiseGen gen(77);
+        gen.SetNoiseType(NoiseGen::NoiseType_Cellular);
+        gen.SetFrequency(0.05f);
+
+        std::vector<float> whole(64 * 2), left(32 * 2), right(32 * 2);
+        gen.GetNoiseGrid2D(whole.data(), 0, 0, 64, 2);
+        gen.GetNoiseGrid2D(left.data(), 0, 0, 32, 2);
+        gen.GetNoiseGrid2D(right.data(), 32, 0, 32, 2);
+
+        for (int y = 0; y < 2; y++) {
+            for (int x = 0; x < 32; x++) {
+                CHECK(whole[y * 64 + x] == left[y * 32 + x]);
+                CHECK(whole[y * 64 + 32 + x] == right[y * 32 + x]);
+            }
+        }
+    }
+}
+
+TEST_CASE("Value and Perlin grids reuse lattice values along rows") {
+    const NoiseGen::NoiseType types[] = {NoiseGen::NoiseType_Perlin, NoiseGen::NoiseType_Value,
+                                         NoiseGen::NoiseType_ValueCubic};
+
+    // Row kernels do the same per sample arithmetic as GetNoise, so values match exactly
+    auto checkExact = [](const NoiseGen &gen, int xStart, int yStart, int zStart, int xSize, float step) {
+        std::vector<float> grid2((size_t)xSize * 2), grid3((size_t)xSize * 2 * 2);
+        gen.GetNoiseGrid2D(grid2.data(), xStart, yStart, xSize, 2, step);
+        gen.GetNoiseGrid3D(grid3.data(), xStart, yStart, zStart, xSize, 2, 2, step);
+
+        for (int z = 0; z < 2; z++) {
+            for (int y = 0; y < 2; y++) {
+                for (int x = 0; x < xSize; x++) {
+                    float px = (float)(xStart + x) * step, py = (float)(yStart + y) * step;
+                    float pz = (float)(zStart + z) * step;
+                    if (z == 0) {
+                        CHECK(grid2[(size_t)y * xSize + x] == gen.GetNoise(px, py));
+                    }
+                    CHECK(grid3[((size_t)z * 2 + y) * xSize + x] == gen.GetNoise(px, py, pz));
+                }
+            }
+        }
+    };
+
+    SUBCASE("Low frequency") {
+        for (auto type : types) {
+            NoiseGen gen(31);
+            gen.SetNoiseType(type);
+            gen.SetFrequency(0.004f);
+            checkExact(gen, -700, -3, 9, 600, 1.0f);
+        }
+    }
+
+    SUBCASE("Column refill on large steps and negative frequency") {
+        for (auto type : types) {
+            NoiseGen gen(8);
+            gen.SetNoiseType(type);
+            gen.SetFrequency(2.3f);
+            checkExact(gen, -15, 1, -2, 40, 1.0f);
+
+            gen.SetFrequency(-0.3f);
+            checkExact(gen, -15, 1, -2, 80, 1.0f);
+        }
+    }
+
+    SUBCASE("Fractal octaves") {
+        for (auto type : types) {
+            NoiseGen gen(3);
+            gen.SetNoiseType(type);
+            gen.SetFrequency(0.02f);
+            gen.SetFractalType(NoiseGen::FractalType_FBm);
+            gen.SetFractalOctaves(5);
+            checkExact(gen, 0, 0, 0, 300, 0.75f);
+        }
+    }
+}
+
+TEST_CASE("Domain warp arrays match DomainWarp") {
+    const NoiseGen::DomainWarpType warpTypes[] = {NoiseGen::DomainWarpType_OpenSimplex2,
+                                                  NoiseGen::DomainWarpType_OpenSimplex2Reduced,
+                                                  NoiseGen::DomainWarpType_BasicGrid};
+    const NoiseGen::FractalType fractals[] = {NoiseGen::FractalType_None, NoiseGen::FractalType_DomainWarpProgressive,
+                                              NoiseGen::FractalType_DomainWarpIndependent};
+    const NoiseGen::RotationType3D rotations[] = {NoiseGen::RotationType3D_None,
+                                                  NoiseGen::RotationType3D_ImproveXYPlanes,
+                                                  NoiseGen::RotationType3D_ImproveXZPlanes};
+
+    const size_t count = 600;
+    std::vector<float> xs(count), ys(count), zs(count);
+    for (size_t i = 0; i < count; i++) {
+        xs[i] = (float)i * 0.73f - 150.0f;
+        ys[i] = (float)(i % 37) * 2.1f - 30.0f;
+        zs[i] = (float)(i % 11) * -3.3f + 7.0f;
+    }
+
+    for (auto warpType : warpTypes) {
+        for (auto fractal : fractals) {
+            for (auto rotation : rotations) {
+                NoiseGen gen(321);
+                gen.SetDomainWarpType(warpType);
+                gen.SetDomainWarpAmp(30.0f);
+                gen.SetFrequency(0.02f);
+                gen.SetFractalType(fractal);
+                gen.SetFractalOctaves(3);
+                gen.SetRotationType3D(rotation);
+
+                std::vector<float> wx = xs, wy = ys, wz = zs;
+                gen.DomainWarpArray3D(wx.data(), wy.data(), wz.data(), count);
+
+                std::vector<double> dx(xs.begin(), xs.end()), dy(ys.begin(), ys.end());
+                gen.DomainWarpArray2D(dx.data(), dy.data(), count);
+
+                for (size_t i = 0; i < count; i++) {
+                    float x = xs[i], y = ys[i], z = zs[i];
+                    gen.DomainWarp(x, y, z);
+                    CHECK(std::abs(wx[i] - x) < 1e-4f);
+                    CHECK(std::abs(wy[i] - y) < 1e-4f);
+                    CHECK(std::abs(wz[i] - z) < 1e-4f);
+
+                    double x2 = xs[i], y2 = ys[i];
+                    gen.DomainWarp(x2, y2);
+                    CHECK(std::abs(dx[i] - x2) < 1e-6);
+                    CHECK(std::abs(dy[i] - y2) < 1e-6);
+                }
+            }
+        }
+    }
+
+    SUBCASE("Warped arrays feed the batch noise call") {
+        NoiseGen warp(11);
+        warp.SetDomainWarpAmp(20.0f);
+        warp.SetFractalType(NoiseGen::FractalType_DomainWarpIndependent);
+
+        NoiseGen noise(12);
+        noise.SetFractalType(NoiseGen::FractalType_FBm);
+
+        std::vector<float> wx = xs, wy = ys, out(count);
+        warp.DomainWarpArray2D(wx.data(), wy.data(), count);
+        noise.GetNoiseArray2D(wx.data(), wy.data(), out.data(), count);
+
+        for (size_t i = 0; i < count; i++) {
+            float x = xs[i], y = ys[i];
+            warp.DomainWarp(x, y);
+            CHECK(std::abs(out[i] - noise.GetNoise(x, y)) < 1e-5f);
+        }
+    }
+}
+
+TEST_CASE("Warped grid matches DomainWarp then GetNoise") {
+    NoiseGen warp(3);
+    warp.SetDomainWarpAmp(25.0f);
+    warp.SetFrequency(0.015f);
+    warp.SetFractalType(NoiseGen::FractalType_DomainWarpProgressive);
+    warp.SetRotationType3D(NoiseGen::RotationType3D_ImproveXYPlanes);
+
+    const NoiseGen::NoiseType types[] = {NoiseGen::NoiseType_OpenSimplex2, NoiseGen::NoiseType_Perlin,
+                                         NoiseGen::NoiseType_Cellular};
+    for (auto type : types) {
+        NoiseGen noise(4);
+        noise.SetNoiseType(type);
+        noise.SetFractalType(NoiseGen::FractalType_Ridged);
+        noise.SetFrequency(0.04f);
+
+        const int xSize = 300, ySize = 3, zSize = 2;
+        std::vector<float> grid2D(xSize * ySize), grid3D(xSize * ySize * zSize);
+        noise.GetWarpedNoiseGrid2D(warp, grid2D.data(), -40, 2, xSize, ySize, 0.5f);
+        noise.GetWarpedNoiseGrid3D(warp, grid3D.data(), -40, 2, 9, xSize, ySize, zSize, 0.5f);
+
+        for (int z = 0; z < zSize; z++) {
+            for (int y = 0; y < ySize; y++) {
+                for (int x = 0; x < xSize; x++) {
+                    float px = (float)(-40 + x) * 0.5f, py = (float)(2 + y) * 0.5f, pz = (float)(9 + z) * 0.5f;
+                    if (z == 0) {
+                        float wx = px, wy = py;
+                        warp.DomainWarp(wx, wy);
+                        CHECK(std::abs(grid2D[y * xSize + x] - noise.GetNoise(wx, wy)) < 1e-5f);
+                    }
+                    warp.DomainWarp(px, py, pz);
+                    CHECK(std::abs(grid3D[(z * ySize + y) * xSize + x] - noise.GetNoise(px, py, pz)) < 1e-5f);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Cached warp field") {
+    NoiseGen warp(8);
+    warp.SetDomainWarpAmp(30.0f);
+    warp.SetFrequency(0.01f);
+    warp.SetFractalType(NoiseGen::FractalType_DomainWarpIndependent);
+
+    NoiseGen noise(9);
+    noise.SetNoiseType(NoiseGen::NoiseType_Perlin);
+    noise.SetFrequency(0.03f);
+
+    SUBCASE("Decimation 1 matches the exact warped grid") {
+        for (int cubic = 0; cubic < 2; cubic++) {
+            NoiseGen::WarpField field;
+            std::vector<float> cached(70 * 5), exact(70 * 5);
+
+            warp.BuildWarpField2D(field, -20, 3, 70, 5, 1, 0.5f, cubic != 0);
+            noise.GetWarpedNoiseGrid2D(field, cached.data());
+            noise.GetWarpedNoiseGrid2D(warp, exact.data(), -20, 3, 70, 5, 0.5f);
+            CHECK(field.maxError == 0.0f);
+            for (size_t i = 0; i < cached.size(); i++) {
+                CHECK(std::abs(cached[i] - exact[i]) < 1e-4f);
+            }
+
+            warp.BuildWarpField3D(field, -20, 3, 1, 70, 3, 2, 1, 0.5f, cubic != 0);
+            cached.resize(70 * 3 * 2);
+            exact.resize(70 * 3 * 2);
+            noise.GetWarpedNoiseGrid3D(field, cached.data());
+            noise.GetWarpedNoiseGrid3D(warp, exact.data(), -20, 3, 1, 70, 3, 2, 0.5f);
+            for (size_t i = 0; i < cached.size(); i++) {
+                CHECK(std::abs(cached[i] - exact[i]) < 1e-4f);
+            }
+        }
+    }
+
+    SUBCASE("Mismatched dimensions are rejected") {
+        NoiseGen::WarpField field2D, field3D;
+        warp.BuildWarpField2D(field2D, 0, 0, 16, 4, 2);
+        warp.BuildWarpField3D(field3D, 0, 0, 0, 16, 4, 1, 2);
+
+        std::vector<float> out(16 * 4, -7.0f);
+        noise.GetWarpedNoiseGrid2D(field3D, out.data());
+        noise.GetWarpedNoiseGrid3D(field2D, out.data());
+        for (float v : out) {
+            CHECK(v == -7.0f);
+        }
+    }
+
+    SUBCASE("Nodes hold the exact displacement") {
+        NoiseGen::WarpField field;
+        warp.BuildWarpField3D(field, 5, -7, 2, 33, 17, 9, 4, 1.0f, true);
+        CHECK(field.xNodes == 12);
+        CHECK(field.yNodes == 8);
+        CHECK(field.zNodes == 6);
+
+        for (int z = 0; z < field.zNodes; z++) {
+            for (int y = 0; y < field.yNodes; y++) {
+                for (int x = 0; x < field.xNodes; x++) {
+                    float px = (float)(5 + (x - 1) * 4), py = (float)(-7 + (y - 1) * 4), pz = (float)(2 + (z - 1) * 4);
+                    float wx = px, wy = py, wz = pz;
+                    warp.DomainWarp(wx, wy, wz);
+                    const float *node = &field.displacement[(((size_t)z * field.yNodes + y) * field.xNodes + x) * 3];
+                    CHECK(std::abs(node[0] - (wx - px)) < 1e-4f);
+                    CHECK(std::abs(node[1] - (wy - py)) < 1e-4f);
+                    CHECK(std::abs(node[2] - (wz - pz)) < 1e-4f);
+                }
+            }
+        }
+    }
+
+    SUBCASE("Error estimate tracks decimation and interpolation") {
+        NoiseGen::WarpField linear4, cubic4, linear16;
+        warp.BuildWarpField2D(linear4, 0, 0, 128, 128, 4);
+        warp.BuildWarpField2D(cubic4, 0, 0, 128, 128, 4, 1.0f, true);
+        warp.BuildWarpField2D(linear16, 0, 0, 128, 128, 16);
+
+        CHECK(linear4.maxError > 0.0f);
+        CHECK(cubic4.maxError < linear4.maxError);
+        CHECK(linear4.maxError < linear16.maxError);
+
+        // Displacement error only moves the sample point, so the noise error stays small for a smooth warp
+        std::vector<float> cached(128 * 128), exact(128 * 128);
+        noise.GetWarpedNoiseGrid2D(cubic4, cached.data());
+        noise.GetWarpedNoiseGrid2D(warp, exact.data(), 0, 0, 128, 128);
+        float maxDiff = 0;
+        for (size_t i = 0; i < cached.size(); i++) {
+            maxDiff = std::max(maxDiff, std::abs(cached[i] - exact[i]));
+        }
+        CHECK(maxDiff < 0.05f);
+    }
+}
+
+TEST_CASE("Animated noise slice matches GetNoise") {
+    const int xSize = 37, ySize = 11;
+    std::vector<float> frame(xSize * ySize);
+
+    auto checkFrames = [&](const NoiseGen &gen, float tolerance) {
+        NoiseGen::NoiseSlice slice;
+        gen.BuildNoiseSlice3D(slice, -20, 4, xSize, ySize, 0.75f);
+
+        // Small steps within a cell, a step to the next cell, a jump and a step backwards
+        const float frames[] = {0.0f, 0.3f, 0.6f, 1.1f, 1.4f, 40.2f, 39.7f, -3.5f};
+        for (float t : frames) {
+            gen.GetNoiseSlice3D(slice, t, frame.data());
+            for (int y = 0; y < ySize; y++) {
+                for (int x = 0; x < xSize; x++) {
+                    float expected = gen.GetNoise((float)(-20 + x) * 0.75f, (float)(4 + y) * 0.75f, t);
+                    CHECK(std::abs(frame[y * xSize + x] - expected) <= tolerance);
+                }
+            }
+        }
+    };
+
+    SUBCASE("Value planes are exact") {
+        NoiseGen gen(12);
+        gen.SetNoiseType(NoiseGen::NoiseType_Value);
+        gen.SetFrequency(0.3f);
+        checkFrames(gen, 0.0f);
+
+        gen.SetFractalType(NoiseGen::FractalType_FBm);
+        gen.SetFractalOctaves(4);
+        gen.SetFractalWeightedStrength(0.5f);
+        checkFrames(gen, 1e-6f);
+    }
+
+    SUBCASE("Perlin planes") {
+        NoiseGen gen(13);
+        gen.SetNoiseType(NoiseGen::NoiseType_Perlin);
+        gen.SetFrequency(0.3f);
+        checkFrames(gen, 1e-5f);
+
+        gen.SetFractalType(NoiseGen::FractalType_Ridged);
+        gen.SetFractalOctaves(3);
+        checkFrames(gen, 1e-5f);
+    }
+
+    SUBCASE("Cached positions for other settings") {
+        NoiseGen gen(14);
+        gen.SetFrequency(0.1f);
+        gen.SetRotationType3D(NoiseGen::RotationType3D_ImproveXYPlanes);
+        // OpenSimplex2 jumps by up to ~1e-3 where float rounding moves a position across a lattice choice
+        checkFrames(gen, 2e-3f);
+
+        gen.SetNoiseType(NoiseGen::NoiseType_Cellular);
+        gen.SetRotationType3D(NoiseGen::RotationType3D_None);
+        gen.SetFractalType(NoiseGen::FractalType_PingPong);
+        checkFrames(gen, 1e-4f);
+    }
+}
+
+static float HalfToFloat(uint16_t half) {
+    int exponent = (half >> 10) & 0x1f;
+    int mantissa = half & 0x3ff;
+    float value =
+        exponent == 0 ? std::ldexp((float)mantissa, -24) : std::ldexp((float)(mantissa | 0x400), exponent - 25);
+    return half & 0x8000 ? -value : value;
+}
+
+TEST_CASE("Quantized grid output") {
+    NoiseGen gen(77);
+    gen.SetFractalType(NoiseGen::FractalType_FBm);
+    gen.SetFrequency(0.03f);
+
+    const int xSize = 300, ySize = 5;
+    std::vector<float> grid(xSize * ySize);
+    gen.GetNoiseGrid2D(grid.data(), -9, 3, xSize, ySize);
+
+    SUBCASE("8 and 16 bit unsigned normalized") {
+        std::vector<uint8_t> u8(grid.size());
+        std::vector<uint16_t> u16(grid.size());
+        gen.GetNoiseGrid2D(u8.data(), -9, 3, xSize, ySize);
+        gen.GetNoiseGrid2D(u16.data(), -9, 3, xSize, ySize);
+
+        for (size_t i = 0; i < grid.size(); i++) {
+            CHECK(std::abs(u8[i] - (grid[i] + 1) * 0.5f * 255) <= 0.5f + 1e-3f);
+            CHECK(std::abs(u16[i] - (grid[i] + 1) * 0.5f * 65535) <= 0.5f + 0.1f);
+        }
+    }
+
+    SUBCASE("Remap range clamps") {
+        std::vector<uint8_t> mask(grid.size());
+        gen.GetNoiseGrid2D(mask.data(), -9, 3, xSize, ySize, 1.0f, 0.0f, 0.25f);
+
+        int low = 0, high = 0;
+        for (size_t i = 0; i < grid.size(); i++) {
+            if (grid[i] <= 0) {
+                CHECK(mask[i] == 0);
+                low++;
+            } else if (grid[i] >= 0.25f) {
+                CHECK(mask[i] == 255);
+                high++;
+            } else {
+                CHECK(std::abs(mask[i] - grid[i] * 4 * 255) <= 0.5f + 1e-3f);
+            }
+        }
+        CHECK(low > 0);
+        CHECK(high > 0);
+    }
+
+    SUBCASE("Half precision") {
+        std::vector<uint16_t> half(grid.size());
+        gen.GetNoiseGridHalf2D(half.data(), -9, 3, xSize, ySize, 1.0f, 100.0f, 20.0f);
+        for (size_t i = 0; i < grid.size(); i++) {
+            float expected = grid[i] * 100.0f + 20.0f;
+            CHECK(std::abs(HalfToFloat(half[i]) - expected) <= std::abs(expected) * (1.0f / 2048) + 1e-6f);
+        }
+
+        // Exact encodings, rounding to even and saturation, with scale 0 so the output is the offset
+        const float offsets[] = {1.0f, -2.0f, 65504.0f, 1e6f, 1.0f + 1.0f / 2048, std::ldexp(1.0f, -24)};
+        const uint16_t encodings[] = {0x3c00, 0xc000, 0x7bff, 0x7bff, 0x3c00, 0x0001};
+        for (int k = 0; k < 6; k++) {
+            uint16_t out;
+            gen.GetNoiseGridHalf2D(&out, 0, 0, 1, 1, 1.0f, 0.0f, offsets[k]);
+            CHECK(out == encodings[k]);
+        }
+    }
+
+    SUBCASE("3D grids") {
+        std::vector<float> volume(17 * 6 * 4);
+        std::vector<uint16_t> u16(volume.size()), half(volume.size());
+        gen.GetNoiseGrid3D(volume.data(), 2, -3, 1, 17, 6, 4, 0.5f);
+        gen.GetNoiseGrid3D(u16.data(), 2, -3, 1, 17, 6, 4, 0.5f);
+        gen.GetNoiseGridHalf3D(half.data(), 2, -3, 1, 17, 6, 4, 0.5f);
+
+        for (size_t i = 0; i < volume.size(); i++) {
+            CHECK(std::abs(u16[i] - (volume[i] + 1) * 0.5f * 65535) <= 0.5f + 0.1f);
+            CHECK(std::abs(HalfToFloat(half[i]) - volume[i]) <= 1.0f / 2048);
+        }
+    }
+}
+
+TEST_CASE("Normal and slope grids") {
+    const int xSize = 40, ySize = 24;
+
+    auto checkSurface = [&](const NoiseGen &gen, float step, float derivativeTolerance, bool analytic = false) {
+        std::vector<float> height(xSize * ySize), slope(xSize * ySize), grid(xSize * ySize);
+        std::vector<uint32_t> normals(xSize * ySize);
+        gen.GetNoiseNormalGrid2D(height.data(), normals.data(), slope.data(), -7, 11, xSize, ySize, step, 8.0f,
+                                 NoiseGen::NormalPacking_RGB8, analytic);
+        gen.GetNoiseGrid2D(grid.data(), -7, 11, xSize, ySize, step);
+
+        const double h = 1e-3 * step;
+        for (int y = 0; y < ySize; y++) {
+            for (int x = 0; x < xSize; x++) {
+                size_t i = (size_t)y * xSize + x;
+                CHECK(height[i] == grid[i]);
+
+                double px = (double)(-7 + x) * step, py = (double)(11 + y) * step;
+                float dx = (float)((gen.GetNoise(px + h, py) - gen.GetNoise(px - h, py)) / (2 * h) * 8);
+                float dy = (float)((gen.GetNoise(px, py + h) - gen.GetNoise(px, py - h)) / (2 * h) * 8);
+                CHECK(std::abs(slope[i] - std::sqrt(dx * dx + dy * dy)) < derivativeTolerance);
+
+                float nz = 1 / std::sqrt(dx * dx + dy * dy + 1);
+                float r = (normals[i] & 0xff) / 127.5f - 1, g = ((normals[i] >> 8) & 0xff) / 127.5f - 1;
+                float b = ((normals[i] >> 16) & 0xff) / 127.5f - 1;
+                CHECK(std::abs(r + dx * nz) < 0.02f + derivativeTolerance);
+                CHECK(std::abs(g + dy * nz) < 0.02f + derivativeTolerance);
+                CHECK(std::abs(b - nz) < 0.02f + derivativeTolerance);
+                CHECK((normals[i] >> 24) == 0xff);
+            }
+        }
+    };
+
+    SUBCASE("Analytic derivatives") {
+        NoiseGen gen(5);
+        gen.SetFrequency(0.05f);
+        gen.SetNoiseType(NoiseGen::NoiseType_Value);
+        checkSurface(gen, 1.0f, 2e-3f, true);
+
+        gen.SetNoiseType(NoiseGen::NoiseType_Perlin);
+        gen.SetFractalType(NoiseGen::FractalType_FBm);
+        checkSurface(gen, 0.5f, 2e-2f, true);
+
+        gen.SetFractalType(NoiseGen::FractalType_Ridged);
+        gen.SetFractalOctaves(2);
+        checkSurface(gen, 1.0f, 2e-2f, true);
+    }
+
+    SUBCASE("Central differences") {
+        // Differences over one grid step, so compare against a step small relative to the noise frequency
+        NoiseGen gen(6);
+        gen.SetFrequency(0.002f);
+        checkSurface(gen, 1.0f, 5e-3f);
+
+        gen.SetFractalType(NoiseGen::FractalType_FBm);
+        gen.SetFractalWeightedStrength(0.5f);
+        checkSurface(gen, 1.0f, 5e-3f);
+
+        // Perlin takes differences too unless analytic derivatives are requested
+        gen.SetNoiseType(NoiseGen::NoiseType_Perlin);
+        gen.SetFractalWeightedStrength(0.0f);
+        checkSurface(gen, 1.0f, 5e-3f);
+    }
+
+    SUBCASE("Adjacent tiles share normals along edges") {
+        NoiseGen gen(9);
+        gen.SetNoiseType(NoiseGen::NoiseType_OpenSimplex2S);
+        gen.SetFrequency(0.1f);
+
+        std::vector<uint32_t> whole(64 * 32), left(32 * 32), right(32 * 32), top(64 * 16);
+        gen.GetNoiseNormalGrid2D(nullptr, whole.data(), nullptr, 0, 0, 64, 32);
+        gen.GetNoiseNormalGrid2D(nullptr, left.data(), nullptr, 0, 0, 32, 32);
+        gen.GetNoiseNormalGrid2D(nullptr, right.data(), nullptr, 32, 0, 32, 32);
+        gen.GetNoiseNormalGrid2D(nullptr, top.data(), nullptr, 0, 0, 64, 16);
+
+        for (int y = 0; y < 32; y++) {
+            for (int x = 0; x < 32; x++) {
+                CHECK(left[y * 32 + x] == whole[y * 64 + x]);
+                CHECK(right[y * 32 + x] == whole[y * 64 + 32 + x]);
+            }
+        }
+        for (int x = 0; x < 64; x++) {
+            CHECK(top[15 * 64 + x] == whole[15 * 64 + x]);
+        }
+    }
+
+    SUBCASE("Octahedral packing") {
+        NoiseGen gen(10);
+        gen.SetNoiseType(NoiseGen::NoiseType_Perlin);
+        gen.SetFrequency(0.08f);
+
+        std::vector<uint32_t> rgb(xSize * ySize), octahedral(xSize * ySize);
+        gen.GetNoiseNormalGrid2D(nullptr, rgb.data(), nullptr, 0, 0, xSize, ySize, 1.0f, 4.0f);
+        gen.GetNoiseNormalGrid2D(nullptr, octahedral.data(), nullptr, 0, 0, xSize, ySize, 1.0f, 4.0f,
+                                 NoiseGen::NormalPacking_Octahedral16);
+
+        for (size_t i = 0; i < rgb.size(); i++) {
+            float u = (octahedral[i] & 0xffff) / 32767.5f - 1, v = (octahedral[i] >> 16) / 32767.5f - 1;
+            float w = 1 - std::abs(u) - std::abs(v);
+            float length = std::sqrt(u * u + v * v + w * w);
+            CHECK(w >= 0.0f);
+            CHECK(std::abs(u / length - ((rgb[i] & 0xff) / 127.5f - 1)) < 0.01f);
+            CHECK(std::abs(v / length - (((rgb[i] >> 8) & 0xff) / 127.5f - 1)) < 0.01f);
+        }
+    }
+}
+
+TEST_CASE("Padded chunks share borders") {
+    auto checkRegion = [](const NoiseGen &gen, int size, int padding, float step) {
+        const int n = size + 2 * padding;
+        std::vector<float> chunk((size_t)n * n * n), expected(chunk.size());
+        NoiseGen::ChunkBorderCache cache;
+
+        // Visit order mixes directions so borders are both produced and consumed from every side
+        const int order[] = {1, 0, 2};
+        for (int cz : order) {
+            for (int cy : order) {
+                for (int cx : order) {
+                    gen.GetNoiseChunk3D(chunk.data(), cx, cy, cz, size, padding, step, &cache);
+                    gen.GetNoiseGrid3D(expected.data(), cx * size - padding, cy * size - padding, cz * size - padding,
+                                       n, n, n, step);
+                    for (size_t i = 0; i < chunk.size(); i++) {
+                        CHECK(chunk[i] == expected[i]);
+                    }
+                }
+            }
+        }
+
+        const size_t regionSize = (size_t)(3 * size + 2 * padding);
+        CHECK(cache.samplesComputed == regionSize * regionSize * regionSize);
+        CHECK(cache.chunks.count({1, 1, 1}) == 0);
+        CHECK(cache.chunks.count({0, 0, 0}) == 1);
+    };
+
+    NoiseGen gen(17);
+    gen.SetFrequency(0.09f);
+    gen.SetFractalType(NoiseGen::FractalType_FBm);
+    checkRegion(gen, 8, 2, 1.0f);
+    checkRegion(gen, 6, 1, 0.5f);
+    checkRegion(gen, 4, 2, 1.0f);
+
+    gen.SetNoiseType(NoiseGen::NoiseType_Cellular);
+    checkRegion(gen, 8, 1, 1.0f);
+
+    SUBCASE("Regenerating a chunk keeps its neighbours' borders") {
+        const int size = 8, padding = 2, n = size + 2 * padding;
+        std::vector<float> chunk((size_t)n * n * n), expected(chunk.size());
+        NoiseGen::ChunkBorderCache cache;
+
+        // Chunk (0, 0, 0) and its neighbours except (1, 1, 1), regenerating every chunk once more along the way
+        for (int pass = 0; pass < 2; pass++) {
+            for (int cz = -1; cz <= 1; cz++) {
+                for (int cy = -1; cy <= 1; cy++) {
+                    for (int cx = -1; cx <= 1; cx++) {
+                        if (cx == 1 && cy == 1 && cz == 1) {
+                            continue;
+                        }
+                        gen.GetNoiseChunk3D(chunk.data(), cx, cy, cz, size, padding, 1.0f, &cache);
+                        gen.GetNoiseChunk3D(chunk.data(), cx, cy, cz, size, padding, 1.0f, &cache);
+                    }
+                }
+            }
+        }
+        CHECK(cache.chunks.count({0, 0, 0}) == 1);
+
+        // The last neighbour only computes the voxels no other chunk of the region covers
+        size_t computed = cache.samplesComputed;
+        gen.GetNoiseChunk3D(chunk.data(), 1, 1, 1, size, padding, 1.0f, &cache);
+        gen.GetNoiseGrid3D(expected.data(), size - padding, size - padding, size - padding, n, n, n);
+        CHECK(chunk == expected);
+        CHECK(cache.samplesComputed - computed == (size_t)size * size * size);
+        CHECK(cache.chunks.count({0, 0, 0}) == 0);
+    }
+
+    SUBCASE("Without a cache") {
+        std::vector<float> chunk(12 * 12 * 12), expected(chunk.size());
+        gen.GetNoiseChunk3D(chunk.data(), -2, 3, 0, 8, 2);
+        gen.GetNoiseGrid3D(expected.data(), -18, 22, -2, 12, 12, 12);
+        CHECK(chunk == expected);
+    }
+}
+
+TEST_CASE("Seed ensembles match per seed GetNoise") {
+    const NoiseGen::NoiseType types[] = {NoiseGen::NoiseType_OpenSimplex2, NoiseGen::NoiseType_OpenSimplex2S,
+                                         NoiseGen::NoiseType_Perlin,       NoiseGen::NoiseType_Value,
+                                         NoiseGen::NoiseType_ValueCubic,   NoiseGen::NoiseType_Cellular};
+    const NoiseGen::FractalType fractals[] = {NoiseGen::FractalType_None, NoiseGen::FractalType_FBm,
+                                              NoiseGen::FractalType_Ridged, NoiseGen::FractalType_PingPong};
+
+    std::vector<int> seeds(300);
+    for (size_t i = 0; i < seeds.size(); i++) {
+        seeds[i] = (int)(i * 7919) - 1000;
+    }
+
+    for (auto type : types) {
+        for (auto fractal : fractals) {
+            for (float weighted : {0.0f, 0.6f}) {
+                NoiseGen gen(0), single(0);
+                for (NoiseGen *g : {&gen, &single}) {
+                    g->SetNoiseType(type);
+                    g->SetFractalType(fractal);
+                    g->SetFractalOctaves(4);
+                    g->SetFractalWeightedStrength(weighted);
+                    g->SetFrequency(0.03f);
+                }
+
+                std::vector<float> out2(seeds.size()), out3(seeds.size()), outDouble(seeds.size());
+                gen.GetNoiseSeeds(13.7f, -402.25f, seeds.data(), out2.data(), (int)seeds.size());
+                gen.GetNoiseSeeds(13.7f, -402.25f, 88.5f, seeds.data(), out3.data(), (int)seeds.size());
+                gen.GetNoiseSeeds(1e5 + 0.3, 7.1, seeds.data(), outDouble.data(), (int)seeds.size());
+
+                for (size_t i = 0; i < seeds.size(); i++) {
+                    single.SetSeed(seeds[i]);
+                    CHECK(out2[i] == single.GetNoise(13.7f, -402.25f));
+                    CHECK(out3[i] == single.GetNoise(13.7f, -402.25f, 88.5f));
+                    CHECK(outDouble[i] == single.GetNoise(1e5 + 0.3, 7.1));
+                }
+            }
+        }
+    }
+
+    SUBCASE("Arrays interleave seeds per position") {
+        NoiseGen gen, single;
+        const float xs[] = {1.5f, -20.0f, 300.25f}, ys[] = {0.0f, 9.5f, -4.0f}, zs[] = {2.0f, 2.5f, 3.0f};
+        std::vector<float> out2(3 * 4), out3(3 * 4);
+        gen.GetNoiseSeedsArray2D(xs, ys, out2.data(), 3, seeds.data(), 4);
+        gen.GetNoiseSeedsArray3D(xs, ys, zs, out3.data(), 3, seeds.data(), 4);
+
+        for (int i = 0; i < 3; i++) {
+            for (int s = 0; s < 4; s++) {
+                single.SetSeed(seeds[s]);
+                CHECK(out2[i * 4 + s] == single.GetNoise(xs[i], ys[i]));
+                CHECK(out3[i * 4 + s] == single.GetNoise(xs[i], ys[i], zs[i]));
+            }
+        }
+    }
+}
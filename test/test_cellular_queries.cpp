@@ -0,0 +1,318 @@
+#include <cmath>
+#include <doctest/doctest.h>
+#include <entropy/entropy.hpp>
+#include <vector>
+
+using entropy::NoiseGen;
+
+static NoiseGen MakeCellular(NoiseGen::CellularDistanceFunction distanceFunction, NoiseGen::CellularReturnType type) {
+    NoiseGen gen(1234);
+    gen.SetNoiseType(NoiseGen::NoiseType_Cellular);
+    gen.SetFrequency(0.05f);
+    gen.SetCellularDistanceFunction(distanceFunction);
+    gen.SetCellularReturnType(type);
+    return gen;
+}
+
+TEST_CASE("GetCellular matches GetNoise return types") {
+    const NoiseGen::CellularDistanceFunction functions[] = {
+        NoiseGen::CellularDistanceFunction_Euclidean, NoiseGen::CellularDistanceFunction_EuclideanSq,
+        NoiseGen::CellularDistanceFunction_Manhattan, NoiseGen::CellularDistanceFunction_Hybrid};
+
+    SUBCASE("2D distances and cell value") {
+        for (auto function : functions) {
+            NoiseGen distance = MakeCellular(function, NoiseGen::CellularReturnType_Distance);
+            NoiseGen distance2 = MakeCellular(function, NoiseGen::CellularReturnType_Distance2);
+            NoiseGen cellValue = MakeCellular(function, NoiseGen::CellularReturnType_CellValue);
+
+            for (int i = 0; i < 200; ++i) {
+                float x = i * 1.37f - 100.0f;
+                float y = i * -0.91f + 40.0f;
+                NoiseGen::CellularResult result = distance.GetCellular(x, y);
+
+                CHECK(std::abs(result.distance[0] - 1 - distance.GetNoise(x, y)) < 1e-6f);
+                CHECK(std::abs(result.distance[1] - 1 - distance2.GetNoise(x, y)) < 1e-6f);
+                CHECK(result.cellValue == cellValue.GetNoise(x, y));
+            }
+        }
+    }
+
+    SUBCASE("3D distances and cell value with rotation") {
+        for (auto function : functions) {
+            NoiseGen distance = MakeCellular(function, NoiseGen::CellularReturnType_Distance);
+            NoiseGen distance2 = MakeCellular(function, NoiseGen::CellularReturnType_Distance2);
+            NoiseGen cellValue = MakeCellular(function, NoiseGen::CellularReturnType_CellValue);
+            distance.SetRotationType3D(NoiseGen::RotationType3D_ImproveXYPlanes);
+            distance2.SetRotationType3D(NoiseGen::RotationType3D_ImproveXYPlanes);
+            cellValue.SetRotationType3D(NoiseGen::RotationType3D_ImproveXYPlanes);
+
+            for (int i = 0; i < 200; ++i) {
+                float x = i * 1.37f - 100.0f;
+                float y = i * -0.91f + 40.0f;
+                float z = i * 0.53f;
+                NoiseGen::CellularResult result = distance.GetCellular(x, y, z);
+
+                CHECK(std::abs(result.distance[0] - 1 - distance.GetNoise(x, y, z)) < 1e-6f);
+                CHECK(std::abs(result.distance[1] - 1 - distance2.GetNoise(x, y, z)) < 1e-6f);
+                CHECK(result.cellValue == cellValue.GetNoise(x, y, z));
+            }
+        }
+    }
+}
+
+TEST_CASE("GetCellular extra outputs") {
+    NoiseGen gen = MakeCellular(NoiseGen::CellularDistanceFunction_Euclidean, NoiseGen::CellularReturnType_Distance);
+
+    SUBCASE("F1 to F4 are sorted") {
+        for (int i = 0; i < 200; ++i) {
+            NoiseGen::CellularResult result = gen.GetCellular(i * 0.77f, i * 1.31f, i * -0.4f, 4);
+            CHECK(result.distance[0] <= result.distance[1]);
+            CHECK(result.distance[1] <= result.distance[2]);
+            CHECK(result.distance[2] <= result.distance[3]);
+        }
+    }
+
+    SUBCASE("Feature point lies at distance F1") {
+        gen.SetRotationType3D(NoiseGen::RotationType3D_ImproveXZPlanes);
+
+        for (int i = 0; i < 200; ++i) {
+            float x = i * 0.77f, y = i * 1.31f, z = i * -0.4f;
+
+            NoiseGen::CellularResult result2D = gen.GetCellular(x, y);
+            float dx = (result2D.pointX - x) * 0.05f;
+            float dy = (result2D.pointY - y) * 0.05f;
+            CHECK(std::abs(std::sqrt(dx * dx + dy * dy) - result2D.distance[0]) < 1e-3f);
+            CHECK(result2D.pointZ == 0.0f);
+
+            NoiseGen::CellularResult result3D = gen.GetCellular(x, y, z);
+            dx = (result3D.pointX - x) * 0.05f;
+            dy = (result3D.pointY - y) * 0.05f;
+            float dz = (result3D.pointZ - z) * 0.05f;
+            CHECK(std::abs(std::sqrt(dx * dx + dy * dy + dz * dz) - result3D.distance[0]) < 1e-3f);
+        }
+    }
+
+    SUBCASE("Array variants match single queries") {
+        std::vector<float> xs, ys, zs;
+        for (int i = 0; i < 64; ++i) {
+            xs.push_back(i * 2.5f);
+            ys.push_back(i * -1.5f);
+            zs.push_back(i * 0.5f);
+        }
+        std::vector<NoiseGen::CellularResult> out2D(xs.size()), out3D(xs.size());
+        gen.GetCellularArray2D(xs.data(), ys.data(), out2D.data(), xs.size(), 3);
+        gen.GetCellularArray3D(xs.data(), ys.data(), zs.data(), out3D.data(), xs.size(), 3);
+
+        for (size_t i = 0; i < xs.size(); ++i) {
+            NoiseGen::CellularResult single = gen.GetCellular(xs[i], ys[i], 3);
+            CHECK(out2D[i].distance[2] == single.distance[2]);
+            CHECK(out2D[i].closestHash == single.closestHash);
+            CHECK(out2D[i].distance[3] == 0.0f);
+
+            single = gen.GetCellular(xs[i], ys[i], zs[i], 3);
+            CHECK(out3D[i].distance[2] == single.distance[2]);
+            CHECK(out3D[i].closestHash == single.closestHash);
+        }
+    }
+}
+
+TEST_CASE("Pruned 3D cellular search matches full scan") {
+    const NoiseGen::CellularDistanceFunction functions[] = {
+        NoiseGen::CellularDistanceFunction_Euclidean, NoiseGen::CellularDistanceFunction_EuclideanSq,
+        NoiseGen::CellularDistanceFunction_Manhattan, NoiseGen::CellularDistanceFunction_Hybrid};
+    // Distance2* returns prune below a jitter of 0.6 and scan every cell from there on, both sides are covered
+    const float jitters[] = {0.0f, 0.5f, 0.59f, 0.6f, 1.0f, 1.5f};
+
+    for (auto function : functions) {
+        for (float jitter : jitters) {
+            NoiseGen distance = MakeCellular(function, NoiseGen::CellularReturnType_Distance);
+            NoiseGen distance2 = MakeCellular(function, NoiseGen::CellularReturnType_Distance2);
+            NoiseGen cellValue = MakeCellular(function, NoiseGen::CellularReturnType_CellValue);
+            distance.SetCellularJitter(jitter);
+            distance2.SetCellularJitter(jitter);
+            cellValue.SetCellularJitter(jitter);
+
+            for (int i = 0; i < 300; ++i) {
+                float x = i * 3.17f - 400.0f;
+                float y = i * -2.29f + 90.0f;
+                float z = i * 1.13f;
+                // GetCellular always scans all 27 neighbouring cells
+                NoiseGen::CellularResult result = distance.GetCellular(x, y, z);
+
+                CHECK(std::abs(result.distance[0] - 1 - distance.GetNoise(x, y, z)) < 1e-6f);
+                CHECK(std::abs(result.distance[1] - 1 - distance2.GetNoise(x, y, z)) < 1e-6f);
+                CHECK(result.cellValue == cellValue.GetNoise(x, y, z));
+            }
+        }
+    }
+}
+
+TEST_CASE("Extended cellular search") {
+    SUBCASE("Large jitter stays continuous") {
+        // F1 is 1-Lipschitz, a missed feature point shows up as a jump between close samples
+        const float jitters[] = {2.0f, 4.0f};
+
+        for (float jitter : jitters) {
+            NoiseGen gen = MakeCellular(NoiseGen::CellularDistanceFunction_Euclidean,
+                                        NoiseGen::CellularReturnType_Distance);
+            gen.SetCellularJitter(jitter);
+            gen.SetCellularExtendedSearch(true);
+
+            const float step = 0.02f;
+            for (int i = 0; i < 5000; ++i) {
+                float x = i * step, y = 11.0f + i * step * 0.5f, z = -3.0f + i * step * 0.25f;
+
+                float a = gen.GetNoise(x, y), b = gen.GetNoise(x + step, y + step * 0.5f);
+                CHECK(std::abs(a - b) <= 0.05f * step * 1.2f);
+
+                a = gen.GetNoise(x, y, z), b = gen.GetNoise(x + step, y + step * 0.5f, z + step * 0.25f);
+                CHECK(std::abs(a - b) <= 0.05f * step * 1.2f);
+            }
+        }
+    }
+
+    SUBCASE("Never further than the adjacent search") {
+        NoiseGen adjacent = MakeCellular(NoiseGen::CellularDistanceFunction_Manhattan,
+                                         NoiseGen::CellularReturnType_Distance2);
+        NoiseGen extended = adjacent;
+        extended.SetCellularExtendedSearch(true);
+
+        for (int i = 0; i < 500; ++i) {
+            float x = i * 2.3f, y = i * -1.7f, z = i * 0.9f;
+            CHECK(extended.GetNoise(x, y) <= adjacent.GetNoise(x, y));
+            CHECK(extended.GetNoise(x, y, z) <= adjacent.GetNoise(x, y, z));
+        }
+    }
+
+    SUBCASE("Grid matches single queries") {
+        NoiseGen gen = MakeCellular(NoiseGen::CellularDistanceFunction_Hybrid, NoiseGen::CellularReturnType_CellValue);
+        gen.SetCellularJitter(3.0f);
+        gen.SetCellularExtendedSearch(true);
+
+        std::vector<float> grid(40 * 3);
+        gen.GetNoiseGrid3D(grid.data(), -20, 0, 5, 40, 3, 1);
+        for (int y = 0; y < 3; ++y) {
+            for (int x = 0; x < 40; ++x) {
+                CHECK(grid[y * 40 + x] == gen.GetNoise((float)(x - 20), (float)y, 5.0f));
+            }
+        }
+    }
+}
+
+TEST_CASE("Cellular point enumeration") {
+    // The closest enumerated point must be the cell GetNoise reports, for samples well inside the enumerated box
+    auto checkClosest2D = [](const NoiseGen &gen) {
+        std::vector<NoiseGen::CellularPoint> points;
+        gen.EnumerateCellularPoints(-60.0f, -60.0f, 60.0f, 60.0f, points);
+        CHECK(points.size() > 10);
+
+        for (int i = 0; i < 400; ++i) {
+            float x = -20.0f + (i % 20) * 2.1f, y = -20.0f + (i / 20) * 2.05f;
+            float best = 1e30f, value = 0;
+            for (const auto &point : points) {
+                float d = (point.x - x) * (point.x - x) + (point.y - y) * (point.y - y);
+                if (d < best) {
+                    best = d;
+                    value = point.cellValue;
+                }
+            }
+            CHECK(value == gen.GetNoise(x, y));
+        }
+    };
+
+    auto checkClosest3D = [](const NoiseGen &gen) {
+        std::vector<NoiseGen::CellularPoint> points;
+        gen.EnumerateCellularPoints(-60.0f, -60.0f, -60.0f, 60.0f, 60.0f, 60.0f, points);
+        CHECK(points.size() > 10);
+
+        for (int i = 0; i < 400; ++i) {
+            float x = -20.0f + (i % 7) * 5.9f, y = -20.0f + (i / 7 % 7) * 6.1f, z = -20.0f + (i / 49) * 4.7f;
+            float best = 1e30f, value = 0;
+            for (const auto &point : points) {
+                float d = (point.x - x) * (point.x - x) + (point.y - y) * (point.y - y) + (point.z - z) * (point.z - z);
+                if (d < best) {
+                    best = d;
+                    value = point.cellValue;
+                }
+            }
+            CHECK(value == gen.GetNoise(x, y, z));
+        }
+    };
+
+    NoiseGen gen = MakeCellular(NoiseGen::CellularDistanceFunction_Euclidean, NoiseGen::CellularReturnType_CellValue);
+
+    SUBCASE("Default jitter") {
+        checkClosest2D(gen);
+        checkClosest3D(gen);
+    }
+
+    SUBCASE("3D rotation") {
+        gen.SetRotationType3D(NoiseGen::RotationType3D_ImproveXYPlanes);
+        checkClosest3D(gen);
+    }
+
+    SUBCASE("Extended search with large jitter") {
+        gen.SetCellularExtendedSearch(true);
+        gen.SetCellularJitter(2.5f);
+        checkClosest2D(gen);
+        checkClosest3D(gen);
+    }
+
+    SUBCASE("Adjacent boxes report each point once") {
+        std::vector<NoiseGen::CellularPoint> whole, parts;
+        gen.EnumerateCellularPoints(0.0f, 0.0f, 0.0f, 80.0f, 40.0f, 40.0f, whole);
+        gen.EnumerateCellularPoints(0.0f, 0.0f, 0.0f, 40.0f, 40.0f, 40.0f, parts);
+        gen.EnumerateCellularPoints(40.0f, 0.0f, 0.0f, 80.0f, 40.0f, 40.0f, parts);
+        CHECK(whole.size() == parts.size());
+
+        size_t matched = 0;
+        for (const auto &a : whole) {
+            for (const auto &b : parts) {
+                matched += a.hash == b.hash && a.x == b.x && a.y == b.y && a.z == b.z;
+            }
+        }
+        CHECK(matched == whole.size());
+    }
+}
+
+TEST_CASE("Density driven scattering") {
+    NoiseGen lattice(77), density(5);
+    lattice.SetFrequency(0.25f);
+    density.SetFrequency(0.01f);
+
+    std::vector<NoiseGen::CellularPoint> candidates, kept;
+    lattice.EnumerateCellularPoints(0.0f, 0.0f, 400.0f, 400.0f, candidates);
+    lattice.ScatterPoints(density, 0.0f, 0.0f, 400.0f, 400.0f, kept);
+
+    SUBCASE("Kept points are candidates, thinned by density") {
+        size_t next = 0;
+        double expected = 0;
+        for (const auto &candidate : candidates) {
+            expected += std::fmin(std::fmax((density.GetNoise(candidate.x, candidate.y) + 1) * 0.5, 0.0), 1.0);
+            if (next < kept.size() && kept[next].hash == candidate.hash && kept[next].x == candidate.x) {
+                next++;
+            }
+        }
+        CHECK(next == kept.size());
+        CHECK(std::abs((double)kept.size() - expected) < expected * 0.05);
+        CHECK(kept.size() < candidates.size());
+    }
+
+    SUBCASE("Density range") {
+        std::vector<NoiseGen::CellularPoint> all, none;
+        lattice.ScatterPoints(density, 0.0f, 0.0f, 400.0f, 400.0f, all, -3.0f, -2.0f);
+        lattice.ScatterPoints(density, 0.0f, 0.0f, 400.0f, 400.0f, none, 2.0f, 3.0f);
+        CHECK(all.size() == candidates.size());
+        CHECK(none.empty());
+    }
+
+    SUBCASE("Tiles match the whole region") {
+        std::vector<NoiseGen::CellularPoint> tiles;
+        for (float y = 0; y < 400.0f; y += 100.0f) {
+            for (float x = 0; x < 400.0f; x += 100.0f) {
+                lattice.ScatterPoints(density, x, y, x + 100.0f, y + 100.0f, tiles);
+            }
+        }
+        CHECK(tiles.size() == kept.size());
+    }
+}
@@ -1,4 +1,5 @@
 #include <cmath>
+#include <cstdint>
 #include <doctest/doctest.h>
 #include <entropy/entropy.hpp>
 #include <vector>
@@ -309,3 +310,214 @@ TEST_CASE("Complex fractal configurations") {
         CHECK(noise <= 2.0f);
     }
 }
+
+TEST_CASE("Unweighted FBm matches the sequential octave loop") {
+    // A negligible weighted strength keeps every octave amplitude unchanged but takes the sequential path
+    const entropy::NoiseGen::NoiseType types[] = {
+        entropy::NoiseGen::NoiseType_OpenSimplex2, entropy::NoiseGen::NoiseType_OpenSimplex2S,
+        entropy::NoiseGen::NoiseType_Cellular,     entropy::NoiseGen::NoiseType_Perlin,
+        entropy::NoiseGen::NoiseType_ValueCubic,   entropy::NoiseGen::NoiseType_Value};
+
+    for (auto type : types) {
+        for (int octaves : {1, 5, 8, 12}) {
+            entropy::NoiseGen lanes(31), sequential(31);
+            for (entropy::NoiseGen *gen : {&lanes, &sequential}) {
+                gen->SetNoiseType(type);
+                gen->SetFractalType(entropy::NoiseGen::FractalType_FBm);
+                gen->SetFractalOctaves(octaves);
+                gen->SetFractalLacunarity(2.3f);
+            }
+            sequential.SetFractalWeightedStrength(1e-30f);
+
+            for (int i = 0; i < 50; i++) {
+                float x = i * 7.31f - 180.0f, y = i * -3.17f + 40.0f, z = i * 1.9f;
+                CHECK(std::abs(lanes.GetNoise(x, y) - sequential.GetNoise(x, y)) < 1e-6f);
+                CHECK(std::abs(lanes.GetNoise(x, y, z) - sequential.GetNoise(x, y, z)) < 1e-6f);
+            }
+        }
+    }
+}
+
+TEST_CASE("Threshold queries match GetNoise") {
+    const entropy::NoiseGen::NoiseType types[] = {
+        entropy::NoiseGen::NoiseType_OpenSimplex2, entropy::NoiseGen::NoiseType_OpenSimplex2S,
+        entropy::NoiseGen::NoiseType_Cellular,     entropy::NoiseGen::NoiseType_Perlin,
+        entropy::NoiseGen::NoiseType_ValueCubic,   entropy::NoiseGen::NoiseType_Value};
+    const entropy::NoiseGen::FractalType fractals[] = {
+        entropy::NoiseGen::FractalType_None, entropy::NoiseGen::FractalType_FBm,
+        entropy::NoiseGen::FractalType_Ridged, entropy::NoiseGen::FractalType_PingPong};
+
+    for (auto type : types) {
+        for (auto fractal : fractals) {
+            for (float weighted : {0.0f, 0.7f}) {
+                entropy::NoiseGen gen(12);
+                gen.SetNoiseType(type);
+                gen.SetFractalType(fractal);
+                gen.SetFractalOctaves(6);
+                gen.SetFractalWeightedStrength(weighted);
+                gen.SetFrequency(0.03f);
+
+                for (float threshold : {-0.6f, 0.0f, 0.25f, 0.8f}) {
+                    for (int i = 0; i < 300; i++) {
+                        float x = i * 3.7f - 500.0f, y = i * -1.3f, z = i * 0.61f + 20.0f;
+                        CHECK(gen.IsAbove(x, y, threshold) == (gen.GetNoise(x, y) > threshold));
+                        CHECK(gen.IsAbove(x, y, z, threshold) == (gen.GetNoise(x, y, z) > threshold));
+                        CHECK(gen.IsAbove((double)x, (double)y, threshold) ==
+                              (gen.GetNoise((double)x, (double)y) > threshold));
+                    }
+                }
+            }
+        }
+    }
+
+    SUBCASE("Exact at the noise value") {
+        entropy::NoiseGen gen(3);
+        gen.SetFractalType(entropy::NoiseGen::FractalType_FBm);
+        gen.SetFractalOctaves(8);
+        for (int i = 0; i < 200; i++) {
+            float x = i * 1.7f, y = i * 0.3f, noise = gen.GetNoise(x, y);
+            CHECK_FALSE(gen.IsAbove(x, y, noise));
+            CHECK(gen.IsAbove(x, y, std::nextafter(noise, -1.0f)));
+        }
+    }
+
+    SUBCASE("Bit grids") {
+        entropy::NoiseGen gen(4);
+        gen.SetFractalType(entropy::NoiseGen::FractalType_Ridged);
+        gen.SetFractalOctaves(5);
+
+        const int xSize = 37, ySize = 5, zSize = 3;
+        std::vector<float> grid(xSize * ySize * zSize);
+        std::vector<uint64_t> bits((grid.size() + 63) / 64, ~0ull);
+
+        gen.GetNoiseGrid2D(grid.data(), -10, 4, xSize, ySize, 0.5f);
+        gen.IsAboveGrid2D(bits.data(), -10, 4, xSize, ySize, 0.1f, 0.5f);
+        for (int i = 0; i < xSize * ySize; i++) {
+            CHECK(((bits[i / 64] >> (i % 64)) & 1) == (grid[i] > 0.1f ? 1u : 0u));
+        }
+        CHECK((bits[(xSize * ySize) / 64] >> ((xSize * ySize) % 64)) == 0);
+
+        gen.GetNoiseGrid3D(grid.data(), 3, -2, 7, xSize, ySize, zSize);
+        gen.IsAboveGrid3D(bits.data(), 3, -2, 7, xSize, ySize, zSize, -0.2f);
+        for (size_t i = 0; i < grid.size(); i++) {
+            CHECK(((bits[i / 64] >> (i % 64)) & 1) == (grid[i] > -0.2f ? 1u : 0u));
+        }
+
+        std::vector<float> xs = {1.0f, 50.0f, -7.5f}, ys = {2.0f, -3.0f, 8.25f}, zs = {0.5f, 9.0f, -1.0f};
+        bool above2[3], above3[3];
+        gen.IsAboveArray2D(xs.data(), ys.data(), above2, 3, 0.0f);
+        gen.IsAboveArray3D(xs.data(), ys.data(), zs.data(), above3, 3, 0.0f);
+        for (int i = 0; i < 3; i++) {
+            CHECK(above2[i] == (gen.GetNoise(xs[i], ys[i]) > 0.0f));
+            CHECK(above3[i] == (gen.GetNoise(xs[i], ys[i], zs[i]) > 0.0f));
+        }
+    }
+}
+
+TEST_CASE("Fractal tolerance bounds the error") {
+    const entropy::NoiseGen::NoiseType types[] = {
+        entropy::NoiseGen::NoiseType_OpenSimplex2, entropy::NoiseGen::NoiseType_OpenSimplex2S,
+        entropy::NoiseGen::NoiseType_Perlin, entropy::NoiseGen::NoiseType_ValueCubic,
+        entropy::NoiseGen::NoiseType_Value};
+    const entropy::NoiseGen::FractalType fractals[] = {entropy::NoiseGen::FractalType_FBm,
+                                                       entropy::NoiseGen::FractalType_Ridged,
+                                                       entropy::NoiseGen::FractalType_PingPong};
+
+    for (auto type : types) {
+        for (auto fractal : fractals) {
+            for (float weighted : {0.0f, 0.6f}) {
+                for (float tolerance : {0.01f, 0.1f}) {
+                    entropy::NoiseGen full(9), fast(9);
+                    for (entropy::NoiseGen *gen : {&full, &fast}) {
+                        gen->SetNoiseType(type);
+                        gen->SetFractalType(fractal);
+                        gen->SetFractalOctaves(10);
+                        gen->SetFractalWeightedStrength(weighted);
+                        gen->SetFrequency(0.05f);
+                    }
+                    fast.SetFractalTolerance(tolerance);
+
+                    int differ = 0;
+                    for (int i = 0; i < 400; i++) {
+                        float x = i * 2.3f - 300.0f, y = i * -0.9f, z = i * 1.1f + 6.0f;
+                        float error2 = std::abs(fast.GetNoise(x, y) - full.GetNoise(x, y));
+                        float error3 = std::abs(fast.GetNoise(x, y, z) - full.GetNoise(x, y, z));
+                        CHECK(error2 <= tolerance);
+                        CHECK(error3 <= tolerance);
+                        differ += error2 > 0;
+                    }
+                    CHECK(differ > 0);
+                }
+            }
+        }
+    }
+
+    SUBCASE("Zero tolerance evaluates every octave") {
+        entropy::NoiseGen full(2), exact(2);
+        for (entropy::NoiseGen *gen : {&full, &exact}) {
+            gen->SetFractalType(entropy::NoiseGen::FractalType_FBm);
+            gen->SetFractalOctaves(12);
+            gen->SetFractalGain(0.3f);
+        }
+        exact.SetFractalTolerance(0.0f);
+        for (int i = 0; i < 200; i++) {
+            CHECK(exact.GetNoise(i * 3.1f, i * 0.7f) == full.GetNoise(i * 3.1f, i * 0.7f));
+        }
+    }
+
+    SUBCASE("Batch calls and threshold queries follow the tolerance") {
+        entropy::NoiseGen gen(5);
+        gen.SetFractalType(entropy::NoiseGen::FractalType_Ridged);
+        gen.SetFractalOctaves(9);
+        gen.SetFractalTolerance(0.05f);
+
+        const int xSize = 40, ySize = 6;
+        std::vector<float> grid(xSize * ySize);
+        gen.GetNoiseGrid2D(grid.data(), -20, 3, xSize, ySize);
+        for (int y = 0; y < ySize; y++) {
+            for (int x = 0; x < xSize; x++) {
+                float noise = gen.GetNoise((float)(x - 20), (float)(y + 3));
+                CHECK(std::abs(grid[y * xSize + x] - noise) < 1e-6f);
+                CHECK(gen.IsAbove((float)(x - 20), (float)(y + 3), 0.1f) == (noise > 0.1f));
+            }
+        }
+    }
+
+    SUBCASE("Domain warp fractals") {
+        const entropy::NoiseGen::DomainWarpType warps[] = {entropy::NoiseGen::DomainWarpType_OpenSimplex2,
+                                                           entropy::NoiseGen::DomainWarpType_OpenSimplex2Reduced,
+                                                           entropy::NoiseGen::DomainWarpType_BasicGrid};
+        for (auto warp : warps) {
+            for (auto fractal : {entropy::NoiseGen::FractalType_DomainWarpIndependent,
+                                 entropy::NoiseGen::FractalType_DomainWarpProgressive}) {
+                entropy::NoiseGen full(17), fast(17);
+                for (entropy::NoiseGen *gen : {&full, &fast}) {
+                    gen->SetDomainWarpType(warp);
+                    gen->SetFractalType(fractal);
+                    gen->SetFractalOctaves(8);
+                    gen->SetDomainWarpAmp(30.0f);
+                }
+                fast.SetFractalTolerance(0.5f);
+
+                int differ = 0;
+                for (int i = 0; i < 300; i++) {
+                    float x0 = i * 5.3f - 700.0f, y0 = i * -2.1f, z0 = i * 0.7f;
+                    float xf = x0, yf = y0, zf = z0, xa = x0, ya = y0, za = z0;
+                    full.DomainWarp(xf, yf, zf);
+                    fast.DomainWarp(xa, ya, za);
+                    CHECK(std::abs(xa - xf) <= 0.5f);
+                    CHECK(std::abs(ya - yf) <= 0.5f);
+                    CHECK(std::abs(za - zf) <= 0.5f);
+                    differ += xa != xf;
+
+                    xf = xa = x0, yf = ya = y0;
+                    full.DomainWarp(xf, yf);
+                    fast.DomainWarp(xa, ya);
+                    CHECK(std::abs(xa - xf) <= 0.5f);
+                    CHECK(std::abs(ya - yf) <= 0.5f);
+                }
+                CHECK(differ > 0);
+            }
+        }
+    }
+}
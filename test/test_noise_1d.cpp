@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cmath>
+#include <doctest/doctest.h>
+#include <entropy/entropy.hpp>
+#include <vector>
+
+using entropy::NoiseGen;
+
+static const NoiseGen::NoiseType Types1D[] = {NoiseGen::NoiseType_Perlin, NoiseGen::NoiseType_Value,
+                                              NoiseGen::NoiseType_ValueCubic, NoiseGen::NoiseType_OpenSimplex2};
+
+TEST_CASE("1D noise range and continuity") {
+    // Over 1000 cells every seed should come close to both ends of [-1, 1]. ValueCubic only reaches them when four
+    // neighbouring lattice values alternate between the extremes, so it gets a lower bound.
+    const struct {
+        NoiseGen::NoiseType type;
+        float reach;
+    } kernels[] = {{NoiseGen::NoiseType_Perlin, 0.9f},
+                   {NoiseGen::NoiseType_Value, 0.95f},
+                   {NoiseGen::NoiseType_ValueCubic, 0.75f},
+                   {NoiseGen::NoiseType_OpenSimplex2, 0.9f}};
+
+    for (auto &kernel : kernels) {
+        for (int seed : {0, 1, 7, 1337, -1, 31337}) {
+            NoiseGen gen(seed);
+            gen.SetNoiseType(kernel.type);
+            gen.SetFrequency(1.0f);
+
+            float low = 1, high = -1, maxStep = 0;
+            bool finite = true;
+            float previous = gen.GetNoise(-500.0f);
+            for (int i = 1; i < 200000; i++) {
+                float noise = gen.GetNoise(-500.0f + i * 0.005f);
+                finite = finite && std::isfinite(noise);
+                low = std::min(low, noise);
+                high = std::max(high, noise);
+                maxStep = std::max(maxStep, std::abs(noise - previous));
+                previous = noise;
+            }
+
+            CHECK(finite);
+            CHECK(low >= -1.0f);
+            CHECK(high <= 1.0f);
+            CHECK(low < -kernel.reach);
+            CHECK(high > kernel.reach);
+            CHECK(maxStep < 0.05f);
+        }
+    }
+
+    SUBCASE("Cellular has no 1D form") {
+        NoiseGen gen;
+        gen.SetNoiseType(NoiseGen::NoiseType_Cellular);
+        CHECK(gen.GetNoise(12.5f) == 0.0f);
+    }
+}
+
+TEST_CASE("1D stream matches GetNoise") {
+    const NoiseGen::FractalType fractals[] = {NoiseGen::FractalType_None, NoiseGen::FractalType_FBm,
+                                              NoiseGen::FractalType_Ridged, NoiseGen::FractalType_PingPong};
+    const double steps[] = {1.0 / 48000, 0.37, 2.5, -0.01};
+
+    for (auto type : Types1D) {
+        for (auto fractal : fractals) {
+            for (double step : steps) {
+                NoiseGen gen(7);
+                gen.SetNoiseType(type);
+                gen.SetFractalType(fractal);
+                gen.SetFractalOctaves(5);
+                gen.SetFractalWeightedStrength(0.5f);
+                gen.SetFrequency(3.0f);
+
+                std::vector<float> stream(700);
+                double position = -3.2;
+                gen.GetNoiseStream1D(stream.data(), stream.size(), position, step);
+
+                for (size_t i = 0; i < stream.size(); i++) {
+                    CHECK(std::abs(stream[i] - gen.GetNoise(-3.2 + (double)i * step)) < 1e-6f);
+                }
+                CHECK(std::abs(position - (-3.2 + 700 * step)) < 1e-9);
+            }
+        }
+    }
+}
+
+TEST_CASE("1D stream continues across calls") {
+    NoiseGen gen(3);
+    gen.SetNoiseType(NoiseGen::NoiseType_Perlin);
+    gen.SetFractalType(NoiseGen::FractalType_FBm);
+
+    const double step = 1.0 / 48000;
+    std::vector<float> whole(1024), blocks(1024);
+    double position = 10000.0;
+    gen.GetNoiseStream1D(whole.data(), whole.size(), position, step);
+
+    position = 10000.0;
+    for (size_t i = 0; i < blocks.size(); i += 128) {
+        gen.GetNoiseStream1D(blocks.data() + i, 128, position, step);
+    }
+
+    for (size_t i = 0; i < whole.size(); i++) {
+        CHECK(std::abs(whole[i] - blocks[i]) < 1e-5f);
+    }
+}
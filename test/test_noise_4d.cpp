@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <cmath>
+#include <doctest/doctest.h>
+#include <entropy/entropy.hpp>
+#include <vector>
+
+using entropy::NoiseGen;
+
+static const NoiseGen::NoiseType Types4D[] = {NoiseGen::NoiseType_OpenSimplex2, NoiseGen::NoiseType_Perlin,
+                                              NoiseGen::NoiseType_Value, NoiseGen::NoiseType_Cellular};
+
+TEST_CASE("4D noise range and determinism") {
+    for (auto type : Types4D) {
+        NoiseGen gen(1337);
+        gen.SetNoiseType(type);
+        gen.SetFrequency(0.1f);
+
+        for (int i = 0; i < 2000; i++) {
+            float x = i * 1.37f - 900.0f, y = i * -0.71f, z = i * 0.29f + 5.0f, w = (i % 97) * 2.3f;
+            float noise = gen.GetNoise(x, y, z, w);
+
+            CHECK(std::isfinite(noise));
+            CHECK(noise >= -1.0f);
+            CHECK(noise <= 1.0f);
+            CHECK(noise == gen.GetNoise(x, y, z, w));
+            if (type != NoiseGen::NoiseType_Cellular) {
+                CHECK(std::abs(noise - gen.GetNoise((double)x, (double)y, (double)z, (double)w)) < 1e-3f);
+            }
+        }
+    }
+
+    SUBCASE("Seed changes the output") {
+        NoiseGen a(1), b(2);
+        int differ = 0;
+        for (int i = 0; i < 100; i++) {
+            float x = i * 3.1f, y = i * 1.7f, z = i * 0.3f, w = i * 2.9f;
+            differ += a.GetNoise(x, y, z, w) != b.GetNoise(x, y, z, w);
+        }
+        CHECK(differ > 90);
+    }
+}
+
+TEST_CASE("4D noise is continuous") {
+    for (auto type : Types4D) {
+        NoiseGen gen(99);
+        gen.SetNoiseType(type);
+        gen.SetFrequency(1.0f);
+        gen.SetCellularReturnType(NoiseGen::CellularReturnType_Distance);
+
+        float maxStep = 0;
+        for (int line = 0; line < 40; line++) {
+            float x = line * 0.37f, y = line * -0.53f, z = line * 0.11f, w = line * 0.71f;
+            float dx = 0.3f, dy = -0.5f, dz = 0.7f, dw = 0.4f;
+            float previous = gen.GetNoise(x, y, z, w);
+
+            for (int i = 1; i < 2000; i++) {
+                float t = i * 0.002f;
+                float noise = gen.GetNoise(x + dx * t, y + dy * t, z + dz * t, w + dw * t);
+                maxStep = std::max(maxStep, std::abs(noise - previous));
+                previous = noise;
+            }
+        }
+        CHECK(maxStep < 0.05f);
+    }
+}
+
+TEST_CASE("4D fractal noise") {
+    const NoiseGen::FractalType fractals[] = {NoiseGen::FractalType_FBm, NoiseGen::FractalType_Ridged,
+                                              NoiseGen::FractalType_PingPong};
+    for (auto type : Types4D) {
+        for (auto fractal : fractals) {
+            NoiseGen gen(5);
+            gen.SetNoiseType(type);
+            gen.SetFractalType(fractal);
+            gen.SetFractalOctaves(4);
+
+            for (int i = 0; i < 200; i++) {
+                float x = i * 3.3f, y = i * -1.1f, z = 17.0f, w = i * 0.9f;
+                float noise = gen.GetNoise(x, y, z, w);
+                CHECK(std::isfinite(noise));
+                CHECK(std::abs(noise) <= 1.5f);
+            }
+        }
+    }
+
+    SUBCASE("One octave FBm equals the base noise") {
+        NoiseGen fbm(8), base(8);
+        fbm.SetFractalType(NoiseGen::FractalType_FBm);
+        fbm.SetFractalOctaves(1);
+        for (int i = 0; i < 100; i++) {
+            CHECK(fbm.GetNoise(i * 2.0f, 3.0f, i * -1.0f, 7.0f) == base.GetNoise(i * 2.0f, 3.0f, i * -1.0f, 7.0f));
+        }
+    }
+}
+
+TEST_CASE("4D grids and slices") {
+    NoiseGen gen(21);
+    gen.SetNoiseType(NoiseGen::NoiseType_OpenSimplex2);
+    gen.SetFrequency(0.05f);
+
+    SUBCASE("Grid matches GetNoise") {
+        const int xSize = 9, ySize = 4, zSize = 3, wSize = 2;
+        std::vector<float> grid(xSize * ySize * zSize * wSize);
+        gen.GetNoiseGrid4D(grid.data(), -4, 2, 0, 10, xSize, ySize, zSize, wSize, 0.5f);
+
+        for (int w = 0; w < wSize; w++) {
+            for (int z = 0; z < zSize; z++) {
+                for (int y = 0; y < ySize; y++) {
+                    for (int x = 0; x < xSize; x++) {
+                        float expected = gen.GetNoise((-4 + x) * 0.5f, (2 + y) * 0.5f, z * 0.5f, (10 + w) * 0.5f);
+                        CHECK(grid[((w * zSize + z) * ySize + y) * xSize + x] == expected);
+                    }
+                }
+            }
+        }
+    }
+
+    SUBCASE("Batched rows match GetNoise for every type") {
+        const NoiseGen::NoiseType types[] = {NoiseGen::NoiseType_OpenSimplex2, NoiseGen::NoiseType_Perlin,
+                                             NoiseGen::NoiseType_Value, NoiseGen::NoiseType_Cellular};
+        for (auto type : types) {
+            for (int fractal = 0; fractal < 2; fractal++) {
+                NoiseGen typed(5);
+                typed.SetNoiseType(type);
+                typed.SetFrequency(0.13f);
+                typed.SetFractalType(fractal ? NoiseGen::FractalType_FBm : NoiseGen::FractalType_None);
+                typed.SetFractalOctaves(3);
+
+                // Long rows with large and negative steps cover column reuse and refills
+                const int xSize = 300, ySize = 2, zSize = 2;
+                const float steps[] = {0.4f, 9.0f, -1.0f};
+                std::vector<float> slice(xSize * ySize * zSize);
+                for (float step : steps) {
+                    typed.GetNoiseSlice4D(slice.data(), -150, 3, -1, xSize, ySize, zSize, 2.7f, step);
+                    for (int z = 0; z < zSize; z++) {
+                        for (int y = 0; y < ySize; y++) {
+                            for (int x = 0; x < xSize; x++) {
+                                float expected = typed.GetNoise((float)(-150 + x) * step, (float)(3 + y) * step,
+                                                                (float)(-1 + z) * step, 2.7f);
+                                CHECK(slice[(z * ySize + y) * xSize + x] == expected);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    SUBCASE("Slice at a fractional w") {
+        std::vector<float> slice(6 * 5 * 4);
+        gen.GetNoiseSlice4D(slice.data(), 0, 0, 0, 6, 5, 4, 3.25f);
+        CHECK(slice[(3 * 5 + 2) * 6 + 1] == gen.GetNoise(1.0f, 2.0f, 3.0f, 3.25f));
+    }
+
+    SUBCASE("Loop frames wrap around") {
+        std::vector<float> first(32 * 8), last(32 * 8), middle(32 * 8);
+        gen.GetNoiseLoop2D(first.data(), 0, 0, 32, 8, 0.0f, 20.0f);
+        gen.GetNoiseLoop2D(last.data(), 0, 0, 32, 8, 1.0f, 20.0f);
+        gen.GetNoiseLoop2D(middle.data(), 0, 0, 32, 8, 0.5f, 20.0f);
+
+        int changed = 0;
+        for (size_t i = 0; i < first.size(); i++) {
+            CHECK(std::abs(first[i] - last[i]) < 1e-3f);
+            changed += std::abs(first[i] - middle[i]) > 1e-3f;
+        }
+        CHECK(changed > (int)first.size() / 2);
+    }
+}
@@ -1,3 +1,4 @@
+#include <cmath>
 #include <doctest/doctest.h>
 #include <entropy/entropy.hpp>
 #include <vector>
@@ -220,3 +221,125 @@ TEST_CASE("Cellular noise configurations") {
         CHECK(std::isfinite(cell_noise));
     }
 }
+
+TEST_CASE("Approximate math stays within its documented error") {
+    const struct {
+        entropy::NoiseGen::NoiseType type;
+        float maxError2D, maxError3D;
+    } kernels[] = {{entropy::NoiseGen::NoiseType_Perlin, 0.16f, 0.2f},
+                   {entropy::NoiseGen::NoiseType_ValueCubic, 1e-6f, 1e-6f}};
+
+    for (auto &kernel : kernels) {
+        for (int seed : {0, 77, 1337}) {
+            entropy::NoiseGen exact(seed), approx(seed);
+            for (entropy::NoiseGen *gen : {&exact, &approx}) {
+                gen->SetNoiseType(kernel.type);
+                gen->SetFrequency(0.13f);
+            }
+            approx.SetApproximateMath(true);
+
+            float worst2D = 0, worst3D = 0;
+            for (int i = 0; i < 200000; i++) {
+                float x = i * 0.731f - 90000.0f, y = i * -0.377f + 15.0f, z = i * 0.219f;
+                worst2D = std::fmax(worst2D, std::abs(approx.GetNoise(x, y) - exact.GetNoise(x, y)));
+                worst3D = std::fmax(worst3D, std::abs(approx.GetNoise(x, y, z) - exact.GetNoise(x, y, z)));
+            }
+            CHECK(worst2D <= kernel.maxError2D);
+            CHECK(worst3D <= kernel.maxError3D);
+            CHECK(worst2D > 0.0f);
+            CHECK(worst3D > 0.0f);
+        }
+    }
+
+    SUBCASE("Batch paths follow the setting") {
+        for (auto &kernel : kernels) {
+            entropy::NoiseGen gen(5);
+            gen.SetNoiseType(kernel.type);
+            gen.SetFractalType(entropy::NoiseGen::FractalType_FBm);
+            gen.SetFractalOctaves(4);
+            gen.SetApproximateMath(true);
+
+            const int xSize = 19, ySize = 4, zSize = 3;
+            std::vector<float> grid(xSize * ySize * zSize), plane(xSize * ySize);
+            gen.GetNoiseGrid2D(plane.data(), -5, 2, xSize, ySize, 0.3f);
+            for (int y = 0; y < ySize; y++) {
+                for (int x = 0; x < xSize; x++) {
+                    float expected = gen.GetNoise((float)(x - 5) * 0.3f, (float)(y + 2) * 0.3f);
+                    CHECK(plane[y * xSize + x] == expected);
+                }
+            }
+
+            gen.GetNoiseGrid3D(grid.data(), -5, 2, 9, xSize, ySize, zSize);
+            for (int z = 0; z < zSize; z++) {
+                for (int y = 0; y < ySize; y++) {
+                    for (int x = 0; x < xSize; x++) {
+                        float expected = gen.GetNoise((float)(x - 5), (float)(y + 2), (float)(z + 9));
+                        CHECK(grid[(z * ySize + y) * xSize + x] == expected);
+                    }
+                }
+            }
+
+            int seeds[3] = {1, 2, 3};
+            float ensemble[3];
+            gen.GetNoiseSeeds(4.5f, -2.25f, seeds, ensemble, 3);
+            for (int i = 0; i < 3; i++) {
+                entropy::NoiseGen single = gen;
+                single.SetSeed(seeds[i]);
+                CHECK(ensemble[i] == single.GetNoise(4.5f, -2.25f));
+            }
+        }
+    }
+}
+
+TEST_CASE("Fixed seed output matches reference values") {
+    // Reference values from the original kernels. Kernel rewrites must keep these bit exact, not just close.
+    using entropy::NoiseGen;
+    const float points[8][3] = {{0.3f, 0.7f, 0.1f},       {-12.25f, 3.5f, 7.75f},   {101.1f, -47.9f, 3.3f},
+                                {5.5f, 5.5f, 5.5f},       {-0.9f, -230.4f, 61.2f},  {1234.5f, 678.9f, -321.0f},
+                                {17.0f, 0.01f, -8.6f},    {-64.2f, 88.8f, 0.0f}};
+
+    auto check = [&](NoiseGen::NoiseType type, NoiseGen::CellularReturnType returnType, const float *expected2D,
+                     const float *expected3D) {
+        NoiseGen gen(1337);
+        gen.SetNoiseType(type);
+        gen.SetCellularReturnType(returnType);
+        gen.SetFrequency(0.37f);
+
+        for (int i = 0; i < 8; i++) {
+            CHECK(gen.GetNoise(points[i][0], points[i][1]) == expected2D[i]);
+            CHECK(gen.GetNoise(points[i][0], points[i][1], points[i][2]) == expected3D[i]);
+        }
+    };
+
+    SUBCASE("OpenSimplex2") {
+        const float expected2D[8] = {0.896335244f,  0.63654238f,   0.00742716854f, -0.482086003f,
+                                     -0.133402079f, -0.699259222f, 0.270425946f,   0.201756358f};
+        const float expected3D[8] = {0.566000819f,  0.651380599f,  -0.144195378f, 0.289406717f,
+                                     -0.796291173f, -0.272446901f, -0.491696894f, 0.863085628f};
+        check(NoiseGen::NoiseType_OpenSimplex2, NoiseGen::CellularReturnType_Distance, expected2D, expected3D);
+    }
+
+    SUBCASE("OpenSimplex2S") {
+        const float expected2D[8] = {0.655679584f,  0.464362204f,  0.0863849372f, -0.453419268f,
+                                     -0.247002929f, -0.571377039f, 0.406419277f,  0.185541689f};
+        const float expected3D[8] = {0.449414223f,  0.440415591f,    0.358169734f,  0.197338834f,
+                                     -0.633826733f, 0.000493615633f, -0.275988013f, 0.560660362f};
+        check(NoiseGen::NoiseType_OpenSimplex2S, NoiseGen::CellularReturnType_Distance, expected2D, expected3D);
+    }
+
+    SUBCASE("Cellular distance") {
+        const float expected2D[8] = {-0.803904295f, -0.715395749f, -0.844724774f, -0.818023741f,
+                                     -0.951544344f, -0.836693406f, -0.834331274f, -0.879907429f};
+        const float expected3D[8] = {-0.597769141f, -0.630750179f, -0.685369551f, -0.851727009f,
+                                     -0.718974113f, -0.96999073f,  -0.561396718f, -0.949292302f};
+        check(NoiseGen::NoiseType_Cellular, NoiseGen::CellularReturnType_Distance, expected2D, expected3D);
+    }
+
+    SUBCASE("Cellular cell value") {
+        const float expected2D[8] = {-0.707546294f, -0.936515808f, -0.434319645f, 0.330539167f,
+                                     0.0841982514f, 0.494184762f,  -0.93446368f,  -0.230729669f};
+        const float expected3D[8] = {0.0546948947f, 0.642837524f,  0.33036679f,   -0.623968542f,
+                                     -0.986793578f, -0.648415923f, -0.249028996f, -0.230729669f};
+        check(NoiseGen::NoiseType_Cellular, NoiseGen::CellularReturnType_CellValue, expected2D, expected3D);
+    }
+}
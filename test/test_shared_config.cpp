@@ -0,0 +1,117 @@
+#include <atomic>
+#include <cmath>
+#include <doctest/doctest.h>
+#include <entropy/entropy.hpp>
+#include <thread>
+#include <vector>
+
+using entropy::NoiseGen;
+using entropy::SharedNoiseGen;
+
+TEST_CASE("Shared settings snapshots") {
+    NoiseGen initial(42);
+    initial.SetFrequency(0.05f);
+    SharedNoiseGen shared(initial);
+
+    CHECK(shared.Get().GetNoise(3.0f, 4.0f) == initial.GetNoise(3.0f, 4.0f));
+
+    SUBCASE("Update edits a copy") {
+        const NoiseGen &before = shared.Get();
+        float value = before.GetNoise(3.0f, 4.0f);
+
+        shared.Update([](NoiseGen &gen) {
+            gen.SetFractalType(NoiseGen::FractalType_FBm);
+            gen.SetFractalOctaves(5);
+        });
+
+        NoiseGen expected = initial;
+        expected.SetFractalType(NoiseGen::FractalType_FBm);
+        expected.SetFractalOctaves(5);
+
+        CHECK(shared.Get().GetNoise(3.0f, 4.0f) == expected.GetNoise(3.0f, 4.0f));
+        CHECK(before.GetNoise(3.0f, 4.0f) == value);
+        CHECK(shared.RetiredCount() == 1);
+
+        shared.Reclaim();
+        CHECK(shared.RetiredCount() == 0);
+        CHECK(shared.Get().GetNoise(3.0f, 4.0f) == expected.GetNoise(3.0f, 4.0f));
+    }
+
+    SUBCASE("Publish replaces the settings") {
+        NoiseGen other(7);
+        other.SetNoiseType(NoiseGen::NoiseType_Cellular);
+        shared.Publish(other);
+        CHECK(shared.Get().GetNoise(1.5f, 2.5f, 3.5f) == other.GetNoise(1.5f, 2.5f, 3.5f));
+    }
+}
+
+TEST_CASE("Readers always see a consistent snapshot") {
+    // Each published configuration k sets several dependent settings at once, readers check that the output of the
+    // snapshot they took matches one of the configurations exactly
+    const int configCount = 6;
+    std::vector<NoiseGen> configs;
+    for (int k = 0; k < configCount; k++) {
+        NoiseGen gen(100 + k);
+        gen.SetNoiseType(k % 2 ? NoiseGen::NoiseType_Perlin : NoiseGen::NoiseType_OpenSimplex2);
+        gen.SetFractalType(NoiseGen::FractalType_FBm);
+        gen.SetFractalOctaves(2 + k);
+        gen.SetFractalGain(0.3f + 0.1f * k);
+        configs.push_back(gen);
+    }
+
+    std::vector<float> expected;
+    for (const NoiseGen &gen : configs) {
+        expected.push_back(gen.GetNoise(12.3f, 45.6f, 7.8f));
+    }
+
+    SharedNoiseGen shared(configs[0]);
+    std::atomic<bool> done(false);
+    std::atomic<int> mismatches(0);
+    std::atomic<long> reads(0);
+    std::atomic<int> started(0);
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; t++) {
+        readers.emplace_back([&] {
+            started++;
+            while (!done.load()) {
+                float value = shared.Get().GetNoise(12.3f, 45.6f, 7.8f);
+                bool known = false;
+                for (float e : expected) {
+                    known |= e == value;
+                }
+                mismatches += !known;
+                reads++;
+            }
+        });
+    }
+
+    // Updates only start once every reader runs, so reads overlap them however the threads are scheduled
+    while (started.load() < 4) {
+        std::this_thread::yield();
+    }
+
+    for (int i = 0; i < 2000; i++) {
+        int k = i % configCount;
+        shared.Update([&](NoiseGen &gen) {
+            gen.SetSeed(100 + k);
+            gen.SetNoiseType(k % 2 ? NoiseGen::NoiseType_Perlin : NoiseGen::NoiseType_OpenSimplex2);
+            gen.SetFractalOctaves(2 + k);
+            gen.SetFractalGain(0.3f + 0.1f * k);
+        });
+    }
+
+    while (reads.load() == 0) {
+        std::this_thread::yield();
+    }
+    done = true;
+    for (std::thread &reader : readers) {
+        reader.join();
+    }
+
+    CHECK(mismatches.load() == 0);
+    CHECK(reads.load() > 0);
+    CHECK(shared.RetiredCount() == 2000);
+    shared.Reclaim();
+    CHECK(shared.Get().GetNoise(12.3f, 45.6f, 7.8f) == expected[(2000 - 1) % configCount]);
+}